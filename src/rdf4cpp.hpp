@@ -2,7 +2,11 @@
 #define RDF4CPP_RDF4CPP_HPP
 
 #include <rdf4cpp/ClosedNamespace.hpp>
+#include <rdf4cpp/ConcurrentDataset.hpp>
+#include <rdf4cpp/ConcurrentGraph.hpp>
 #include <rdf4cpp/Dataset.hpp>
+#include <rdf4cpp/FrozenGraph.hpp>
+#include <rdf4cpp/GraphSnapshot.hpp>
 #include <rdf4cpp/IRIFactory.hpp>
 #include <rdf4cpp/InvalidNode.hpp>
 #include <rdf4cpp/Namespace.hpp>
@@ -0,0 +1,114 @@
+#include "ConcurrentDataset.hpp"
+
+#include <cassert>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace rdf4cpp {
+
+using storage::identifier::NodeBackendID;
+
+ConcurrentDataset::ConcurrentDataset(storage::DynNodeStoragePtr node_storage, size_t const shard_count) : node_storage_{node_storage},
+                                                                                                         shard_count_{shard_count} {
+    assert(shard_count_ > 0);
+}
+
+ConcurrentGraph *ConcurrentDataset::find_graph(NodeBackendID const graph_name) const {
+    std::shared_lock lock{mutex_};
+
+    auto const it = graphs_.find(graph_name);
+    if (it == graphs_.end()) {
+        return nullptr;
+    }
+
+    return it->second.get();
+}
+
+ConcurrentGraph &ConcurrentDataset::graph(Node const &graph_name_) {
+    auto const graph_name = graph_name_.null() ? IRI::default_graph(node_storage_) : graph_name_.to_node_storage(node_storage_);
+    auto const id = graph_name.backend_handle().id();
+
+    if (auto *graph = find_graph(id); graph != nullptr) {
+        return *graph;
+    }
+
+    std::unique_lock lock{mutex_};
+
+    // another thread might have created it in the meantime
+    auto it = graphs_.find(id);
+    if (it == graphs_.end()) {
+        it = graphs_.emplace(id, std::make_unique<ConcurrentGraph>(node_storage_, shard_count_)).first;
+    }
+
+    return *it->second;
+}
+
+ConcurrentGraph &ConcurrentDataset::graph() {
+    return graph(IRI::default_graph(node_storage_));
+}
+
+bool ConcurrentDataset::add(Quad const &quad) {
+    return graph(quad.graph()).add(quad.without_graph());
+}
+
+bool ConcurrentDataset::remove(Quad const &quad) {
+    auto const graph_name = quad.graph().null() ? IRI::default_graph(node_storage_) : quad.graph().try_get_in_node_storage(node_storage_);
+    if (graph_name.null()) {
+        return false;
+    }
+
+    auto *graph = find_graph(graph_name.backend_handle().id());
+    return graph != nullptr && graph->remove(quad.without_graph());
+}
+
+bool ConcurrentDataset::contains(Quad const &quad) const {
+    auto const graph_name = quad.graph().null() ? IRI::default_graph(node_storage_) : quad.graph().try_get_in_node_storage(node_storage_);
+    if (graph_name.null()) {
+        return false;
+    }
+
+    auto const *graph = find_graph(graph_name.backend_handle().id());
+    return graph != nullptr && graph->contains(quad.without_graph());
+}
+
+std::vector<std::pair<Node, GraphSnapshot>> ConcurrentDataset::graph_snapshots() const {
+    std::shared_lock lock{mutex_};
+
+    // all graphs are locked before the first snapshot is taken, so that the snapshots do not mix states of different points in time
+    std::vector<std::vector<std::shared_lock<std::shared_mutex>>> locks;
+    locks.reserve(graphs_.size());
+    for (auto const &[graph_name, graph] : graphs_) {
+        locks.push_back(graph->lock_all_shared());
+    }
+
+    std::vector<std::pair<Node, GraphSnapshot>> ret;
+    ret.reserve(graphs_.size());
+    for (auto const &[graph_name, graph] : graphs_) {
+        ret.emplace_back(Node{storage::identifier::NodeBackendHandle{graph_name, node_storage_}}, graph->snapshot_locked());
+    }
+
+    return ret;
+}
+
+size_t ConcurrentDataset::size() const {
+    size_t ret = 0;
+    for (auto const &[graph_name, graph] : graph_snapshots()) {
+        ret += graph.size();
+    }
+
+    return ret;
+}
+
+Dataset ConcurrentDataset::snapshot() const {
+    Dataset ret{node_storage_};
+
+    // copied after all locks are released
+    for (auto const &[graph_name, graph] : graph_snapshots()) {
+        ret.graph(graph_name) = graph.to_graph();
+    }
+
+    return ret;
+}
+
+}  // namespace rdf4cpp
@@ -0,0 +1,85 @@
+#ifndef RDF4CPP_CONCURRENTDATASET_HPP
+#define RDF4CPP_CONCURRENTDATASET_HPP
+
+#include <rdf4cpp/ConcurrentGraph.hpp>
+#include <rdf4cpp/Dataset.hpp>
+#include <rdf4cpp/Quad.hpp>
+
+#include <dice/sparse-map/sparse_map.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace rdf4cpp {
+
+/**
+ * Set of quads that can be read and written by multiple threads at the same time, the concurrent counterpart of Dataset.
+ *
+ * Every graph is a ConcurrentGraph. The map from graph names to graphs is guarded by a shared_mutex, which is only locked uniquely
+ * to create a graph. Graphs are never destroyed before the dataset, therefore references to them stay valid.
+ * graph_snapshots locks the graph map and all shards of all graphs shared while it takes a GraphSnapshot of every graph,
+ * so the snapshots observe a single consistent state of the whole dataset.
+ */
+struct ConcurrentDataset {
+private:
+    using storage_type = dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, std::unique_ptr<ConcurrentGraph>>;
+
+    storage::DynNodeStoragePtr node_storage_;
+    size_t shard_count_;
+
+    mutable std::shared_mutex mutex_;
+    storage_type graphs_;
+
+    /**
+     * @return the graph with the given id, nullptr if there is none
+     */
+    [[nodiscard]] ConcurrentGraph *find_graph(storage::identifier::NodeBackendID graph_name) const;
+
+public:
+    /**
+     * @param node_storage node storage of the dataset
+     * @param shard_count number of shards of each graph (see ConcurrentGraph), must be at least 1
+     */
+    explicit ConcurrentDataset(storage::DynNodeStoragePtr node_storage = storage::default_node_storage,
+                               size_t shard_count = ConcurrentGraph::default_shard_count());
+
+    /**
+     * @return true if quad was not in the dataset before
+     */
+    bool add(Quad const &quad);
+
+    /**
+     * @return true if quad was in the dataset
+     */
+    bool remove(Quad const &quad);
+
+    [[nodiscard]] bool contains(Quad const &quad) const;
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @param graph_name the name of the graph, the default graph if null
+     * @return the graph with that name, it is created if it does not exist yet
+     */
+    ConcurrentGraph &graph(Node const &graph_name);
+    ConcurrentGraph &graph();
+
+    /**
+     * Takes snapshots (see ConcurrentGraph::snapshot) of all graphs at the same point in time.
+     * Takes time linear in the number of graphs and chunks, not in the number of quads.
+     *
+     * @return the name and snapshot of every graph
+     */
+    [[nodiscard]] std::vector<std::pair<Node, GraphSnapshot>> graph_snapshots() const;
+
+    /**
+     * @return a copy of the current state of this dataset, which is not affected by later changes
+     */
+    [[nodiscard]] Dataset snapshot() const;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_CONCURRENTDATASET_HPP
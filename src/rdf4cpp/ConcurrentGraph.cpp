@@ -0,0 +1,165 @@
+#include "ConcurrentGraph.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <thread>
+#include <utility>
+
+namespace rdf4cpp {
+
+size_t ConcurrentGraph::default_shard_count() noexcept {
+    return std::bit_ceil(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+ConcurrentGraph::ConcurrentGraph(storage::DynNodeStoragePtr node_storage, size_t const shard_count) : node_storage_{node_storage},
+                                                                                                      shards_{std::make_unique<Shard[]>(shard_count)},
+                                                                                                      shard_count_{shard_count} {
+    assert(shard_count_ > 0);
+
+    for (size_t ix = 0; ix < shard_count_; ++ix) {
+        for (auto &chunk : shards_[ix].chunks) {
+            chunk = std::make_shared<chunk_type>();
+        }
+    }
+}
+
+ConcurrentGraph::ConcurrentGraph(Graph const &graph, size_t const shard_count) : ConcurrentGraph{graph.node_storage_, shard_count} {
+    for (auto const &t : graph.triples_) {
+        auto const chunk_ix = chunk_index_of(t);
+        chunk_in_shard(shard_of_chunk(chunk_ix), chunk_ix)->insert(t);
+    }
+}
+
+storage::DynNodeStoragePtr ConcurrentGraph::node_storage() const noexcept {
+    return node_storage_;
+}
+
+size_t ConcurrentGraph::shard_count() const noexcept {
+    return shard_count_;
+}
+
+size_t ConcurrentGraph::chunk_count() const noexcept {
+    return shard_count_ * chunks_per_shard;
+}
+
+size_t ConcurrentGraph::chunk_index_of(triple const &t) const noexcept {
+    return GraphSnapshot::chunk_index(t, chunk_count());
+}
+
+ConcurrentGraph::Shard &ConcurrentGraph::shard_of_chunk(size_t const chunk_ix) const noexcept {
+    return shards_[chunk_ix / chunks_per_shard];
+}
+
+std::shared_ptr<ConcurrentGraph::chunk_type> &ConcurrentGraph::chunk_in_shard(Shard &shard, size_t const chunk_ix) noexcept {
+    return shard.chunks[chunk_ix % chunks_per_shard];
+}
+
+ConcurrentGraph::chunk_type &ConcurrentGraph::writable_triples(std::shared_ptr<chunk_type> &chunk) {
+    // no new references can be created while the shard is locked uniquely, so a count of 1 stays 1
+    if (chunk.use_count() > 1) {
+        chunk = std::make_shared<chunk_type>(*chunk);
+    } else {
+        // pairs with the release of the last snapshot that referred to the triples, its reads happen before the following writes
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+
+    return *chunk;
+}
+
+std::vector<std::shared_lock<std::shared_mutex>> ConcurrentGraph::lock_all_shared() const {
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(shard_count_);
+
+    // always in shard order, writers never hold more than one shard lock
+    for (size_t ix = 0; ix < shard_count_; ++ix) {
+        locks.emplace_back(shards_[ix].mutex);
+    }
+
+    return locks;
+}
+
+GraphSnapshot ConcurrentGraph::snapshot_locked() const {
+    std::vector<std::shared_ptr<chunk_type const>> chunks;
+    chunks.reserve(chunk_count());
+
+    // in shard order, which is the order of the chunk indices
+    for (size_t ix = 0; ix < shard_count_; ++ix) {
+        chunks.insert(chunks.end(), shards_[ix].chunks.begin(), shards_[ix].chunks.end());
+    }
+
+    return GraphSnapshot{node_storage_, std::move(chunks)};
+}
+
+ConcurrentGraph::triple ConcurrentGraph::to_triple(Statement const &stmt) const noexcept {
+    return triple{stmt.subject().backend_handle().id(), stmt.predicate().backend_handle().id(), stmt.object().backend_handle().id()};
+}
+
+bool ConcurrentGraph::add(Statement const &stmt_) {
+    // translated before locking, the node storage synchronizes itself
+    auto const t = to_triple(stmt_.to_node_storage(node_storage_));
+
+    auto const chunk_ix = chunk_index_of(t);
+    auto &shard = shard_of_chunk(chunk_ix);
+    std::unique_lock lock{shard.mutex};
+
+    auto &chunk = chunk_in_shard(shard, chunk_ix);
+    if (chunk->contains(t)) {
+        return false;
+    }
+
+    return writable_triples(chunk).insert(t).second;
+}
+
+bool ConcurrentGraph::remove(Statement const &stmt_) {
+    auto const t = to_triple(stmt_.try_get_in_node_storage(node_storage_));
+    if (t[0].null() || t[1].null() || t[2].null()) {
+        return false;
+    }
+
+    auto const chunk_ix = chunk_index_of(t);
+    auto &shard = shard_of_chunk(chunk_ix);
+    std::unique_lock lock{shard.mutex};
+
+    auto &chunk = chunk_in_shard(shard, chunk_ix);
+    if (!chunk->contains(t)) {
+        return false;
+    }
+
+    return writable_triples(chunk).erase(t) != 0;
+}
+
+bool ConcurrentGraph::contains(Statement const &stmt_) const {
+    auto const t = to_triple(stmt_.try_get_in_node_storage(node_storage_));
+    if (t[0].null() || t[1].null() || t[2].null()) {
+        return false;
+    }
+
+    auto const chunk_ix = chunk_index_of(t);
+    auto &shard = shard_of_chunk(chunk_ix);
+    std::shared_lock lock{shard.mutex};
+    return chunk_in_shard(shard, chunk_ix)->contains(t);
+}
+
+size_t ConcurrentGraph::size() const {
+    return snapshot().size();
+}
+
+std::vector<query::Solution> ConcurrentGraph::match(query::TriplePattern const &triple_pattern) const {
+    auto const current = snapshot();
+
+    std::vector<query::Solution> ret;
+    for (auto const &solution : current.match(triple_pattern)) {
+        ret.push_back(solution);
+    }
+
+    return ret;
+}
+
+GraphSnapshot ConcurrentGraph::snapshot() const {
+    auto const locks = lock_all_shared();
+    return snapshot_locked();
+}
+
+}  // namespace rdf4cpp
@@ -0,0 +1,137 @@
+#ifndef RDF4CPP_CONCURRENTGRAPH_HPP
+#define RDF4CPP_CONCURRENTGRAPH_HPP
+
+#include <rdf4cpp/Graph.hpp>
+#include <rdf4cpp/GraphSnapshot.hpp>
+#include <rdf4cpp/Statement.hpp>
+#include <rdf4cpp/query/Solution.hpp>
+#include <rdf4cpp/query/TriplePattern.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace rdf4cpp {
+
+/**
+ * Set of triples that can be read and written by multiple threads at the same time.
+ *
+ * The triples are split into a fixed number of shards by their hash, each shard is guarded by its own shared_mutex.
+ * add, remove and contains only lock the shard of their triple, so writers of different triples rarely contend.
+ * Each shard is further split into chunks_per_shard small hash sets (chunks), again by the hash of the triples.
+ * Operations that need a consistent view of the whole graph (size, match and snapshot) take a snapshot, which locks all shards shared
+ * (in shard order) just long enough to share all chunks with it, see GraphSnapshot.
+ * A chunk that is shared with a snapshot is copied by the next writer that changes it, so readers never block writers for longer than that
+ * and a writer only copies about 1 / chunk_count() of the graph.
+ *
+ * The node storage must be thread-safe, if statements from other node storages are added (e.g. the default SyncReferenceNodeStorage).
+ */
+struct ConcurrentGraph {
+private:
+    using triple = GraphSnapshot::triple;
+    using chunk_type = GraphSnapshot::chunk_type;
+
+public:
+    /**
+     * Number of chunks each shard is split into, independent of the number of shards
+     */
+    static constexpr size_t chunks_per_shard = 32;
+
+private:
+    // each shard gets its own cache lines, to avoid false sharing between the mutexes of neighbouring shards
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::array<std::shared_ptr<chunk_type>, chunks_per_shard> chunks; //< each one shared with the snapshots that were taken since it was last changed
+    };
+
+    storage::DynNodeStoragePtr node_storage_;
+    std::unique_ptr<Shard[]> shards_;
+    size_t shard_count_;
+
+    /**
+     * The chunks of shard s are the ones with the indices s * chunks_per_shard up to (s + 1) * chunks_per_shard - 1.
+     * @return the index of the chunk responsible for t, in [0, chunk_count())
+     */
+    [[nodiscard]] size_t chunk_index_of(triple const &t) const noexcept;
+    [[nodiscard]] Shard &shard_of_chunk(size_t chunk_ix) const noexcept;
+    [[nodiscard]] static std::shared_ptr<chunk_type> &chunk_in_shard(Shard &shard, size_t chunk_ix) noexcept;
+
+    /**
+     * @return the triples of chunk, copied first if a snapshot still refers to them
+     * @pre the shard of chunk is locked uniquely
+     */
+    [[nodiscard]] static chunk_type &writable_triples(std::shared_ptr<chunk_type> &chunk);
+
+    /**
+     * @return shared locks on all shards, acquired in shard order
+     */
+    [[nodiscard]] std::vector<std::shared_lock<std::shared_mutex>> lock_all_shared() const;
+
+    /**
+     * @return the current version of this graph
+     * @pre all shards are locked (at least shared)
+     */
+    [[nodiscard]] GraphSnapshot snapshot_locked() const;
+
+    [[nodiscard]] triple to_triple(Statement const &stmt) const noexcept;
+
+    friend struct ConcurrentDataset;
+
+public:
+    /**
+     * @return the number of shards used by default, i.e. the number of hardware threads rounded up to the next power of two
+     */
+    [[nodiscard]] static size_t default_shard_count() noexcept;
+
+    /**
+     * @param node_storage node storage of the graph
+     * @param shard_count number of shards, must be at least 1
+     */
+    explicit ConcurrentGraph(storage::DynNodeStoragePtr node_storage = storage::default_node_storage,
+                             size_t shard_count = default_shard_count());
+
+    /**
+     * Copies graph into a new ConcurrentGraph
+     */
+    explicit ConcurrentGraph(Graph const &graph, size_t shard_count = default_shard_count());
+
+    [[nodiscard]] storage::DynNodeStoragePtr node_storage() const noexcept;
+    [[nodiscard]] size_t shard_count() const noexcept;
+
+    /**
+     * @return the number of chunks, i.e. shard_count() * chunks_per_shard
+     */
+    [[nodiscard]] size_t chunk_count() const noexcept;
+
+    /**
+     * @return true if statement was not in the graph before
+     */
+    bool add(Statement const &statement);
+
+    /**
+     * @return true if statement was in the graph
+     */
+    bool remove(Statement const &statement);
+
+    [[nodiscard]] bool contains(Statement const &statement) const;
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * Collects all solutions of triple_pattern in a consistent state of this graph.
+     * Like Graph::match, repeated variables are not required to be bound to the same node.
+     */
+    [[nodiscard]] std::vector<query::Solution> match(query::TriplePattern const &triple_pattern) const;
+
+    /**
+     * Takes a snapshot of the current state of this graph, which is not affected by later changes.
+     * Takes time linear in the number of chunks, not in the number of triples.
+     */
+    [[nodiscard]] GraphSnapshot snapshot() const;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_CONCURRENTGRAPH_HPP
@@ -3,10 +3,56 @@
 #include <rdf4cpp/writer/TryWrite.hpp>
 #include <rdf4cpp/writer/SerializationState.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <thread>
 #include <utility>
 
 namespace rdf4cpp {
 
+/**
+ * Runs run_task(worker, task) for every task in [0, task_count) on thread_count threads (including the calling one),
+ * where worker is the index of the thread. The threads take the tasks one after another.
+ * If a task throws, the remaining tasks are skipped and the exception is rethrown once all threads finished.
+ */
+template<typename F>
+static void run_parallel(size_t const task_count, size_t const thread_count, F const &run_task) {
+    std::vector<std::exception_ptr> errors(thread_count);
+    std::atomic<size_t> next_task{0};
+
+    auto const work = [&](size_t const worker) noexcept {
+        try {
+            for (auto ix = next_task.fetch_add(1, std::memory_order_relaxed); ix < task_count; ix = next_task.fetch_add(1, std::memory_order_relaxed)) {
+                run_task(worker, ix);
+            }
+        } catch (...) {
+            errors[worker] = std::current_exception();
+            next_task.store(task_count, std::memory_order_relaxed); // let the other threads stop early
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (size_t worker = 1; worker < thread_count; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+
+        work(0);
+    }
+
+    for (auto const &error : errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
 storage::identifier::NodeBackendID Dataset::to_node_id(Node node) noexcept {
     return node.backend_handle().id();
 }
@@ -17,6 +63,41 @@ Node Dataset::to_node(storage::identifier::NodeBackendID id) const noexcept {
 
 Dataset::Dataset(storage::DynNodeStoragePtr node_storage) : node_storage_{node_storage} {}
 
+Dataset Dataset::to_node_storage(storage::DynNodeStoragePtr node_storage) const {
+    if (node_storage == node_storage_) {
+        return *this;
+    }
+
+    NodeIDRemapping remapping{node_storage_, node_storage};
+    for (auto const &[graph_name, graph] : graphs_) {
+        remapping.add(graph_name);
+        graph.add_ids_to(remapping);
+    }
+    remapping.resolve();
+
+    Dataset ret{node_storage};
+    ret.graphs_.reserve(graphs_.size());
+
+    for (auto const &[graph_name, graph] : graphs_) {
+        ret.graphs_.emplace(remapping[graph_name], graph.remap(remapping, node_storage));
+    }
+
+    return ret;
+}
+
+void Dataset::remap_node_ids(NodeIDRemapping const &remapping) {
+    assert(remapping.from() == node_storage_ && remapping.to() == node_storage_);
+
+    storage_type remapped;
+    remapped.reserve(graphs_.size());
+
+    for (auto const &[graph_name, graph] : graphs_) {
+        remapped.emplace(remapping[graph_name], graph.remap(remapping, node_storage_));
+    }
+
+    graphs_ = std::move(remapped);
+}
+
 void Dataset::add(Quad const &quad) {
     auto const g = quad.graph().null() ? IRI::default_graph(node_storage_) : quad.graph().to_node_storage(node_storage_);
 
@@ -28,6 +109,149 @@ void Dataset::add(Quad const &quad) {
     it.value().add(quad.without_graph());
 }
 
+void Dataset::bulk_add(std::span<Quad const> const quads, size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    auto const default_graph = to_node_id(IRI::default_graph(node_storage_));
+
+    // group the triples by graph, consecutive quads usually belong to the same graph
+    dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, std::vector<Graph::triple>> groups;
+    std::vector<Graph::triple> *group = nullptr;
+    storage::identifier::NodeBackendID group_name{};
+
+    for (auto const &quad_ : quads) {
+        auto const quad = quad_.to_node_storage(node_storage_);
+        auto const graph_name = quad.graph().null() ? default_graph : to_node_id(quad.graph());
+
+        if (group == nullptr || graph_name != group_name) {
+            group = &groups[graph_name];
+            group_name = graph_name;
+        }
+
+        group->push_back(Graph::triple{to_node_id(quad.subject()), to_node_id(quad.predicate()), to_node_id(quad.object())});
+    }
+
+    // create all graphs first, graphs_ must not change while the graphs are filled
+    for (auto const &[graph_name, triples] : groups) {
+        if (!graphs_.contains(graph_name)) {
+            graphs_.emplace(graph_name, node_storage_);
+        }
+    }
+
+    std::vector<std::pair<Graph *, std::vector<Graph::triple> const *>> tasks;
+    tasks.reserve(groups.size());
+    for (auto const &[graph_name, triples] : groups) {
+        tasks.emplace_back(&graphs_.find(graph_name).value(), &triples);
+    }
+
+    // the largest graphs first, so that they do not end up as the last task of a thread
+    std::ranges::sort(tasks, [](auto const &lhs, auto const &rhs) noexcept {
+        return lhs.second->size() > rhs.second->size();
+    });
+
+    thread_count = std::min(thread_count, std::max(tasks.size(), size_t{1}));
+    run_parallel(tasks.size(), thread_count, [&tasks](size_t, size_t const task) {
+        auto const &[graph, triples] = tasks[task];
+        graph->add_triples(*triples);
+    });
+}
+
+bool Dataset::remove(Quad const &quad) {
+    auto const g = quad.graph().null() ? IRI::default_graph(node_storage_) : quad.graph().try_get_in_node_storage(node_storage_);
+
+    auto it = graphs_.find(to_node_id(g));
+    if (it == graphs_.end()) {
+        return false;
+    }
+
+    return it.value().remove(quad.without_graph());
+}
+
+size_t Dataset::erase(query::QuadPattern const &quad_pattern) {
+    if (!quad_pattern.graph().is_variable()) {
+        auto *graph = find_graph(quad_pattern.graph());
+        return graph == nullptr ? 0 : graph->erase(quad_pattern.without_graph());
+    }
+
+    size_t ret = 0;
+    for (auto it = graphs_.begin(); it != graphs_.end(); ++it) {
+        ret += it.value().erase(quad_pattern.without_graph());
+    }
+
+    return ret;
+}
+
+Dataset const &Dataset::in_node_storage(Dataset const &other, std::optional<Dataset> &tmp) const {
+    if (other.node_storage_ == node_storage_) {
+        return other;
+    }
+
+    return tmp.emplace(other.to_node_storage(node_storage_));
+}
+
+Dataset &Dataset::operator+=(Dataset const &other_) {
+    if (&other_ == this) {
+        return *this;
+    }
+
+    std::optional<Dataset> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    for (auto const &[graph_name, graph] : other.graphs_) {
+        auto it = graphs_.find(graph_name);
+        if (it == graphs_.end()) {
+            graphs_.emplace(graph_name, graph);
+        } else {
+            it.value() += graph;
+        }
+    }
+
+    return *this;
+}
+
+Dataset &Dataset::operator-=(Dataset const &other_) {
+    std::optional<Dataset> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    for (auto const &[graph_name, graph] : other.graphs_) {
+        if (auto it = graphs_.find(graph_name); it != graphs_.end()) {
+            it.value() -= graph;
+        }
+    }
+
+    return *this;
+}
+
+Dataset &Dataset::operator&=(Dataset const &other_) {
+    std::optional<Dataset> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    Graph const empty{node_storage_};
+    for (auto it = graphs_.begin(); it != graphs_.end(); ++it) {
+        auto const other_it = other.graphs_.find(it->first);
+        it.value() &= other_it == other.graphs_.end() ? empty : other_it->second;
+    }
+
+    return *this;
+}
+
+Dataset operator+(Dataset lhs, Dataset const &rhs) {
+    lhs += rhs;
+    return lhs;
+}
+
+Dataset operator-(Dataset lhs, Dataset const &rhs) {
+    lhs -= rhs;
+    return lhs;
+}
+
+Dataset operator&(Dataset lhs, Dataset const &rhs) {
+    lhs &= rhs;
+    return lhs;
+}
+
 bool Dataset::contains(Quad const &quad) const noexcept {
     auto const g = quad.graph().try_get_in_node_storage(node_storage_);
 
@@ -43,6 +267,192 @@ Dataset::solution_sequence Dataset::match(query::QuadPattern const &pat) const n
     return solution_sequence{solution_iterator{this, pat, graphs_.begin(), graphs_.end()}};
 }
 
+std::vector<query::Solution> Dataset::parallel_match(query::QuadPattern const &quad_pattern, size_t thread_count) const {
+    if (thread_count == 0) {
+        thread_count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    std::array<storage::identifier::NodeBackendID, 4> bound{};
+    std::vector<size_t> variable_positions;
+    for (size_t ix = 0; ix < bound.size(); ++ix) {
+        if (quad_pattern[ix].is_variable()) {
+            variable_positions.push_back(ix);
+            continue;
+        }
+
+        auto const node = quad_pattern[ix].try_get_in_node_storage(node_storage_);
+        if (node.null()) {
+            // not present in the node storage, so there cannot be a solution
+            return {};
+        }
+
+        bound[ix] = to_node_id(node);
+    }
+
+    Graph::triple const bound_triple{bound[1], bound[2], bound[3]};
+
+    /**
+     * A partition of the triples of a graph, or the whole graph if use_index is true
+     */
+    struct Task {
+        storage::identifier::NodeBackendID graph_name;
+        Graph const *graph;
+        bool use_index;
+        typename Graph::triple_storage_type::const_iterator begin;
+        typename Graph::triple_storage_type::const_iterator end;
+    };
+
+    std::vector<Task> tasks;
+    for (auto const &[graph_name, graph] : graphs_) {
+        if (!bound[0].null() && graph_name != bound[0]) {
+            continue;
+        }
+
+        if (graph.has_indexes() && graph.select_index(bound_triple).first != nullptr) {
+            tasks.push_back(Task{graph_name, &graph, true, {}, {}});
+            continue;
+        }
+
+        auto it = graph.triples_.begin();
+        auto const end = graph.triples_.end();
+        while (it != end) {
+            auto partition_end = it;
+            for (size_t n = 0; n < parallel_match_partition_size && partition_end != end; ++n) {
+                ++partition_end;
+            }
+
+            tasks.push_back(Task{graph_name, &graph, false, it, partition_end});
+            it = partition_end;
+        }
+    }
+
+    query::Solution const prototype{quad_pattern};
+
+    auto const run_task = [&](Task const &task, std::vector<query::Solution> &out, std::vector<Graph::triple> &matches) {
+        auto const emit = [&](Graph::triple const &t) {
+            std::array<storage::identifier::NodeBackendID, 4> const quad{task.graph_name, t[0], t[1], t[2]};
+
+            auto &solution = out.emplace_back(prototype);
+            for (size_t vx = 0; vx < variable_positions.size(); ++vx) {
+                solution[vx] = to_node(quad[variable_positions[vx]]);
+            }
+        };
+
+        if (task.use_index) {
+            matches.clear();
+            task.graph->collect_matches(bound_triple, matches);
+            for (auto const &t : matches) {
+                emit(t);
+            }
+            return;
+        }
+
+        for (auto it = task.begin; it != task.end; ++it) {
+            auto const &t = *it;
+            if ((bound[1].null() || t[0] == bound[1]) && (bound[2].null() || t[1] == bound[2]) && (bound[3].null() || t[2] == bound[3])) {
+                emit(t);
+            }
+        }
+    };
+
+    thread_count = std::min(thread_count, std::max(tasks.size(), size_t{1}));
+
+    std::vector<std::vector<query::Solution>> results(thread_count);
+    std::vector<std::vector<Graph::triple>> matches(thread_count);
+
+    run_parallel(tasks.size(), thread_count, [&](size_t const worker, size_t const task) {
+        run_task(tasks[task], results[worker], matches[worker]);
+    });
+
+    auto ret = std::move(results[0]);
+    for (size_t worker = 1; worker < thread_count; ++worker) {
+        std::ranges::move(results[worker], std::back_inserter(ret));
+    }
+
+    return ret;
+}
+
+query::JoinSolutionSequence Dataset::join(std::span<query::QuadPattern const> const patterns) const {
+    std::vector<query::Variable> variables;
+    std::vector<query::JoinAtom> atoms;
+    atoms.reserve(patterns.size());
+
+    std::vector<Graph::triple> matches;
+    for (auto const &pattern : patterns) {
+        auto &atom = atoms.emplace_back();
+        atom.width = pattern.size();
+
+        query::JoinAtom::row_type bound{};
+        bool absent = false;
+        for (size_t ix = 0; ix < pattern.size(); ++ix) {
+            if (pattern[ix].is_variable()) {
+                atom.variables[ix] = query::find_or_add_variable(variables, pattern[ix].as_variable());
+                continue;
+            }
+
+            auto const node = pattern[ix].try_get_in_node_storage(node_storage_);
+            if (node.null()) {
+                absent = true;
+            } else {
+                bound[ix] = to_node_id(node);
+            }
+        }
+
+        if (absent) {
+            // the atom stays empty, therefore the join has no solutions
+            continue;
+        }
+
+        auto const &[graph_name, s, p, o] = bound;
+        for (auto const &[name, graph] : graphs_) {
+            if (!graph_name.null() && name != graph_name) {
+                continue;
+            }
+
+            matches.clear();
+            graph.collect_matches(Graph::triple{s, p, o}, matches);
+
+            for (auto const &t : matches) {
+                atom.rows.push_back(query::JoinAtom::row_type{name, t[0], t[1], t[2]});
+            }
+        }
+    }
+
+    auto const variable_count = variables.size();
+    return query::JoinSolutionSequence{std::make_shared<query::LeapfrogTriejoin>(std::move(atoms), variable_count),
+                                       std::move(variables),
+                                       node_storage_};
+}
+
+double Dataset::estimate(query::QuadPattern const &quad_pattern) const noexcept {
+    Graph::triple bound{};
+    for (size_t ix = 0; ix < bound.size(); ++ix) {
+        auto const &entry = quad_pattern[ix + 1];
+        if (entry.is_variable()) {
+            continue;
+        }
+
+        auto const node = entry.try_get_in_node_storage(node_storage_);
+        if (node.null()) {
+            return 0.0;
+        }
+
+        bound[ix] = to_node_id(node);
+    }
+
+    if (!quad_pattern.graph().is_variable()) {
+        auto const *graph = find_graph(quad_pattern.graph());
+        return graph == nullptr ? 0.0 : graph->statistics_.estimate(bound);
+    }
+
+    double ret = 0.0;
+    for (auto const &[graph_name, graph] : graphs_) {
+        ret += graph.statistics_.estimate(bound);
+    }
+
+    return ret;
+}
+
 size_t Dataset::size() const noexcept {
     return std::accumulate(graphs_.begin(), graphs_.end(), 0ul, [](auto acc, auto const &pair) noexcept {
         return acc + pair.second.size();
@@ -9,7 +9,10 @@
 #include <dice/sparse-map/sparse_map.hpp>
 
 #include <memory>
+#include <optional>
+#include <span>
 #include <utility>
+#include <vector>
 
 namespace rdf4cpp {
 
@@ -126,11 +129,69 @@ private:
     static storage::identifier::NodeBackendID to_node_id(Node node) noexcept;
     Node to_node(storage::identifier::NodeBackendID id) const noexcept;
 
+    /**
+     * @return other if it uses the node storage of this dataset, otherwise a copy of it in that node storage, stored in tmp
+     */
+    [[nodiscard]] Dataset const &in_node_storage(Dataset const &other, std::optional<Dataset> &tmp) const;
+
 public:
     explicit Dataset(storage::DynNodeStoragePtr node_storage = storage::default_node_storage);
 
+    /**
+     * Copies this dataset into node_storage.
+     * All distinct nodes of all graphs (including the graph names) are translated in bulk (see NodeIDRemapping)
+     * before the triples are rewritten in a single pass.
+     *
+     * @param node_storage the node storage of the returned dataset
+     * @return a dataset with the same quads as this one that uses node_storage
+     */
+    [[nodiscard]] Dataset to_node_storage(storage::DynNodeStoragePtr node_storage) const;
+
+    /**
+     * Rewrites all ids of this dataset (including the graph names) with remapping, e.g. after its node storage was renumbered.
+     * @param remapping a resolved remapping from the node storage of this dataset into itself
+     */
+    void remap_node_ids(NodeIDRemapping const &remapping);
+
     void add(Quad const &quad);
 
+    /**
+     * Adds all quads, like calling add for each of them, but faster for large batches.
+     *
+     * The quads are first translated into the node storage of this dataset and grouped by graph (on the calling thread),
+     * then every graph reserves capacity for its new triples and inserts them. The graphs are filled in parallel,
+     * each of them by a single thread, because a graph keeps its triples in a single hash set.
+     *
+     * @param quads the quads to add
+     * @param thread_count number of threads to use (including the calling one), 0 means std::thread::hardware_concurrency
+     */
+    void bulk_add(std::span<Quad const> quads, size_t thread_count = 0);
+
+    /**
+     * @return true if quad was in this dataset
+     */
+    bool remove(Quad const &quad);
+
+    /**
+     * Removes all quads that match quad_pattern (see Graph::erase), from all graphs if its graph position is a variable.
+     * Graphs that become empty are kept.
+     *
+     * @return the number of removed quads
+     */
+    size_t erase(query::QuadPattern const &quad_pattern);
+
+    /**
+     * Set algebra on the graphs with the same names, see the operators of Graph.
+     * Graphs that become empty are kept.
+     */
+    Dataset &operator+=(Dataset const &other); //< union
+    Dataset &operator-=(Dataset const &other); //< difference
+    Dataset &operator&=(Dataset const &other); //< intersection
+
+    friend Dataset operator+(Dataset lhs, Dataset const &rhs);
+    friend Dataset operator-(Dataset lhs, Dataset const &rhs);
+    friend Dataset operator&(Dataset lhs, Dataset const &rhs);
+
     [[nodiscard]] bool contains(Quad const &quad) const noexcept;
 
     [[nodiscard]] size_t size() const noexcept;
@@ -150,6 +211,39 @@ public:
 
     [[nodiscard]] solution_sequence match(query::QuadPattern const &quad_pattern) const noexcept;
 
+    /**
+     * Matches quad_pattern like match, but on multiple threads, and collects all solutions.
+     *
+     * The work is split into tasks that the threads take one after another: each matching graph is a task,
+     * and graphs with more than parallel_match_partition_size triples are split into partitions of their triples, each of which is a task.
+     * If a graph has indexes (see Graph::build_indexes) that apply to the pattern, it is matched through them in a single task instead.
+     * Every thread collects its solutions separately, they are concatenated at the end.
+     *
+     * @param quad_pattern the pattern to match
+     * @param thread_count number of threads to use (including the calling one), 0 means std::thread::hardware_concurrency
+     * @return the solutions, in unspecified order
+     */
+    [[nodiscard]] std::vector<query::Solution> parallel_match(query::QuadPattern const &quad_pattern, size_t thread_count = 0) const;
+
+    static constexpr size_t parallel_match_partition_size = size_t{1} << 14;
+
+    /**
+     * Evaluates the join of several quad patterns with a worst-case optimal join, see Graph::join.
+     * Each pattern matches in the graphs selected by its graph position, a variable graph position matches in all graphs.
+     *
+     * @param patterns the patterns to join
+     * @return the solutions, with the variables in order of their first occurrence in patterns
+     */
+    [[nodiscard]] query::JoinSolutionSequence join(std::span<query::QuadPattern const> patterns) const;
+
+    /**
+     * Estimates the number of solutions of quad_pattern from the statistics of the graphs (see Graph::estimate), without looking at the quads.
+     * If the graph position is a variable, the estimates of all graphs are summed up, which takes time linear in the number of graphs.
+     *
+     * @return the estimated number of matching quads
+     */
+    [[nodiscard]] double estimate(query::QuadPattern const &quad_pattern) const noexcept;
+
     template<typename ErrF = decltype([](parser::ParsingError) noexcept {})>
     void load_rdf_data(std::istream &rdf_file,
                        parser::ParsingFlags flags = parser::ParsingFlags::none(),
@@ -202,7 +296,6 @@ public:
 
     friend std::ostream &operator<<(std::ostream &os, Dataset const &self);
 
-    // TODO: support union (+) and difference (-)
     // TODO: add empty
 };
 
@@ -0,0 +1,356 @@
+#include "FrozenGraph.hpp"
+
+#include <rdf4cpp/util/Varint.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace rdf4cpp {
+
+using storage::identifier::NodeBackendID;
+
+/**
+ * @return t in the order of perm
+ */
+static std::array<NodeBackendID, 3> permute(std::array<NodeBackendID, 3> const &t, std::array<size_t, 3> const &perm) noexcept {
+    return {t[perm[0]], t[perm[1]], t[perm[2]]};
+}
+
+/**
+ * Compares the first prefix_len positions of lhs and rhs
+ */
+static std::strong_ordering compare_prefix(std::array<NodeBackendID, 3> const &lhs, std::array<NodeBackendID, 3> const &rhs, size_t const prefix_len) noexcept {
+    for (size_t k = 0; k < prefix_len; ++k) {
+        if (auto const cmp = lhs[k] <=> rhs[k]; cmp != std::strong_ordering::equal) {
+            return cmp;
+        }
+    }
+
+    return std::strong_ordering::equal;
+}
+
+FrozenGraph::PermutationStore::PermutationStore(permutation const &perm, std::vector<triple> triples) : perm{perm},
+                                                                                                       size{triples.size()} {
+    for (auto &t : triples) {
+        t = permute(t, perm);
+    }
+    std::ranges::sort(triples);
+
+    blocks.reserve((triples.size() + block_size - 1) / block_size);
+
+    std::array<std::string, 3> columns;
+    for (size_t begin = 0; begin < triples.size(); begin += block_size) {
+        auto const end = std::min(begin + block_size, triples.size());
+
+        for (auto &column : columns) {
+            column.clear();
+        }
+
+        for (size_t ix = begin + 1; ix < end; ++ix) {
+            auto const &prev = triples[ix - 1];
+            auto const &cur = triples[ix];
+
+            // the first position is sorted, so its differences are never negative
+            util::write_varint(columns[0], cur[0].to_underlying() - prev[0].to_underlying());
+            for (size_t k = 1; k < 3; ++k) {
+                util::write_varint(columns[k], util::zigzag_encode(static_cast<int64_t>(cur[k].to_underlying() - prev[k].to_underlying())));
+            }
+        }
+
+        if (columns[0].size() + columns[1].size() > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+            throw std::length_error{"block of FrozenGraph too large"};
+        }
+
+        blocks.push_back(Block{.first = triples[begin],
+                               .offset = data.size(),
+                               .column_offsets = {static_cast<uint32_t>(columns[0].size()),
+                                                  static_cast<uint32_t>(columns[0].size() + columns[1].size())}});
+
+        for (auto const &column : columns) {
+            data.append(column);
+        }
+    }
+
+    data.shrink_to_fit();
+}
+
+size_t FrozenGraph::PermutationStore::find_block(triple const &key, size_t const prefix_len) const noexcept {
+    // the last block whose first triple is smaller than key, triples with the prefix of key might start in it
+    auto const it = std::ranges::partition_point(blocks, [&key, prefix_len](Block const &block) noexcept {
+        return compare_prefix(block.first, key, prefix_len) == std::strong_ordering::less;
+    });
+
+    auto const ix = static_cast<size_t>(it - blocks.begin());
+    return ix == 0 ? 0 : ix - 1;
+}
+
+FrozenGraph::cursor::cursor(PermutationStore const &store, triple const &key, size_t const prefix_len) noexcept : store_{&store},
+                                                                                                                 key_{key},
+                                                                                                                 prefix_len_{prefix_len} {
+    if (store.size == 0) {
+        return;
+    }
+
+    at_end_ = false;
+    block_ = store.find_block(key, prefix_len);
+    load_block();
+
+    while (!at_end_ && compare_prefix() < 0) {
+        step();
+    }
+
+    if (!at_end_ && compare_prefix() > 0) {
+        at_end_ = true;
+    }
+}
+
+void FrozenGraph::cursor::load_block() noexcept {
+    auto const &block = store_->blocks[block_];
+    auto const *data = store_->data.data() + block.offset;
+
+    cur_ = block.first;
+    row_ = 0;
+    block_rows_ = std::min(block_size, store_->size - block_ * block_size);
+    columns_ = {data, data + block.column_offsets[0], data + block.column_offsets[1]};
+}
+
+void FrozenGraph::cursor::step() noexcept {
+    if (++row_ == block_rows_) {
+        if (++block_ == store_->blocks.size()) {
+            at_end_ = true;
+            return;
+        }
+
+        load_block();
+        return;
+    }
+
+    cur_[0] = NodeBackendID{cur_[0].to_underlying() + util::read_varint(columns_[0])};
+    for (size_t k = 1; k < 3; ++k) {
+        cur_[k] = NodeBackendID{cur_[k].to_underlying() + static_cast<uint64_t>(util::zigzag_decode(util::read_varint(columns_[k])))};
+    }
+}
+
+int FrozenGraph::cursor::compare_prefix() const noexcept {
+    auto const cmp = rdf4cpp::compare_prefix(cur_, key_, prefix_len_);
+    if (cmp == std::strong_ordering::less) {
+        return -1;
+    }
+
+    return cmp == std::strong_ordering::equal ? 0 : 1;
+}
+
+FrozenGraph::cursor &FrozenGraph::cursor::operator++() noexcept {
+    step();
+
+    // the triples are sorted, so the range of the prefix ends at the first triple with another prefix
+    if (!at_end_ && compare_prefix() != 0) {
+        at_end_ = true;
+    }
+
+    return *this;
+}
+
+FrozenGraph::triple FrozenGraph::cursor::operator*() const noexcept {
+    auto const &perm = store_->perm;
+
+    triple ret;
+    ret[perm[0]] = cur_[0];
+    ret[perm[1]] = cur_[1];
+    ret[perm[2]] = cur_[2];
+    return ret;
+}
+
+FrozenGraph::FrozenGraph(storage::DynNodeStoragePtr node_storage) noexcept : node_storage_{node_storage},
+                                                                             spo_{},
+                                                                             pos_{},
+                                                                             osp_{} {
+    spo_.perm = spo;
+    pos_.perm = pos;
+    osp_.perm = osp;
+}
+
+FrozenGraph::FrozenGraph(Graph const &graph) : node_storage_{graph.node_storage_} {
+    std::vector<triple> triples{graph.triples_.begin(), graph.triples_.end()};
+
+    spo_ = PermutationStore{spo, triples};
+    pos_ = PermutationStore{pos, triples};
+    osp_ = PermutationStore{osp, std::move(triples)};
+}
+
+Node FrozenGraph::to_node(NodeBackendID const id) const noexcept {
+    return Node{storage::identifier::NodeBackendHandle{id, node_storage_}};
+}
+
+Statement FrozenGraph::to_statement(triple const &t) const noexcept {
+    return Statement{to_node(t[0]), to_node(t[1]), to_node(t[2])};
+}
+
+size_t FrozenGraph::size() const noexcept {
+    return spo_.size;
+}
+
+bool FrozenGraph::contains(Statement const &stmt_) const noexcept {
+    auto const stmt = stmt_.try_get_in_node_storage(node_storage_);
+
+    triple const key{stmt.subject().backend_handle().id(), stmt.predicate().backend_handle().id(), stmt.object().backend_handle().id()};
+    if (key[0].null() || key[1].null() || key[2].null()) {
+        return false;
+    }
+
+    return !cursor{spo_, key, 3}.at_end();
+}
+
+FrozenGraph::solution_sequence FrozenGraph::match(query::TriplePattern const &triple_pattern) const noexcept {
+    triple bound{};
+    for (size_t ix = 0; ix < bound.size(); ++ix) {
+        if (triple_pattern[ix].is_variable()) {
+            continue;
+        }
+
+        auto const node = triple_pattern[ix].try_get_in_node_storage(node_storage_);
+        if (node.null()) {
+            // not present in the node storage, so there cannot be a solution
+            return solution_sequence{solution_iterator{}};
+        }
+
+        bound[ix] = node.backend_handle().id();
+    }
+
+    auto const &[s, p, o] = bound;
+
+    // pick the permutation with the longest bound prefix
+    PermutationStore const *store;
+    if (!s.null() && (!p.null() || o.null())) {
+        store = &spo_;
+    } else if (!p.null()) {
+        store = &pos_;
+    } else {
+        store = &osp_;
+    }
+
+    auto const key = permute(bound, store->perm);
+
+    size_t prefix_len = 0;
+    while (prefix_len < key.size() && !key[prefix_len].null()) {
+        ++prefix_len;
+    }
+
+    return solution_sequence{solution_iterator{iterator{this, cursor{*store, key, prefix_len}}, triple_pattern}};
+}
+
+FrozenGraph::iterator FrozenGraph::begin() const noexcept {
+    return iterator{this, cursor{spo_, triple{}, 0}};
+}
+
+FrozenGraph::sentinel FrozenGraph::end() const noexcept {
+    return sentinel{};
+}
+
+size_t FrozenGraph::memory_bytes() const noexcept {
+    size_t ret = 0;
+    for (auto const *store : {&spo_, &pos_, &osp_}) {
+        ret += store->blocks.capacity() * sizeof(PermutationStore::Block) + store->data.capacity();
+    }
+
+    return ret;
+}
+
+Graph FrozenGraph::thaw() const {
+    Graph ret{node_storage_};
+    ret.triples_.reserve(size());
+
+    for (auto cur = cursor{spo_, triple{}, 0}; !cur.at_end(); ++cur) {
+        ret.add_triple(*cur);
+    }
+
+    return ret;
+}
+
+FrozenGraph::iterator::iterator(FrozenGraph const *parent, cursor beg) noexcept : parent_{parent},
+                                                                                  cursor_{std::move(beg)} {
+    if (!cursor_.at_end()) {
+        cur_ = parent_->to_statement(*cursor_);
+    }
+}
+
+FrozenGraph::iterator &FrozenGraph::iterator::operator++() noexcept {
+    ++cursor_;
+    if (!cursor_.at_end()) {
+        cur_ = parent_->to_statement(*cursor_);
+    }
+
+    return *this;
+}
+
+FrozenGraph::iterator::reference FrozenGraph::iterator::operator*() const noexcept {
+    return cur_;
+}
+
+FrozenGraph::iterator::pointer FrozenGraph::iterator::operator->() const noexcept {
+    return &cur_;
+}
+
+bool FrozenGraph::iterator::operator==(sentinel) const noexcept {
+    return cursor_.at_end();
+}
+
+bool FrozenGraph::iterator::operator!=(sentinel) const noexcept {
+    return !cursor_.at_end();
+}
+
+bool FrozenGraph::solution_iterator::check_solution() noexcept {
+    auto pat_it = pat_.begin();
+    auto out_it = cur_.begin();
+
+    for (auto const x : *iter_) {
+        if (pat_it->is_variable()) {
+            out_it->second = x;
+            ++out_it;
+        } else if (*pat_it != x) {
+            return false;
+        }
+
+        ++pat_it;
+    }
+
+    return true;
+}
+
+void FrozenGraph::solution_iterator::forward_to_solution() noexcept {
+    while (iter_ != std::default_sentinel && !check_solution()) {
+        ++iter_;
+    }
+}
+
+FrozenGraph::solution_iterator::solution_iterator(iterator beg, query::TriplePattern const &pat) noexcept : iter_{std::move(beg)},
+                                                                                                          pat_{pat},
+                                                                                                          cur_{pat} {
+    forward_to_solution();
+}
+
+FrozenGraph::solution_iterator &FrozenGraph::solution_iterator::operator++() noexcept {
+    ++iter_;
+    forward_to_solution();
+    return *this;
+}
+
+FrozenGraph::solution_iterator::reference FrozenGraph::solution_iterator::operator*() const noexcept {
+    return cur_;
+}
+
+FrozenGraph::solution_iterator::pointer FrozenGraph::solution_iterator::operator->() const noexcept {
+    return &cur_;
+}
+
+bool FrozenGraph::solution_iterator::operator==(sentinel) const noexcept {
+    return iter_ == sentinel{};
+}
+
+bool FrozenGraph::solution_iterator::operator!=(sentinel) const noexcept {
+    return iter_ != sentinel{};
+}
+
+}  // namespace rdf4cpp
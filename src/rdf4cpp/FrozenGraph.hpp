@@ -0,0 +1,233 @@
+#ifndef RDF4CPP_FROZENGRAPH_HPP
+#define RDF4CPP_FROZENGRAPH_HPP
+
+#include <rdf4cpp/Graph.hpp>
+#include <rdf4cpp/Statement.hpp>
+#include <rdf4cpp/query/Solution.hpp>
+#include <rdf4cpp/query/TriplePattern.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace rdf4cpp {
+
+/**
+ * Immutable, compact representation of a Graph for read-mostly data, built ("frozen") from a populated Graph.
+ *
+ * The triples are stored three times, sorted in SPO, POS and OSP order. Each of these permutations is split into blocks of block_size triples.
+ * Every block stores its first triple in a small block index, the remaining triples are stored column by column, each column as varint-encoded
+ * (zigzag) differences to the previous triple. Because neighbouring triples in sorted order share most of their ids, most differences fit into a single byte.
+ *
+ * Iteration, contains and match work directly on the compressed blocks: a binary search over the block index
+ * finds the first block of a range, which is then decoded sequentially.
+ * match uses the permutation whose leading positions are bound in the pattern, therefore it only decodes the matching triples (plus at most one block).
+ */
+struct FrozenGraph {
+    using value_type = Statement;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = Statement const &;
+    using const_reference = reference;
+    using pointer = Statement const *;
+    using const_pointer = pointer;
+
+    static constexpr size_t block_size = 128;
+
+private:
+    using triple = std::array<storage::identifier::NodeBackendID, 3>;
+
+    /**
+     * The positions of a triple in the order of a permutation
+     */
+    using permutation = std::array<size_t, 3>;
+    static constexpr permutation spo{0, 1, 2};
+    static constexpr permutation pos{1, 2, 0};
+    static constexpr permutation osp{2, 0, 1};
+
+    /**
+     * All triples sorted in the order of one permutation, stored in compressed blocks
+     */
+    struct PermutationStore {
+        struct Block {
+            triple first;                          //< first triple of the block, in permuted order
+            size_t offset;                         //< offset of the first column of the block into data
+            std::array<uint32_t, 2> column_offsets; //< offsets of the second and third column, relative to offset
+        };
+
+        permutation perm;
+        size_t size = 0; //< number of triples
+        std::vector<Block> blocks;
+        std::string data; //< columns of all blocks, without the first triples
+
+        PermutationStore() noexcept = default;
+        PermutationStore(permutation const &perm, std::vector<triple> triples);
+
+        /**
+         * @param key triple in permuted order, only the first prefix_len positions are considered
+         * @return index of the first block that could contain a triple with the given prefix
+         */
+        [[nodiscard]] size_t find_block(triple const &key, size_t prefix_len) const noexcept;
+    };
+
+    /**
+     * Decodes the triples of a PermutationStore sequentially, optionally only the ones with a given prefix (in permuted order)
+     */
+    struct cursor {
+    private:
+        PermutationStore const *store_ = nullptr;
+        size_t block_ = 0;
+        size_t row_ = 0;        //< index of the current triple in its block
+        size_t block_rows_ = 0; //< number of triples in the current block
+        std::array<char const *, 3> columns_{};
+        triple cur_{};          //< current triple, in permuted order
+        triple key_{};
+        size_t prefix_len_ = 0;
+        bool at_end_ = true;
+
+        void load_block() noexcept;
+        void step() noexcept;
+        [[nodiscard]] int compare_prefix() const noexcept;
+
+    public:
+        cursor() noexcept = default;
+
+        /**
+         * Positions the cursor at the first triple of store with the first prefix_len positions of key
+         */
+        cursor(PermutationStore const &store, triple const &key, size_t prefix_len) noexcept;
+
+        cursor &operator++() noexcept;
+
+        /**
+         * @return the current triple in subject, predicate, object order
+         */
+        [[nodiscard]] triple operator*() const noexcept;
+
+        [[nodiscard]] bool at_end() const noexcept {
+            return at_end_;
+        }
+    };
+
+    storage::DynNodeStoragePtr node_storage_;
+    PermutationStore spo_;
+    PermutationStore pos_;
+    PermutationStore osp_;
+
+    [[nodiscard]] Node to_node(storage::identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] Statement to_statement(triple const &t) const noexcept;
+
+public:
+    using sentinel = std::default_sentinel_t;
+
+    struct iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Statement;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+        FrozenGraph const *parent_ = nullptr;
+        cursor cursor_;
+        Statement cur_;
+
+    public:
+        iterator() noexcept = default;
+        iterator(FrozenGraph const *parent, cursor beg) noexcept;
+
+        iterator &operator++() noexcept;
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        bool operator==(sentinel) const noexcept;
+        bool operator!=(sentinel) const noexcept;
+    };
+
+    using const_iterator = iterator;
+
+    struct solution_iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = query::Solution;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+        iterator iter_;
+        query::TriplePattern pat_;
+        value_type cur_;
+
+        bool check_solution() noexcept;
+        void forward_to_solution() noexcept;
+
+    public:
+        solution_iterator() noexcept = default;
+        solution_iterator(iterator beg, query::TriplePattern const &pat) noexcept;
+
+        solution_iterator &operator++() noexcept;
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        bool operator==(sentinel) const noexcept;
+        bool operator!=(sentinel) const noexcept;
+    };
+
+    struct solution_sequence {
+        using value_type = query::Solution;
+        using iterator = solution_iterator;
+        using const_iterator = solution_iterator;
+        using sentinel = std::default_sentinel_t;
+
+    private:
+        iterator beg_;
+
+    public:
+        explicit solution_sequence(iterator beg) noexcept : beg_{beg} {
+        }
+
+        [[nodiscard]] iterator begin() const noexcept {
+            return beg_;
+        }
+
+        [[nodiscard]] static sentinel end() noexcept {
+            return sentinel{};
+        }
+    };
+
+    explicit FrozenGraph(storage::DynNodeStoragePtr node_storage = storage::default_node_storage) noexcept;
+
+    /**
+     * Freezes graph, i.e. copies all of its triples.
+     * The frozen graph uses the node storage of graph, which must outlive it.
+     */
+    explicit FrozenGraph(Graph const &graph);
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool contains(Statement const &statement) const noexcept;
+
+    [[nodiscard]] solution_sequence match(query::TriplePattern const &triple_pattern) const noexcept;
+
+    /**
+     * Iterates the statements in subject, predicate, object order (of their ids)
+     */
+    [[nodiscard]] iterator begin() const noexcept;
+    [[nodiscard]] sentinel end() const noexcept;
+
+    /**
+     * @return number of bytes occupied by the compressed triples, including the block indices
+     */
+    [[nodiscard]] size_t memory_bytes() const noexcept;
+
+    /**
+     * @return a mutable copy of this graph
+     */
+    [[nodiscard]] Graph thaw() const;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_FROZENGRAPH_HPP
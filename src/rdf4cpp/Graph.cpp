@@ -3,6 +3,10 @@
 #include <rdf4cpp/writer/TryWrite.hpp>
 #include <rdf4cpp/writer/SerializationState.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
 #include <utility>
 
 namespace rdf4cpp {
@@ -18,9 +22,282 @@ Node Graph::to_node(storage::identifier::NodeBackendID id) const noexcept {
 Graph::Graph(storage::DynNodeStoragePtr node_storage) noexcept : node_storage_{node_storage} {
 }
 
+void Graph::add_ids_to(NodeIDRemapping &remapping) const {
+    for (auto const &[s, p, o] : triples_) {
+        remapping.add(s);
+        remapping.add(p);
+        remapping.add(o);
+    }
+}
+
+Graph Graph::remap(NodeIDRemapping const &remapping, storage::DynNodeStoragePtr node_storage) const {
+    Graph ret{node_storage};
+    ret.triples_.reserve(triples_.size());
+    if (indexes_.has_value()) {
+        ret.indexes_.emplace();
+    }
+
+    for (auto const &[s, p, o] : triples_) {
+        ret.add_triple(triple{remapping[s], remapping[p], remapping[o]});
+    }
+
+    return ret;
+}
+
+Graph Graph::to_node_storage(storage::DynNodeStoragePtr node_storage) const {
+    if (node_storage == node_storage_) {
+        return *this;
+    }
+
+    NodeIDRemapping remapping{node_storage_, node_storage};
+    add_ids_to(remapping);
+    remapping.resolve();
+
+    return remap(remapping, node_storage);
+}
+
+void Graph::remap_node_ids(NodeIDRemapping const &remapping) {
+    assert(remapping.from() == node_storage_ && remapping.to() == node_storage_);
+    *this = remap(remapping, node_storage_);
+}
+
+void Graph::index_triple(triple const &t) {
+    auto const insert = [&t](index_type &index, permutation const &perm) {
+        index[t[perm[0]]][t[perm[1]]].push_back(t[perm[2]]);
+    };
+
+    insert(indexes_->spo, spo);
+    insert(indexes_->pos, pos);
+    insert(indexes_->osp, osp);
+}
+
+void Graph::add_triple(triple const &t) {
+    if (!triples_.insert(t).second) {
+        return;
+    }
+
+    statistics_.add(t);
+    if (indexes_.has_value()) {
+        index_triple(t);
+    }
+}
+
+void Graph::unindex_triple(triple const &t) {
+    auto const erase = [&t](index_type &index, permutation const &perm) {
+        auto const first_it = index.find(t[perm[0]]);
+        assert(first_it != index.end());
+
+        auto &inner = first_it.value();
+        auto const second_it = inner.find(t[perm[1]]);
+        assert(second_it != inner.end());
+
+        // the order of a leaf does not matter, so the removed id is replaced by the last one
+        auto &leaf = second_it.value();
+        auto const third_it = std::ranges::find(leaf, t[perm[2]]);
+        assert(third_it != leaf.end());
+        *third_it = leaf.back();
+        leaf.pop_back();
+
+        if (leaf.empty()) {
+            inner.erase(second_it);
+            if (inner.empty()) {
+                index.erase(first_it);
+            }
+        }
+    };
+
+    erase(indexes_->spo, spo);
+    erase(indexes_->pos, pos);
+    erase(indexes_->osp, osp);
+}
+
+bool Graph::remove_triple(triple const &t) {
+    if (triples_.erase(t) == 0) {
+        return false;
+    }
+
+    statistics_.remove(t);
+    if (indexes_.has_value()) {
+        unindex_triple(t);
+    }
+
+    return true;
+}
+
+void Graph::build_indexes() {
+    if (indexes_.has_value()) {
+        return;
+    }
+
+    indexes_.emplace();
+    for (auto const &t : triples_) {
+        index_triple(t);
+    }
+}
+
+bool Graph::has_indexes() const noexcept {
+    return indexes_.has_value();
+}
+
 void Graph::add(Statement const &stmt_) {
     auto stmt = stmt_.to_node_storage(node_storage_);
-    triples_.insert(triple{to_node_id(stmt.subject()), to_node_id(stmt.predicate()), to_node_id(stmt.object())});
+    add_triple(triple{to_node_id(stmt.subject()), to_node_id(stmt.predicate()), to_node_id(stmt.object())});
+}
+
+void Graph::add_triples(std::span<triple const> const triples) {
+    triples_.reserve(triples_.size() + triples.size());
+    for (auto const &t : triples) {
+        add_triple(t);
+    }
+}
+
+void Graph::bulk_add(std::span<Statement const> const statements) {
+    std::vector<triple> triples;
+    triples.reserve(statements.size());
+
+    for (auto const &stmt_ : statements) {
+        auto const stmt = stmt_.to_node_storage(node_storage_);
+        triples.push_back(triple{to_node_id(stmt.subject()), to_node_id(stmt.predicate()), to_node_id(stmt.object())});
+    }
+
+    add_triples(triples);
+}
+
+bool Graph::remove(Statement const &stmt_) {
+    auto const stmt = stmt_.try_get_in_node_storage(node_storage_);
+    return remove_triple(triple{to_node_id(stmt.subject()), to_node_id(stmt.predicate()), to_node_id(stmt.object())});
+}
+
+size_t Graph::erase(query::TriplePattern const &triple_pattern) {
+    auto const bound = bind(triple_pattern);
+    if (!bound.has_value()) {
+        return 0;
+    }
+
+    // collected first, the triple set and the indexes must not change while they are traversed
+    std::vector<triple> matches;
+    collect_matches(*bound, matches);
+
+    for (auto const &t : matches) {
+        remove_triple(t);
+    }
+
+    return matches.size();
+}
+
+Graph const &Graph::in_node_storage(Graph const &other, std::optional<Graph> &tmp) const {
+    if (other.node_storage_ == node_storage_) {
+        return other;
+    }
+
+    return tmp.emplace(other.to_node_storage(node_storage_));
+}
+
+Graph &Graph::operator+=(Graph const &other_) {
+    if (&other_ == this) {
+        return *this;
+    }
+
+    std::optional<Graph> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    triples_.reserve(triples_.size() + other.triples_.size());
+    for (auto const &t : other.triples_) {
+        add_triple(t);
+    }
+
+    return *this;
+}
+
+Graph &Graph::operator-=(Graph const &other_) {
+    if (&other_ == this) {
+        Graph empty{node_storage_};
+        if (indexes_.has_value()) {
+            empty.indexes_.emplace();
+        }
+
+        *this = std::move(empty);
+        return *this;
+    }
+
+    std::optional<Graph> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    if (other.triples_.size() <= triples_.size()) {
+        for (auto const &t : other.triples_) {
+            remove_triple(t);
+        }
+
+        return *this;
+    }
+
+    // collected first, the triple set must not change while it is traversed
+    std::vector<triple> removed;
+    for (auto const &t : triples_) {
+        if (other.triples_.contains(t)) {
+            removed.push_back(t);
+        }
+    }
+
+    for (auto const &t : removed) {
+        remove_triple(t);
+    }
+
+    return *this;
+}
+
+Graph &Graph::operator&=(Graph const &other_) {
+    if (&other_ == this) {
+        return *this;
+    }
+
+    std::optional<Graph> tmp;
+    auto const &other = in_node_storage(other_, tmp);
+
+    if (other.triples_.size() < triples_.size()) {
+        // rebuilding from the smaller graph only visits its triples
+        Graph ret{node_storage_};
+        if (indexes_.has_value()) {
+            ret.indexes_.emplace();
+        }
+
+        for (auto const &t : other.triples_) {
+            if (triples_.contains(t)) {
+                ret.add_triple(t);
+            }
+        }
+
+        *this = std::move(ret);
+        return *this;
+    }
+
+    std::vector<triple> removed;
+    for (auto const &t : triples_) {
+        if (!other.triples_.contains(t)) {
+            removed.push_back(t);
+        }
+    }
+
+    for (auto const &t : removed) {
+        remove_triple(t);
+    }
+
+    return *this;
+}
+
+Graph operator+(Graph lhs, Graph const &rhs) {
+    lhs += rhs;
+    return lhs;
+}
+
+Graph operator-(Graph lhs, Graph const &rhs) {
+    lhs -= rhs;
+    return lhs;
+}
+
+Graph operator&(Graph lhs, Graph const &rhs) {
+    lhs &= rhs;
+    return lhs;
 }
 
 bool Graph::contains(Statement const &stmt_) const noexcept {
@@ -36,8 +313,190 @@ Graph::sentinel Graph::end() const noexcept {
     return sentinel{};
 }
 
+std::pair<Graph::index_type const *, Graph::permutation const *> Graph::select_index(triple const &bound) const noexcept {
+    assert(indexes_.has_value());
+
+    auto const &[s, p, o] = bound;
+
+    // pick the index whose first position is bound and whose second position is bound too, if possible
+    if (!s.null() && (!p.null() || o.null())) {
+        return {&indexes_->spo, &spo};
+    }
+
+    if (!p.null()) {
+        return {&indexes_->pos, &pos};
+    }
+
+    if (!o.null()) {
+        return {&indexes_->osp, &osp};
+    }
+
+    return {nullptr, nullptr};
+}
+
+std::optional<Graph::triple> Graph::bind(query::TriplePattern const &triple_pattern) const noexcept {
+    triple bound{};
+    for (size_t ix = 0; ix < bound.size(); ++ix) {
+        if (triple_pattern[ix].is_variable()) {
+            continue;
+        }
+
+        auto const node = triple_pattern[ix].try_get_in_node_storage(node_storage_);
+        if (node.null()) {
+            return std::nullopt;
+        }
+
+        bound[ix] = to_node_id(node);
+    }
+
+    return bound;
+}
+
 Graph::solution_sequence Graph::match(query::TriplePattern const &triple_pattern) const noexcept {
-    return solution_sequence{solution_iterator{begin(), triple_pattern}};
+    if (!indexes_.has_value()) {
+        return solution_sequence{solution_iterator{begin(), triple_pattern}};
+    }
+
+    auto const bound_ = bind(triple_pattern);
+    if (!bound_.has_value()) {
+        // not present in the node storage, so there cannot be a solution
+        return solution_sequence{solution_iterator{}};
+    }
+
+    auto const &bound = *bound_;
+    auto const [index, perm] = select_index(bound);
+    if (index == nullptr) {
+        return solution_sequence{solution_iterator{begin(), triple_pattern}};
+    }
+
+    auto const first = bound[(*perm)[0]];
+    auto const second = bound[(*perm)[1]];
+
+    auto const first_it = index->find(first);
+    if (first_it == index->end()) {
+        return solution_sequence{solution_iterator{}};
+    }
+
+    auto const &inner = first_it->second;
+    if (second.null()) {
+        return solution_sequence{solution_iterator{index_cursor{this, *perm, first, inner.begin(), inner.end()}, triple_pattern}};
+    }
+
+    auto const second_it = inner.find(second);
+    if (second_it == inner.end()) {
+        return solution_sequence{solution_iterator{}};
+    }
+
+    // the remaining position (if bound) is checked by the solution_iterator
+    return solution_sequence{solution_iterator{index_cursor{this, *perm, first, second_it, std::next(second_it)}, triple_pattern}};
+}
+
+void Graph::collect_matches(triple const &bound, std::vector<triple> &out) const {
+    auto const matches = [&bound](triple const &t) noexcept {
+        for (size_t ix = 0; ix < t.size(); ++ix) {
+            if (!bound[ix].null() && bound[ix] != t[ix]) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    if (indexes_.has_value()) {
+        if (auto const [index, perm] = select_index(bound); index != nullptr) {
+            auto const first = bound[(*perm)[0]];
+            auto const second = bound[(*perm)[1]];
+
+            auto const first_it = index->find(first);
+            if (first_it == index->end()) {
+                return;
+            }
+
+            for (auto const &[second_id, leaf] : first_it->second) {
+                if (!second.null() && second_id != second) {
+                    continue;
+                }
+
+                for (auto const third_id : leaf) {
+                    triple t;
+                    t[(*perm)[0]] = first;
+                    t[(*perm)[1]] = second_id;
+                    t[(*perm)[2]] = third_id;
+
+                    if (matches(t)) {
+                        out.push_back(t);
+                    }
+                }
+            }
+
+            return;
+        }
+    }
+
+    for (auto const &t : triples_) {
+        if (matches(t)) {
+            out.push_back(t);
+        }
+    }
+}
+
+query::JoinSolutionSequence Graph::join(std::span<query::TriplePattern const> const patterns) const {
+    std::vector<query::Variable> variables;
+    std::vector<query::JoinAtom> atoms;
+    atoms.reserve(patterns.size());
+
+    std::vector<triple> matches;
+    for (auto const &pattern : patterns) {
+        auto &atom = atoms.emplace_back();
+        atom.width = pattern.size();
+
+        triple bound{};
+        bool absent = false;
+        for (size_t ix = 0; ix < bound.size(); ++ix) {
+            if (pattern[ix].is_variable()) {
+                atom.variables[ix] = query::find_or_add_variable(variables, pattern[ix].as_variable());
+                continue;
+            }
+
+            auto const node = pattern[ix].try_get_in_node_storage(node_storage_);
+            if (node.null()) {
+                absent = true;
+            } else {
+                bound[ix] = to_node_id(node);
+            }
+        }
+
+        if (absent) {
+            // the atom stays empty, therefore the join has no solutions
+            continue;
+        }
+
+        matches.clear();
+        collect_matches(bound, matches);
+
+        atom.rows.reserve(matches.size());
+        for (auto const &[s, p, o] : matches) {
+            atom.rows.push_back(query::JoinAtom::row_type{s, p, o, {}});
+        }
+    }
+
+    auto const variable_count = variables.size();
+    return query::JoinSolutionSequence{std::make_shared<query::LeapfrogTriejoin>(std::move(atoms), variable_count),
+                                       std::move(variables),
+                                       node_storage_};
+}
+
+double Graph::estimate(query::TriplePattern const &triple_pattern) const noexcept {
+    auto const bound = bind(triple_pattern);
+    if (!bound.has_value()) {
+        return 0.0;
+    }
+
+    return statistics_.estimate(*bound);
+}
+
+GraphStatistics const &Graph::statistics() const noexcept {
+    return statistics_;
 }
 
 size_t Graph::size() const noexcept {
@@ -123,11 +582,71 @@ bool Graph::iterator::operator!=(Graph::sentinel) const noexcept {
     return !(*this == Graph::sentinel{});
 }
 
+Graph::index_cursor::index_cursor(Graph const *parent,
+                                  permutation const &perm,
+                                  storage::identifier::NodeBackendID const first,
+                                  typename index_inner_type::const_iterator inner_beg,
+                                  typename index_inner_type::const_iterator inner_end) noexcept : parent_{parent},
+                                                                                                 perm_{perm},
+                                                                                                 first_{first},
+                                                                                                 inner_iter_{inner_beg},
+                                                                                                 inner_end_{inner_end} {
+    if (inner_iter_ != inner_end_) {
+        fill_statement();
+    }
+}
+
+void Graph::index_cursor::fill_statement() noexcept {
+    triple t;
+    t[perm_[0]] = first_;
+    t[perm_[1]] = inner_iter_->first;
+    t[perm_[2]] = inner_iter_->second[leaf_ix_];
+
+    cur_ = Statement{parent_->to_node(t[0]), parent_->to_node(t[1]), parent_->to_node(t[2])};
+}
+
+Graph::index_cursor &Graph::index_cursor::operator++() noexcept {
+    if (++leaf_ix_ == inner_iter_->second.size()) {
+        ++inner_iter_;
+        leaf_ix_ = 0;
+    }
+
+    if (inner_iter_ != inner_end_) {
+        fill_statement();
+    }
+
+    return *this;
+}
+
+Statement const &Graph::index_cursor::operator*() const noexcept {
+    return cur_;
+}
+
+bool Graph::index_cursor::at_end() const noexcept {
+    return inner_iter_ == inner_end_;
+}
+
+bool Graph::solution_iterator::at_end() const noexcept {
+    if (use_index_) {
+        return index_iter_.at_end();
+    }
+
+    return iter_ == std::default_sentinel;
+}
+
+Statement const &Graph::solution_iterator::current_statement() const noexcept {
+    if (use_index_) {
+        return *index_iter_;
+    }
+
+    return *iter_;
+}
+
 bool Graph::solution_iterator::check_solution() noexcept {
     auto pat_it = pat_.begin();
     auto out_it = cur_.begin();
 
-    for (auto const x : *iter_) {
+    for (auto const x : current_statement()) {
         if (pat_it->is_variable()) {
             out_it->second = x;
             ++out_it;
@@ -142,8 +661,12 @@ bool Graph::solution_iterator::check_solution() noexcept {
 }
 
 void Graph::solution_iterator::forward_to_solution() noexcept {
-    while (iter_ != std::default_sentinel && !check_solution()) {
-        ++iter_;
+    while (!at_end() && !check_solution()) {
+        if (use_index_) {
+            ++index_iter_;
+        } else {
+            ++iter_;
+        }
     }
 }
 
@@ -154,8 +677,21 @@ Graph::solution_iterator::solution_iterator(typename Graph::iterator beg,
     forward_to_solution();
 }
 
+Graph::solution_iterator::solution_iterator(index_cursor beg,
+                                            query::TriplePattern const &pat) noexcept : index_iter_{std::move(beg)},
+                                                                                        use_index_{true},
+                                                                                        pat_{pat},
+                                                                                        cur_{pat} {
+    forward_to_solution();
+}
+
 Graph::solution_iterator &Graph::solution_iterator::operator++() noexcept {
-    ++iter_;
+    if (use_index_) {
+        ++index_iter_;
+    } else {
+        ++iter_;
+    }
+
     forward_to_solution();
     return *this;
 }
@@ -169,11 +705,11 @@ Graph::solution_iterator::pointer Graph::solution_iterator::operator->() const n
 }
 
 bool Graph::solution_iterator::operator==(Graph::sentinel) const noexcept {
-    return iter_ == Graph::sentinel{};
+    return at_end();
 }
 
 bool Graph::solution_iterator::operator!=(Graph::sentinel) const noexcept {
-    return iter_ != Graph::sentinel{};
+    return !at_end();
 }
 
 }  // namespace rdf4cpp
@@ -1,15 +1,24 @@
 #ifndef RDF4CPP_GRAPH_HPP
 #define RDF4CPP_GRAPH_HPP
 
+#include <rdf4cpp/GraphStatistics.hpp>
+#include <rdf4cpp/NodeIDRemapping.hpp>
 #include <rdf4cpp/Statement.hpp>
+#include <rdf4cpp/query/LeapfrogTriejoin.hpp>
 #include <rdf4cpp/query/TriplePattern.hpp>
 #include <rdf4cpp/query/Solution.hpp>
 #include <rdf4cpp/writer/BufWriter.hpp>
 #include <rdf4cpp/writer/SerializationState.hpp>
 #include <rdf4cpp/parser/RDFFileParser.hpp>
 
+#include <dice/sparse-map/sparse_map.hpp>
 #include <dice/sparse-map/sparse_set.hpp>
 
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
 
 namespace rdf4cpp {
 
@@ -33,6 +42,58 @@ private:
 
     using triple_storage_type = dice::sparse_map::sparse_set<triple, triple_hash>;
 
+    /**
+     * A permutation index maps the first position of a triple to its second position to all of its third positions,
+     * e.g. the SPO index maps a subject to its predicates to their objects.
+     */
+    using index_leaf_type = std::vector<storage::identifier::NodeBackendID>;
+    using index_inner_type = dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, index_leaf_type>;
+    using index_type = dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, index_inner_type>;
+
+    /**
+     * The positions of a triple in the order of a permutation index
+     */
+    using permutation = std::array<size_t, 3>;
+    static constexpr permutation spo{0, 1, 2};
+    static constexpr permutation pos{1, 2, 0};
+    static constexpr permutation osp{2, 0, 1};
+
+    struct indexes_type {
+        index_type spo;
+        index_type pos;
+        index_type osp;
+    };
+
+    /**
+     * Iterates over the triples in a range of the inner map of a permutation index
+     */
+    struct index_cursor {
+    private:
+        Graph const *parent_ = nullptr;
+        permutation perm_{};
+        storage::identifier::NodeBackendID first_;
+        typename index_inner_type::const_iterator inner_iter_{};
+        typename index_inner_type::const_iterator inner_end_{};
+        size_t leaf_ix_ = 0;
+
+        Statement cur_;
+
+        void fill_statement() noexcept;
+
+    public:
+        index_cursor() noexcept = default;
+        index_cursor(Graph const *parent,
+                     permutation const &perm,
+                     storage::identifier::NodeBackendID first,
+                     typename index_inner_type::const_iterator inner_beg,
+                     typename index_inner_type::const_iterator inner_end) noexcept;
+
+        index_cursor &operator++() noexcept;
+        Statement const &operator*() const noexcept;
+
+        [[nodiscard]] bool at_end() const noexcept;
+    };
+
 public:
     using sentinel = std::default_sentinel_t;
 
@@ -75,9 +136,14 @@ public:
 
     private:
         typename Graph::iterator iter_;
+        index_cursor index_iter_; //< used instead of iter_ if use_index_ is true
+        bool use_index_ = false;
         query::TriplePattern pat_;
         value_type cur_;
 
+        [[nodiscard]] bool at_end() const noexcept;
+        [[nodiscard]] Statement const &current_statement() const noexcept;
+
         bool check_solution() noexcept;
         void forward_to_solution() noexcept;
 
@@ -85,6 +151,8 @@ public:
         solution_iterator() noexcept = default;
         solution_iterator(typename Graph::iterator beg,
                           query::TriplePattern const &pat) noexcept;
+        solution_iterator(index_cursor beg,
+                          query::TriplePattern const &pat) noexcept;
 
         solution_iterator &operator++() noexcept;
         reference operator*() const noexcept;
@@ -125,20 +193,158 @@ public:
 private:
     storage::DynNodeStoragePtr node_storage_;
     triple_storage_type triples_;
+    std::optional<indexes_type> indexes_; //< only present if build_indexes was called
+    GraphStatistics statistics_;
+
+    /**
+     * Inserts t into triples_ and, if new, records it in the statistics and the indexes (if present)
+     */
+    void add_triple(triple const &t);
+    void index_triple(triple const &t);
+
+    /**
+     * Erases t from triples_ and, if it was present, from the statistics and the indexes (if present)
+     * @return true if t was present
+     */
+    bool remove_triple(triple const &t);
+    void unindex_triple(triple const &t);
+
+    /**
+     * Adds all triples, with capacity for them reserved up front
+     */
+    void add_triples(std::span<triple const> triples);
+
+    /**
+     * @param bound a triple with the ids of the bound positions, null ids for variables
+     * @return the index (and its permutation) that match should use for bound, nullptr if no position is bound
+     * @pre the indexes are present
+     */
+    [[nodiscard]] std::pair<index_type const *, permutation const *> select_index(triple const &bound) const noexcept;
+
+    /**
+     * @return the ids of the bound positions of triple_pattern, null ids for variables, or nullopt if a bound node is not in the node storage
+     */
+    [[nodiscard]] std::optional<triple> bind(query::TriplePattern const &triple_pattern) const noexcept;
+
+    /**
+     * @return other if it uses the node storage of this graph, otherwise a copy of it in that node storage, stored in tmp
+     */
+    [[nodiscard]] Graph const &in_node_storage(Graph const &other, std::optional<Graph> &tmp) const;
+
+    /**
+     * Appends all triples that agree with the non-null positions of bound to out, using the indexes if present
+     */
+    void collect_matches(triple const &bound, std::vector<triple> &out) const;
 
     static storage::identifier::NodeBackendID to_node_id(Node node) noexcept;
     Node to_node(storage::identifier::NodeBackendID id) const noexcept;
 
+    /**
+     * Adds all ids of this graph to remapping
+     */
+    void add_ids_to(NodeIDRemapping &remapping) const;
+
+    /**
+     * @return a copy of this graph in node_storage, with all ids translated by the already resolved remapping
+     */
+    [[nodiscard]] Graph remap(NodeIDRemapping const &remapping, storage::DynNodeStoragePtr node_storage) const;
+
+    friend struct ConcurrentGraph;
+    friend struct Dataset;
+    friend struct FrozenGraph;
+    friend struct GraphSnapshot;
+
 public:
     explicit Graph(storage::DynNodeStoragePtr node_storage = storage::default_node_storage) noexcept;
 
+    /**
+     * Copies this graph into node_storage.
+     * All distinct nodes are translated in bulk (see NodeIDRemapping) before the triples are rewritten in a single pass,
+     * which is much faster than adding every Statement to a new Graph.
+     *
+     * @param node_storage the node storage of the returned graph
+     * @return a graph with the same statements as this one that uses node_storage
+     */
+    [[nodiscard]] Graph to_node_storage(storage::DynNodeStoragePtr node_storage) const;
+
+    /**
+     * Rewrites all ids of this graph with remapping, e.g. after its node storage was renumbered.
+     * @param remapping a resolved remapping from the node storage of this graph into itself
+     */
+    void remap_node_ids(NodeIDRemapping const &remapping);
+
+    /**
+     * Builds hashed permutation indexes (SPO, POS and OSP) over the triples of this graph, which are maintained by add from then on.
+     * With the indexes, match only visits the triples that agree with the bound (i.e. non-variable) positions of the pattern,
+     * instead of all triples of this graph. They need about three times the memory of the triples themselves.
+     * Does nothing if the indexes are already built.
+     */
+    void build_indexes();
+    [[nodiscard]] bool has_indexes() const noexcept;
+
     void add(Statement const &statement);
 
+    /**
+     * Adds all statements, like calling add for each of them, but reserves capacity for all of them up front
+     * instead of growing (and rehashing) the triple set step by step.
+     */
+    void bulk_add(std::span<Statement const> statements);
+
+    /**
+     * @return true if statement was in this graph
+     */
+    bool remove(Statement const &statement);
+
+    /**
+     * Removes all statements that match triple_pattern, using the indexes (if built) to find them.
+     * Like match, repeated variables are not required to be bound to the same node.
+     *
+     * @return the number of removed statements
+     */
+    size_t erase(query::TriplePattern const &triple_pattern);
+
+    /**
+     * Set algebra on the id triples of the graphs, i.e. without translating any Statement.
+     * Difference and intersection probe the triple set of the larger graph for every triple of the smaller one, where possible.
+     * If other uses another node storage, it is copied into the node storage of this graph first (see to_node_storage).
+     */
+    Graph &operator+=(Graph const &other); //< union
+    Graph &operator-=(Graph const &other); //< difference
+    Graph &operator&=(Graph const &other); //< intersection
+
+    friend Graph operator+(Graph lhs, Graph const &rhs);
+    friend Graph operator-(Graph lhs, Graph const &rhs);
+    friend Graph operator&(Graph lhs, Graph const &rhs);
+
     [[nodiscard]] size_t size() const noexcept;
     [[nodiscard]] bool contains(Statement const &statement) const noexcept;
 
     [[nodiscard]] solution_sequence match(query::TriplePattern const &triple_pattern) const noexcept;
 
+    /**
+     * Evaluates a basic graph pattern, i.e. the join of several triple patterns, with a worst-case optimal join (see query::LeapfrogTriejoin).
+     * The matches of each pattern are collected (using the indexes, if built) and sorted once, then the solutions are enumerated lazily,
+     * one variable at a time in an order chosen by cardinality estimates. In contrast to nested loops over match,
+     * the work stays bounded by the largest possible result, also for cyclic patterns (e.g. triangles).
+     *
+     * @param patterns the patterns to join, a variable that occurs in multiple patterns must have the same value in all of them
+     * @return the solutions, with the variables in order of their first occurrence in patterns
+     */
+    [[nodiscard]] query::JoinSolutionSequence join(std::span<query::TriplePattern const> patterns) const;
+
+    /**
+     * Estimates the number of solutions of triple_pattern from the statistics of this graph, without looking at the triples.
+     * Repeated variables are treated like distinct ones.
+     *
+     * @return the estimated number of matching triples, 0 if a bound node is not in the node storage or the bound predicate does not occur
+     */
+    [[nodiscard]] double estimate(query::TriplePattern const &triple_pattern) const noexcept;
+
+    /**
+     * @return the statistics of this graph, which are updated by add
+     */
+    [[nodiscard]] GraphStatistics const &statistics() const noexcept;
+
     [[nodiscard]] iterator begin() const noexcept;
     [[nodiscard]] sentinel end() const noexcept;
 
@@ -196,7 +402,6 @@ public:
      */
     friend std::ostream &operator<<(std::ostream &os, Graph const &graph);
 
-    // TODO: support union (+) and difference (-); open question: which graph name should be assigned?
     // TODO: add empty
 };
 }  // namespace rdf4cpp
@@ -0,0 +1,179 @@
+#include "GraphSnapshot.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace rdf4cpp {
+
+using storage::identifier::NodeBackendID;
+
+GraphSnapshot::GraphSnapshot(storage::DynNodeStoragePtr node_storage) noexcept : node_storage_{node_storage} {
+}
+
+GraphSnapshot::GraphSnapshot(storage::DynNodeStoragePtr node_storage, std::vector<std::shared_ptr<chunk_type const>> chunks) noexcept : node_storage_{node_storage},
+                                                                                                                                         chunks_{std::move(chunks)} {
+    for (auto const &chunk : chunks_) {
+        size_ += chunk->size();
+    }
+}
+
+size_t GraphSnapshot::chunk_index(triple const &t, size_t const chunk_count) noexcept {
+    auto const hash = static_cast<uint64_t>(triple_hash{}(t));
+    return static_cast<size_t>(((hash >> 32) * chunk_count) >> 32);
+}
+
+Node GraphSnapshot::to_node(NodeBackendID const id) const noexcept {
+    return Node{storage::identifier::NodeBackendHandle{id, node_storage_}};
+}
+
+storage::DynNodeStoragePtr GraphSnapshot::node_storage() const noexcept {
+    return node_storage_;
+}
+
+size_t GraphSnapshot::size() const noexcept {
+    return size_;
+}
+
+bool GraphSnapshot::contains(Statement const &stmt_) const noexcept {
+    if (chunks_.empty()) {
+        return false;
+    }
+
+    auto const stmt = stmt_.try_get_in_node_storage(node_storage_);
+
+    triple const t{stmt.subject().backend_handle().id(), stmt.predicate().backend_handle().id(), stmt.object().backend_handle().id()};
+    return chunks_[chunk_index(t, chunks_.size())]->contains(t);
+}
+
+GraphSnapshot::solution_sequence GraphSnapshot::match(query::TriplePattern const &triple_pattern) const noexcept {
+    return solution_sequence{solution_iterator{begin(), triple_pattern}};
+}
+
+GraphSnapshot::iterator GraphSnapshot::begin() const noexcept {
+    return iterator{this};
+}
+
+GraphSnapshot::sentinel GraphSnapshot::end() const noexcept {
+    return sentinel{};
+}
+
+size_t GraphSnapshot::shared_chunk_count(GraphSnapshot const &other) const noexcept {
+    size_t ret = 0;
+    for (size_t ix = 0; ix < std::min(chunks_.size(), other.chunks_.size()); ++ix) {
+        ret += chunks_[ix] == other.chunks_[ix];
+    }
+
+    return ret;
+}
+
+Graph GraphSnapshot::to_graph() const {
+    Graph ret{node_storage_};
+    ret.triples_.reserve(size_);
+
+    for (auto const &chunk : chunks_) {
+        for (auto const &t : *chunk) {
+            ret.add_triple(t);
+        }
+    }
+
+    return ret;
+}
+
+GraphSnapshot::iterator::iterator(GraphSnapshot const *parent) noexcept : parent_{parent} {
+    if (!parent_->chunks_.empty()) {
+        iter_ = parent_->chunks_.front()->begin();
+    }
+
+    settle();
+}
+
+void GraphSnapshot::iterator::settle() noexcept {
+    auto const &chunks = parent_->chunks_;
+    while (chunk_ < chunks.size() && iter_ == chunks[chunk_]->end()) {
+        if (++chunk_ < chunks.size()) {
+            iter_ = chunks[chunk_]->begin();
+        }
+    }
+
+    if (chunk_ < chunks.size()) {
+        auto const &[s, p, o] = *iter_;
+        cur_ = Statement{parent_->to_node(s), parent_->to_node(p), parent_->to_node(o)};
+    }
+}
+
+GraphSnapshot::iterator &GraphSnapshot::iterator::operator++() noexcept {
+    ++iter_;
+    settle();
+    return *this;
+}
+
+GraphSnapshot::iterator::reference GraphSnapshot::iterator::operator*() const noexcept {
+    return cur_;
+}
+
+GraphSnapshot::iterator::pointer GraphSnapshot::iterator::operator->() const noexcept {
+    return &cur_;
+}
+
+bool GraphSnapshot::iterator::operator==(sentinel) const noexcept {
+    return parent_ == nullptr || chunk_ == parent_->chunks_.size();
+}
+
+bool GraphSnapshot::iterator::operator!=(sentinel) const noexcept {
+    return !(*this == sentinel{});
+}
+
+bool GraphSnapshot::solution_iterator::check_solution() noexcept {
+    auto pat_it = pat_.begin();
+    auto out_it = cur_.begin();
+
+    for (auto const x : *iter_) {
+        if (pat_it->is_variable()) {
+            out_it->second = x;
+            ++out_it;
+        } else if (*pat_it != x) {
+            return false;
+        }
+
+        ++pat_it;
+    }
+
+    return true;
+}
+
+void GraphSnapshot::solution_iterator::forward_to_solution() noexcept {
+    while (iter_ != std::default_sentinel && !check_solution()) {
+        ++iter_;
+    }
+}
+
+GraphSnapshot::solution_iterator::solution_iterator(iterator beg, query::TriplePattern const &pat) noexcept : iter_{std::move(beg)},
+                                                                                                            pat_{pat},
+                                                                                                            cur_{pat} {
+    forward_to_solution();
+}
+
+GraphSnapshot::solution_iterator &GraphSnapshot::solution_iterator::operator++() noexcept {
+    ++iter_;
+    forward_to_solution();
+    return *this;
+}
+
+GraphSnapshot::solution_iterator::reference GraphSnapshot::solution_iterator::operator*() const noexcept {
+    return cur_;
+}
+
+GraphSnapshot::solution_iterator::pointer GraphSnapshot::solution_iterator::operator->() const noexcept {
+    return &cur_;
+}
+
+bool GraphSnapshot::solution_iterator::operator==(sentinel) const noexcept {
+    return iter_ == sentinel{};
+}
+
+bool GraphSnapshot::solution_iterator::operator!=(sentinel) const noexcept {
+    return iter_ != sentinel{};
+}
+
+}  // namespace rdf4cpp
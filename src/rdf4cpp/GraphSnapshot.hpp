@@ -0,0 +1,185 @@
+#ifndef RDF4CPP_GRAPHSNAPSHOT_HPP
+#define RDF4CPP_GRAPHSNAPSHOT_HPP
+
+#include <rdf4cpp/Graph.hpp>
+#include <rdf4cpp/Statement.hpp>
+#include <rdf4cpp/query/Solution.hpp>
+#include <rdf4cpp/query/TriplePattern.hpp>
+
+#include <dice/sparse-map/sparse_set.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace rdf4cpp {
+
+/**
+ * Immutable version of a ConcurrentGraph (see ConcurrentGraph::snapshot), for readers that need a consistent view for a long time.
+ *
+ * The triples are split into small chunks by their hash (see ConcurrentGraph::chunk_count), which are shared with the graph and all other snapshots of it
+ * instead of being copied. When the graph changes a chunk that is still referenced by a snapshot, it copies that chunk first (copy-on-write),
+ * so taking a snapshot is as cheap as copying a pointer per chunk and later changes only copy the chunks they touch.
+ * A chunk is freed as soon as neither the graph nor any snapshot refers to it.
+ *
+ * A snapshot can be read by multiple threads at the same time, it does not lock anything.
+ */
+struct GraphSnapshot {
+    using value_type = Statement;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = Statement const &;
+    using const_reference = reference;
+    using pointer = Statement const *;
+    using const_pointer = pointer;
+
+private:
+    using triple = std::array<storage::identifier::NodeBackendID, 3>;
+
+    struct triple_hash {
+        size_t operator()(triple const &trip) const noexcept {
+            return dice::hash::dice_hash_templates<dice::hash::Policies::wyhash>::dice_hash(trip);
+        }
+    };
+
+    using chunk_type = dice::sparse_map::sparse_set<triple, triple_hash>;
+
+    storage::DynNodeStoragePtr node_storage_;
+    std::vector<std::shared_ptr<chunk_type const>> chunks_;
+    size_t size_ = 0;
+
+    /**
+     * @param node_storage node storage of the ids in chunks
+     * @param chunks the chunks, a triple must be in the chunk with index chunk_index(triple, chunks.size())
+     */
+    GraphSnapshot(storage::DynNodeStoragePtr node_storage, std::vector<std::shared_ptr<chunk_type const>> chunks) noexcept;
+
+    /**
+     * Determines the chunk responsible for t.
+     * Uses the upper half of the hash, because the hash sets of the chunks use the lower bits to select buckets.
+     */
+    [[nodiscard]] static size_t chunk_index(triple const &t, size_t chunk_count) noexcept;
+
+    [[nodiscard]] Node to_node(storage::identifier::NodeBackendID id) const noexcept;
+
+    friend struct ConcurrentGraph;
+
+public:
+    using sentinel = std::default_sentinel_t;
+
+    struct iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Statement;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+        GraphSnapshot const *parent_ = nullptr;
+        size_t chunk_ = 0;
+        typename chunk_type::const_iterator iter_{};
+
+        Statement cur_;
+
+        /**
+         * Skips empty chunks and fills cur_, if not at the end
+         */
+        void settle() noexcept;
+
+    public:
+        iterator() noexcept = default;
+        explicit iterator(GraphSnapshot const *parent) noexcept;
+
+        iterator &operator++() noexcept;
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        bool operator==(sentinel) const noexcept;
+        bool operator!=(sentinel) const noexcept;
+    };
+
+    using const_iterator = iterator;
+
+    struct solution_iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = query::Solution;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+        iterator iter_;
+        query::TriplePattern pat_;
+        value_type cur_;
+
+        bool check_solution() noexcept;
+        void forward_to_solution() noexcept;
+
+    public:
+        solution_iterator() noexcept = default;
+        solution_iterator(iterator beg, query::TriplePattern const &pat) noexcept;
+
+        solution_iterator &operator++() noexcept;
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        bool operator==(sentinel) const noexcept;
+        bool operator!=(sentinel) const noexcept;
+    };
+
+    struct solution_sequence {
+        using value_type = query::Solution;
+        using iterator = solution_iterator;
+        using const_iterator = solution_iterator;
+        using sentinel = std::default_sentinel_t;
+
+    private:
+        iterator beg_;
+
+    public:
+        explicit solution_sequence(iterator beg) noexcept : beg_{beg} {
+        }
+
+        [[nodiscard]] iterator begin() const noexcept {
+            return beg_;
+        }
+
+        [[nodiscard]] static sentinel end() noexcept {
+            return sentinel{};
+        }
+    };
+
+    /**
+     * Creates an empty snapshot
+     */
+    explicit GraphSnapshot(storage::DynNodeStoragePtr node_storage = storage::default_node_storage) noexcept;
+
+    [[nodiscard]] storage::DynNodeStoragePtr node_storage() const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] bool contains(Statement const &statement) const noexcept;
+
+    /**
+     * Like Graph::match, repeated variables are not required to be bound to the same node
+     */
+    [[nodiscard]] solution_sequence match(query::TriplePattern const &triple_pattern) const noexcept;
+
+    [[nodiscard]] iterator begin() const noexcept;
+    [[nodiscard]] sentinel end() const noexcept;
+
+    /**
+     * @return the number of chunks that are also referenced by other, i.e. that did not have to be copied between the two versions
+     */
+    [[nodiscard]] size_t shared_chunk_count(GraphSnapshot const &other) const noexcept;
+
+    /**
+     * @return a mutable copy of this snapshot
+     */
+    [[nodiscard]] Graph to_graph() const;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_GRAPHSNAPSHOT_HPP
@@ -0,0 +1,112 @@
+#include "GraphStatistics.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+namespace rdf4cpp {
+
+using storage::identifier::NodeBackendID;
+
+static uint64_t hash(NodeBackendID const id) noexcept {
+    return std::hash<NodeBackendID>{}(id);
+}
+
+/**
+ * @return the estimated number of distinct values of sketch, clamped to [1, count]
+ */
+static double distinct(GraphStatistics::sketch_type const &sketch, size_t const count) noexcept {
+    return std::clamp(sketch.estimate(), 1.0, std::max(static_cast<double>(count), 1.0));
+}
+
+/**
+ * Estimates the number of triples with count triples (and the given numbers of distinct subjects and objects) that agree with the bound subject and object
+ */
+static double estimate_bound(double const count, double const subjects, double const objects, bool const subject_bound, bool const object_bound) noexcept {
+    auto ret = count;
+    if (subject_bound) {
+        ret /= subjects;
+    }
+
+    if (object_bound) {
+        ret /= objects;
+    }
+
+    return ret;
+}
+
+void GraphStatistics::add(triple const &t) {
+    auto const &[s, p, o] = t;
+
+    ++size_;
+    subjects_.add(hash(s));
+    objects_.add(hash(o));
+
+    auto &pstats = predicates_[p];
+    ++pstats.count;
+    pstats.subjects.add(hash(s));
+    pstats.objects.add(hash(o));
+}
+
+void GraphStatistics::remove(triple const &t) {
+    assert(size_ > 0);
+
+    if (--size_ == 0) {
+        // nothing left, start over with empty sketches
+        *this = GraphStatistics{};
+        return;
+    }
+
+    auto const it = predicates_.find(t[1]);
+    assert(it != predicates_.end());
+
+    if (--it.value().count == 0) {
+        predicates_.erase(it);
+    }
+}
+
+double GraphStatistics::estimate(triple const &bound) const noexcept {
+    auto const &[s, p, o] = bound;
+
+    if (p.null()) {
+        return estimate_bound(static_cast<double>(size_), distinct_subjects(), distinct_objects(), !s.null(), !o.null());
+    }
+
+    auto const *pstats = find_predicate(p);
+    if (pstats == nullptr) {
+        return 0.0;
+    }
+
+    return estimate_bound(static_cast<double>(pstats->count),
+                          distinct(pstats->subjects, pstats->count),
+                          distinct(pstats->objects, pstats->count),
+                          !s.null(),
+                          !o.null());
+}
+
+size_t GraphStatistics::size() const noexcept {
+    return size_;
+}
+
+size_t GraphStatistics::predicate_count() const noexcept {
+    return predicates_.size();
+}
+
+GraphStatistics::PredicateStatistics const *GraphStatistics::find_predicate(NodeBackendID const predicate) const noexcept {
+    auto const it = predicates_.find(predicate);
+    if (it == predicates_.end()) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+double GraphStatistics::distinct_subjects() const noexcept {
+    return distinct(subjects_, size_);
+}
+
+double GraphStatistics::distinct_objects() const noexcept {
+    return distinct(objects_, size_);
+}
+
+}  // namespace rdf4cpp
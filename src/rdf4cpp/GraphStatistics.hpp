@@ -0,0 +1,72 @@
+#ifndef RDF4CPP_GRAPHSTATISTICS_HPP
+#define RDF4CPP_GRAPHSTATISTICS_HPP
+
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+#include <rdf4cpp/util/HyperLogLog.hpp>
+
+#include <dice/sparse-map/sparse_map.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace rdf4cpp {
+
+/**
+ * Summary of the triples of a Graph for cardinality estimation (e.g. to plan joins), maintained incrementally by Graph::add and Graph::remove.
+ *
+ * Counts the triples in total and per predicate. The numbers of distinct subjects and objects (in total and per predicate)
+ * are estimated with HyperLogLog sketches, such that the statistics need constant space per predicate.
+ * Estimates assume that the values of different positions are independent and uniformly distributed.
+ * The sketches cannot forget values, therefore after removals the distinct counts only shrink with the triple counts they are clamped to.
+ */
+struct GraphStatistics {
+    using sketch_type = util::HyperLogLog<8>;
+
+    struct PredicateStatistics {
+        size_t count = 0; //< number of triples with the predicate
+        sketch_type subjects;
+        sketch_type objects;
+    };
+
+private:
+    using triple = std::array<storage::identifier::NodeBackendID, 3>;
+
+    size_t size_ = 0;
+    sketch_type subjects_;
+    sketch_type objects_;
+    dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, PredicateStatistics> predicates_;
+
+public:
+    /**
+     * Records a triple
+     * @pre t was not recorded before
+     */
+    void add(triple const &t);
+
+    /**
+     * Forgets a triple
+     * @pre t was recorded before
+     */
+    void remove(triple const &t);
+
+    /**
+     * @param bound a triple with the ids of the bound positions of a pattern, null ids for variables
+     * @return the estimated number of triples that agree with bound
+     */
+    [[nodiscard]] double estimate(triple const &bound) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    [[nodiscard]] size_t predicate_count() const noexcept;
+
+    /**
+     * @return the statistics of predicate, nullptr if there is no triple with it
+     */
+    [[nodiscard]] PredicateStatistics const *find_predicate(storage::identifier::NodeBackendID predicate) const noexcept;
+
+    [[nodiscard]] double distinct_subjects() const noexcept;
+    [[nodiscard]] double distinct_objects() const noexcept;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_GRAPHSTATISTICS_HPP
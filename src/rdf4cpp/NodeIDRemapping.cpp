@@ -0,0 +1,305 @@
+#include "NodeIDRemapping.hpp"
+
+#include <rdf4cpp/Literal.hpp>
+
+#include <dice/template-library/overloaded.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace rdf4cpp {
+
+using storage::identifier::NodeBackendID;
+
+/**
+ * Number of nodes that are interned in the target storage with a single batch call
+ */
+static constexpr size_t batch_size = 1024;
+
+namespace {
+
+/**
+ * Owns copies of the strings of a batch of views.
+ * Views returned by a node storage are not guaranteed to stay valid across further calls to it
+ * (e.g. reconstructed prefix-compressed IRIs), therefore their strings are copied before the batch is interned.
+ */
+struct StringPool {
+    struct Ref {
+        size_t offset;
+        size_t size;
+    };
+
+private:
+    std::string buf_;
+
+public:
+    [[nodiscard]] Ref add(std::string_view const s) {
+        Ref const ref{.offset = buf_.size(), .size = s.size()};
+        buf_.append(s);
+        return ref;
+    }
+
+    /**
+     * @note only valid until the next call to add
+     */
+    [[nodiscard]] std::string_view get(Ref const ref) const noexcept {
+        return std::string_view{buf_}.substr(ref.offset, ref.size);
+    }
+
+    void clear() noexcept {
+        buf_.clear();
+    }
+};
+
+/**
+ * Interns the nodes with the given ids in batches of batch_size.
+ *
+ * @param copy copy(id, pool) copies the view of the node with id into pool and returns a handle to it,
+ *      or nullopt if it already translated the id itself
+ * @param make make(handle, pool) creates the view from a handle returned by copy
+ * @param assign assign(id, new_id) records the translation
+ */
+template<typename View, typename Copy, typename Make, typename Assign>
+void intern_in_batches(storage::DynNodeStoragePtr to, std::span<NodeBackendID const> const ids, Copy &&copy, Make &&make, Assign &&assign) {
+    using handle_type = typename std::invoke_result_t<Copy &, NodeBackendID, StringPool &>::value_type;
+
+    StringPool pool;
+    std::vector<NodeBackendID> batch_ids;
+    std::vector<handle_type> handles;
+    std::vector<View> views;
+    std::vector<NodeBackendID> new_ids;
+
+    for (size_t begin = 0; begin < ids.size(); begin += batch_size) {
+        pool.clear();
+        batch_ids.clear();
+        handles.clear();
+        views.clear();
+
+        for (auto const id : ids.subspan(begin, std::min(batch_size, ids.size() - begin))) {
+            if (auto handle = copy(id, pool); handle.has_value()) {
+                batch_ids.push_back(id);
+                handles.push_back(std::move(*handle));
+            }
+        }
+
+        // all strings are copied, the views into the pool stay valid now
+        for (auto const &handle : handles) {
+            views.push_back(make(handle, pool));
+        }
+
+        new_ids.resize(views.size());
+        to.find_or_make_ids(std::span<View const>{views}, std::span{new_ids});
+
+        for (size_t ix = 0; ix < batch_ids.size(); ++ix) {
+            assign(batch_ids[ix], new_ids[ix]);
+        }
+    }
+}
+
+} // namespace
+
+NodeIDRemapping::NodeIDRemapping(storage::DynNodeStoragePtr from, storage::DynNodeStoragePtr to) noexcept : from_{from},
+                                                                                                           to_{to} {
+}
+
+void NodeIDRemapping::add(NodeBackendID const id) {
+    if (id.null()) {
+        return;
+    }
+
+    if (mapping_.try_emplace(id, NodeBackendID{}).second) {
+        unresolved_.push_back(id);
+    }
+}
+
+void NodeIDRemapping::resolve() {
+    std::vector<NodeBackendID> iris;
+    std::vector<NodeBackendID> bnodes;
+    std::vector<NodeBackendID> variables;
+    std::vector<NodeBackendID> literals;
+
+    for (auto const id : unresolved_) {
+        if (id.is_iri()) {
+            iris.push_back(id);
+        } else if (id.is_blank_node()) {
+            bnodes.push_back(id);
+        } else if (id.is_variable()) {
+            variables.push_back(id);
+        } else {
+            assert(id.is_literal());
+            literals.push_back(id);
+        }
+    }
+
+    unresolved_.clear();
+
+    resolve_iris(iris);
+    resolve_bnodes(bnodes);
+    resolve_variables(variables);
+    resolve_literals(literals);
+}
+
+void NodeIDRemapping::resolve_iris(std::vector<NodeBackendID> const &ids) {
+    intern_in_batches<storage::view::IRIBackendView>(
+            to_, ids,
+            [this](NodeBackendID const id, StringPool &pool) {
+                return std::optional{pool.add(from_.find_iri_backend(id).identifier)};
+            },
+            [](StringPool::Ref const ref, StringPool const &pool) noexcept {
+                return storage::view::IRIBackendView{.identifier = pool.get(ref)};
+            },
+            [this](NodeBackendID const id, NodeBackendID const new_id) noexcept {
+                mapping_.find(id).value() = new_id;
+            });
+}
+
+void NodeIDRemapping::resolve_bnodes(std::vector<NodeBackendID> const &ids) {
+    intern_in_batches<storage::view::BNodeBackendView>(
+            to_, ids,
+            [this](NodeBackendID const id, StringPool &pool) {
+                return std::optional{pool.add(from_.find_bnode_backend(id).identifier)};
+            },
+            [](StringPool::Ref const ref, StringPool const &pool) noexcept {
+                return storage::view::BNodeBackendView{.identifier = pool.get(ref)};
+            },
+            [this](NodeBackendID const id, NodeBackendID const new_id) noexcept {
+                mapping_.find(id).value() = new_id;
+            });
+}
+
+void NodeIDRemapping::resolve_variables(std::vector<NodeBackendID> const &ids) {
+    intern_in_batches<storage::view::VariableBackendView>(
+            to_, ids,
+            [this](NodeBackendID const id, StringPool &pool) {
+                auto const view = from_.find_variable_backend(id);
+                return std::optional{std::make_pair(pool.add(view.name), view.is_anonymous)};
+            },
+            [](std::pair<StringPool::Ref, bool> const &handle, StringPool const &pool) noexcept {
+                return storage::view::VariableBackendView{.name = pool.get(handle.first), .is_anonymous = handle.second};
+            },
+            [this](NodeBackendID const id, NodeBackendID const new_id) noexcept {
+                mapping_.find(id).value() = new_id;
+            });
+}
+
+void NodeIDRemapping::resolve_literals(std::vector<NodeBackendID> const &ids) {
+    struct LexicalHandle {
+        NodeBackendID datatype_id; //< datatype IRI in to_
+        StringPool::Ref lexical_form;
+        StringPool::Ref language_tag;
+        bool needs_escape;
+    };
+
+    using Handle = std::variant<LexicalHandle, storage::view::ValueLiteralBackendView>;
+
+    // translates a single literal like Literal::to_node_storage does, used for the cases that need conversions
+    auto const translate_single = [this](NodeBackendID const id) {
+        mapping_.find(id).value() = Literal{storage::identifier::NodeBackendHandle{id, from_}}.to_node_storage(to_).backend_handle().id();
+    };
+
+    std::vector<NodeBackendID> batched;
+    batched.reserve(ids.size());
+
+    for (auto const id : ids) {
+        if (id.is_inlined()) {
+            // inlined literals do not need the storage, except for the lexical form of inlined rdf:langString literals
+            translate_single(id);
+        } else {
+            batched.push_back(id);
+        }
+    }
+
+    intern_in_batches<storage::view::LiteralBackendView>(
+            to_, batched,
+            [&](NodeBackendID const id, StringPool &pool) -> std::optional<Handle> {
+                auto const literal = from_.find_literal_backend(id);
+
+                if (literal.is_value()) {
+                    if (auto const &value = literal.get_value(); to_.has_specialized_storage_for(value.datatype)) {
+                        return value;
+                    }
+
+                    // to_ needs the lexical form
+                    translate_single(id);
+                    return std::nullopt;
+                }
+
+                auto const &lexical = literal.get_lexical();
+                if (auto const datatype = storage::identifier::iri_node_id_to_literal_type(lexical.datatype_id);
+                    datatype.is_fixed() && to_.has_specialized_storage_for(datatype)) {
+
+                    // to_ needs the value
+                    translate_single(id);
+                    return std::nullopt;
+                }
+
+                LexicalHandle handle{.datatype_id = lexical.datatype_id,
+                                     .lexical_form = pool.add(lexical.lexical_form),
+                                     .language_tag = pool.add(lexical.language_tag),
+                                     .needs_escape = lexical.needs_escape};
+
+                // only after the strings are copied, looking up the datatype might invalidate lexical
+                if (!mapping_.contains(handle.datatype_id)) {
+                    mapping_.try_emplace(handle.datatype_id, NodeBackendID{});
+                    resolve_iris(std::vector{handle.datatype_id});
+                }
+
+                handle.datatype_id = (*this)[handle.datatype_id];
+                return handle;
+            },
+            [](Handle const &handle, StringPool const &pool) -> storage::view::LiteralBackendView {
+                return std::visit(dice::template_library::overloaded{
+                                          [&pool](LexicalHandle const &lexical) -> storage::view::LiteralBackendView {
+                                              return storage::view::LexicalFormLiteralBackendView{.datatype_id = lexical.datatype_id,
+                                                                                                  .lexical_form = pool.get(lexical.lexical_form),
+                                                                                                  .language_tag = pool.get(lexical.language_tag),
+                                                                                                  .needs_escape = lexical.needs_escape};
+                                          },
+                                          [](storage::view::ValueLiteralBackendView const &value) -> storage::view::LiteralBackendView {
+                                              return value;
+                                          }},
+                                  handle);
+            },
+            [this](NodeBackendID const id, NodeBackendID const new_id) noexcept {
+                mapping_.find(id).value() = new_id;
+            });
+}
+
+void NodeIDRemapping::assign(NodeBackendID const from_id, NodeBackendID const to_id) {
+    [[maybe_unused]] auto const inserted = mapping_.try_emplace(from_id, to_id).second;
+    assert(inserted);
+}
+
+NodeBackendID NodeIDRemapping::operator[](NodeBackendID const id) const noexcept {
+    if (id.null()) {
+        return id;
+    }
+
+    auto const it = mapping_.find(id);
+    if (it == mapping_.end()) {
+        assert(from_ == to_);
+        return id;
+    }
+
+    return it->second;
+}
+
+storage::DynNodeStoragePtr NodeIDRemapping::from() const noexcept {
+    return from_;
+}
+
+storage::DynNodeStoragePtr NodeIDRemapping::to() const noexcept {
+    return to_;
+}
+
+size_t NodeIDRemapping::size() const noexcept {
+    return mapping_.size();
+}
+
+}  // namespace rdf4cpp
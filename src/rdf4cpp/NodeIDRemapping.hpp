@@ -0,0 +1,79 @@
+#ifndef RDF4CPP_NODEIDREMAPPING_HPP
+#define RDF4CPP_NODEIDREMAPPING_HPP
+
+#include <rdf4cpp/storage/NodeStorage.hpp>
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+
+#include <dice/sparse-map/sparse_map.hpp>
+
+#include <vector>
+
+namespace rdf4cpp {
+
+/**
+ * Translates NodeBackendIDs of one node storage into the NodeBackendIDs of the same nodes in another node storage, in bulk.
+ * This is what Graph::to_node_storage and Dataset::to_node_storage use, it can also be used to move other id based structures
+ * (e.g. triple arrays) between storages.
+ *
+ * Usage: add all ids that need to be translated, call resolve once, then look up the translated ids with operator[].
+ * resolve interns all distinct nodes in the target storage using its batch interface (see storage::find_or_make_ids),
+ * instead of one round trip per node and occurrence like Node::to_node_storage.
+ *
+ * If from and to are the same storage, the mapping describes a renumbering of that storage (see e.g. UnsyncReferenceNodeStorage::renumber),
+ * in that case only the ids that changed are part of it.
+ */
+struct NodeIDRemapping {
+private:
+    storage::DynNodeStoragePtr from_;
+    storage::DynNodeStoragePtr to_;
+    dice::sparse_map::sparse_map<storage::identifier::NodeBackendID, storage::identifier::NodeBackendID> mapping_;
+    std::vector<storage::identifier::NodeBackendID> unresolved_;
+
+    void resolve_iris(std::vector<storage::identifier::NodeBackendID> const &ids);
+    void resolve_bnodes(std::vector<storage::identifier::NodeBackendID> const &ids);
+    void resolve_variables(std::vector<storage::identifier::NodeBackendID> const &ids);
+    void resolve_literals(std::vector<storage::identifier::NodeBackendID> const &ids);
+
+public:
+    /**
+     * @param from storage the ids that will be added belong to
+     * @param to storage the ids will be translated into
+     */
+    NodeIDRemapping(storage::DynNodeStoragePtr from, storage::DynNodeStoragePtr to) noexcept;
+
+    /**
+     * Registers id for translation, adding the same id multiple times is cheap.
+     * @param id id of a node in from or the null id
+     */
+    void add(storage::identifier::NodeBackendID id);
+
+    /**
+     * Translates all ids that were added since the last call to resolve, creating the nodes in to if necessary.
+     */
+    void resolve();
+
+    /**
+     * Records that from_id in from is to_id in to, without consulting any of the storages.
+     * @pre from_id was not added before
+     */
+    void assign(storage::identifier::NodeBackendID from_id, storage::identifier::NodeBackendID to_id);
+
+    /**
+     * @param id an id that was added and resolved (or assigned) before.
+     *      If from and to are the same storage, any id is allowed, ids that are not part of the mapping are unchanged.
+     * @return the id of the same node in to
+     */
+    [[nodiscard]] storage::identifier::NodeBackendID operator[](storage::identifier::NodeBackendID id) const noexcept;
+
+    [[nodiscard]] storage::DynNodeStoragePtr from() const noexcept;
+    [[nodiscard]] storage::DynNodeStoragePtr to() const noexcept;
+
+    /**
+     * @return number of distinct ids known to this mapping
+     */
+    [[nodiscard]] size_t size() const noexcept;
+};
+
+}  // namespace rdf4cpp
+
+#endif  //RDF4CPP_NODEIDREMAPPING_HPP
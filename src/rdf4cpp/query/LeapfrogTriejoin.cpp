@@ -0,0 +1,434 @@
+#include "LeapfrogTriejoin.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <tuple>
+#include <utility>
+
+namespace rdf4cpp::query {
+
+size_t find_or_add_variable(std::vector<Variable> &variables, Variable const &variable) {
+    auto const it = std::ranges::find(variables, variable);
+    if (it != variables.end()) {
+        return static_cast<size_t>(it - variables.begin());
+    }
+
+    variables.push_back(variable);
+    return variables.size() - 1;
+}
+
+LeapfrogTriejoin::TrieIterator::TrieIterator(Relation const &relation) noexcept : relation_{&relation} {
+}
+
+size_t LeapfrogTriejoin::TrieIterator::gallop(id_type const key, bool const strict) const noexcept {
+    auto const column = depth_ - 1;
+    auto const end = ends_[column];
+    auto const &rows = relation_->rows;
+
+    auto const before = [column, key, strict](row_type const &row) noexcept {
+        return strict ? row[column] <= key : row[column] < key;
+    };
+
+    auto lo = pos_;
+    if (lo == end || !before(rows[lo])) {
+        return lo;
+    }
+
+    // exponential search first, the next key is usually close by
+    size_t step = 1;
+    while (lo + step < end && before(rows[lo + step])) {
+        lo += step;
+        step *= 2;
+    }
+
+    // before(rows[lo]) holds, the result is in (lo, min(lo + step, end)]
+    auto const first = rows.begin() + static_cast<ptrdiff_t>(lo + 1);
+    auto const last = rows.begin() + static_cast<ptrdiff_t>(std::min(lo + step, end));
+    return static_cast<size_t>(std::partition_point(first, last, before) - rows.begin());
+}
+
+void LeapfrogTriejoin::TrieIterator::open() noexcept {
+    assert(depth_ < relation_->arity);
+
+    if (depth_ == 0) {
+        begins_[0] = 0;
+        ends_[0] = relation_->rows.size();
+    } else {
+        // the rows below the current key are the ones that share it
+        begins_[depth_] = pos_;
+        ends_[depth_] = gallop(key(), true);
+    }
+
+    ++depth_;
+}
+
+void LeapfrogTriejoin::TrieIterator::up() noexcept {
+    assert(depth_ > 0);
+
+    --depth_;
+    pos_ = begins_[depth_];
+}
+
+void LeapfrogTriejoin::TrieIterator::next() noexcept {
+    pos_ = gallop(key(), true);
+}
+
+void LeapfrogTriejoin::TrieIterator::seek(id_type const key) noexcept {
+    pos_ = gallop(key, false);
+}
+
+LeapfrogTriejoin::id_type LeapfrogTriejoin::TrieIterator::key() const noexcept {
+    return relation_->rows[pos_][depth_ - 1];
+}
+
+bool LeapfrogTriejoin::TrieIterator::at_end() const noexcept {
+    return pos_ == ends_[depth_ - 1];
+}
+
+LeapfrogTriejoin::LeapfrogTriejoin(std::vector<JoinAtom> atoms, size_t const variable_count) {
+    /**
+     * distinct variables of an atom and the first position of each of them
+     */
+    struct AtomVariables {
+        std::vector<size_t> variables;
+        std::vector<size_t> positions;
+    };
+
+    std::vector<AtomVariables> atom_variables;
+    atom_variables.reserve(atoms.size());
+
+    for (auto &atom : atoms) {
+        auto &av = atom_variables.emplace_back();
+
+        for (size_t ix = 0; ix < atom.width; ++ix) {
+            auto const var = atom.variables[ix];
+            if (var == JoinAtom::no_variable) {
+                continue;
+            }
+
+            assert(var < variable_count);
+            if (std::ranges::find(av.variables, var) != av.variables.end()) {
+                continue;
+            }
+
+            av.variables.push_back(var);
+            av.positions.push_back(ix);
+        }
+
+        // a variable that occurs more than once in a pattern requires the same value at all of its positions
+        std::erase_if(atom.rows, [&atom](row_type const &row) noexcept {
+            for (size_t ix = 0; ix < atom.width; ++ix) {
+                for (size_t prev = 0; prev < ix; ++prev) {
+                    if (atom.variables[ix] != JoinAtom::no_variable && atom.variables[ix] == atom.variables[prev] && row[ix] != row[prev]) {
+                        return true;
+                    }
+                }
+            }
+
+            return false;
+        });
+
+        if (atom.rows.empty()) {
+            empty_ = true;
+        }
+    }
+
+    if (empty_) {
+        return;
+    }
+
+    // estimate the cardinality of each variable by its smallest number of distinct values in an atom
+    std::vector<size_t> estimates(variable_count, std::numeric_limits<size_t>::max());
+    std::vector<size_t> occurrences(variable_count, 0);
+    std::vector<id_type> column;
+
+    for (size_t ax = 0; ax < atoms.size(); ++ax) {
+        auto const &av = atom_variables[ax];
+
+        for (size_t vx = 0; vx < av.variables.size(); ++vx) {
+            column.clear();
+            for (auto const &row : atoms[ax].rows) {
+                column.push_back(row[av.positions[vx]]);
+            }
+
+            std::ranges::sort(column);
+            auto const distinct = static_cast<size_t>(std::unique(column.begin(), column.end()) - column.begin());
+
+            auto const var = av.variables[vx];
+            estimates[var] = std::min(estimates[var], distinct);
+            ++occurrences[var];
+        }
+    }
+
+    // greedily pick the variable with the smallest estimate, preferring variables that share an atom with the already picked ones
+    // to avoid enumerating cross products
+    std::vector<bool> picked(variable_count, false);
+    std::vector<bool> connected(variable_count, false);
+    order_.reserve(variable_count);
+    level_of_.assign(variable_count, 0);
+
+    for (size_t level = 0; level < variable_count; ++level) {
+        auto const rank = [&](size_t const var) noexcept {
+            return std::make_tuple(!connected[var], estimates[var], std::numeric_limits<size_t>::max() - occurrences[var], var);
+        };
+
+        size_t best = JoinAtom::no_variable;
+        for (size_t var = 0; var < variable_count; ++var) {
+            if (!picked[var] && (best == JoinAtom::no_variable || rank(var) < rank(best))) {
+                best = var;
+            }
+        }
+
+        assert(occurrences[best] > 0);
+        picked[best] = true;
+        order_.push_back(best);
+        level_of_[best] = level;
+
+        for (auto const &av : atom_variables) {
+            if (std::ranges::find(av.variables, best) != av.variables.end()) {
+                for (auto const var : av.variables) {
+                    connected[var] = true;
+                }
+            }
+        }
+    }
+
+    // project every atom onto its variables in join order, sorted, which makes it a trie
+    levels_.resize(variable_count);
+    relations_.reserve(atoms.size());
+
+    for (size_t ax = 0; ax < atoms.size(); ++ax) {
+        auto const &av = atom_variables[ax];
+        if (av.variables.empty()) {
+            // only constants, which are known to match because the atom is not empty
+            continue;
+        }
+
+        std::vector<size_t> by_level(av.variables.size());
+        for (size_t vx = 0; vx < by_level.size(); ++vx) {
+            by_level[vx] = vx;
+        }
+        std::ranges::sort(by_level, [&](size_t const lhs, size_t const rhs) noexcept {
+            return level_of_[av.variables[lhs]] < level_of_[av.variables[rhs]];
+        });
+
+        auto &relation = relations_.emplace_back();
+        relation.arity = by_level.size();
+        relation.rows.reserve(atoms[ax].rows.size());
+
+        for (auto const &row : atoms[ax].rows) {
+            row_type projected{};
+            for (size_t k = 0; k < by_level.size(); ++k) {
+                projected[k] = row[av.positions[by_level[k]]];
+            }
+            relation.rows.push_back(projected);
+        }
+
+        std::ranges::sort(relation.rows);
+        relation.rows.erase(std::unique(relation.rows.begin(), relation.rows.end()), relation.rows.end());
+
+        for (auto const vx : by_level) {
+            levels_[level_of_[av.variables[vx]]].iterators.push_back(relations_.size() - 1);
+        }
+
+        // free the input early, it is no longer needed
+        atoms[ax].rows = {};
+    }
+
+    iterators_.reserve(relations_.size());
+    for (auto const &relation : relations_) {
+        iterators_.emplace_back(relation);
+    }
+}
+
+bool LeapfrogTriejoin::search(size_t const level_ix) noexcept {
+    auto &level = levels_[level_ix];
+    auto const k = level.iterators.size();
+
+    // the largest key is the one of the iterator that was moved last
+    auto max_key = iterators_[level.iterators[(level.p + k - 1) % k]].key();
+
+    while (true) {
+        auto &iter = iterators_[level.iterators[level.p]];
+        if (auto const key = iter.key(); key == max_key) {
+            // all iterators agree
+            level.value = key;
+            return true;
+        }
+
+        iter.seek(max_key);
+        if (iter.at_end()) {
+            return false;
+        }
+
+        max_key = iter.key();
+        level.p = (level.p + 1) % k;
+    }
+}
+
+bool LeapfrogTriejoin::open_level(size_t const level_ix) noexcept {
+    auto &level = levels_[level_ix];
+
+    for (auto const ix : level.iterators) {
+        iterators_[ix].open();
+    }
+
+    for (auto const ix : level.iterators) {
+        if (iterators_[ix].at_end()) {
+            return false;
+        }
+    }
+
+    std::ranges::sort(level.iterators, [this](size_t const lhs, size_t const rhs) noexcept {
+        return iterators_[lhs].key() < iterators_[rhs].key();
+    });
+
+    level.p = 0;
+    return search(level_ix);
+}
+
+void LeapfrogTriejoin::close_level(size_t const level_ix) noexcept {
+    for (auto const ix : levels_[level_ix].iterators) {
+        iterators_[ix].up();
+    }
+}
+
+bool LeapfrogTriejoin::next_at(size_t const level_ix) noexcept {
+    auto &level = levels_[level_ix];
+
+    auto &iter = iterators_[level.iterators[level.p]];
+    iter.next();
+    if (iter.at_end()) {
+        return false;
+    }
+
+    level.p = (level.p + 1) % level.iterators.size();
+    return search(level_ix);
+}
+
+bool LeapfrogTriejoin::next() noexcept {
+    if (done_) {
+        return false;
+    }
+
+    auto const n = levels_.size();
+
+    size_t level;
+    bool found;
+
+    if (!started_) {
+        started_ = true;
+
+        if (empty_) {
+            done_ = true;
+            return false;
+        }
+
+        if (n == 0) {
+            // no variables and all constant patterns match, which is exactly one (empty) solution
+            return true;
+        }
+
+        level = 0;
+        found = open_level(0);
+    } else {
+        if (n == 0) {
+            done_ = true;
+            return false;
+        }
+
+        level = n - 1;
+        found = next_at(level);
+    }
+
+    while (true) {
+        if (found) {
+            if (level + 1 == n) {
+                return true;
+            }
+
+            ++level;
+            found = open_level(level);
+        } else {
+            close_level(level);
+            if (level == 0) {
+                done_ = true;
+                return false;
+            }
+
+            --level;
+            found = next_at(level);
+        }
+    }
+}
+
+void LeapfrogTriejoin::restart() noexcept {
+    for (size_t ix = 0; ix < relations_.size(); ++ix) {
+        iterators_[ix] = TrieIterator{relations_[ix]};
+    }
+
+    started_ = false;
+    done_ = false;
+}
+
+LeapfrogTriejoin::id_type LeapfrogTriejoin::value(size_t const variable) const noexcept {
+    return levels_[level_of_[variable]].value;
+}
+
+std::vector<size_t> const &LeapfrogTriejoin::variable_order() const noexcept {
+    return order_;
+}
+
+JoinSolutionSequence::JoinSolutionSequence(std::shared_ptr<LeapfrogTriejoin> join, std::vector<Variable> variables, storage::DynNodeStoragePtr node_storage) noexcept
+    : join_{std::move(join)},
+      variables_{std::move(variables)},
+      node_storage_{node_storage} {
+}
+
+JoinSolutionSequence::iterator JoinSolutionSequence::begin() const noexcept {
+    join_->restart();
+    return iterator{join_, variables_, node_storage_};
+}
+
+JoinSolutionSequence::iterator::iterator(std::shared_ptr<LeapfrogTriejoin> join, std::vector<Variable> const &variables, storage::DynNodeStoragePtr node_storage) noexcept
+    : join_{std::move(join)},
+      node_storage_{node_storage},
+      cur_{variables} {
+    at_end_ = !join_->next();
+    if (!at_end_) {
+        fill_solution();
+    }
+}
+
+void JoinSolutionSequence::iterator::fill_solution() noexcept {
+    for (size_t ix = 0; ix < cur_.variable_count(); ++ix) {
+        cur_[ix] = Node{storage::identifier::NodeBackendHandle{join_->value(ix), node_storage_}};
+    }
+}
+
+JoinSolutionSequence::iterator &JoinSolutionSequence::iterator::operator++() noexcept {
+    at_end_ = !join_->next();
+    if (!at_end_) {
+        fill_solution();
+    }
+
+    return *this;
+}
+
+JoinSolutionSequence::iterator::reference JoinSolutionSequence::iterator::operator*() const noexcept {
+    return cur_;
+}
+
+JoinSolutionSequence::iterator::pointer JoinSolutionSequence::iterator::operator->() const noexcept {
+    return &cur_;
+}
+
+bool JoinSolutionSequence::iterator::operator==(sentinel) const noexcept {
+    return at_end_;
+}
+
+bool JoinSolutionSequence::iterator::operator!=(sentinel) const noexcept {
+    return !at_end_;
+}
+
+}  // namespace rdf4cpp::query
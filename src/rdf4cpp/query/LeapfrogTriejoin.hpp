@@ -0,0 +1,205 @@
+#ifndef RDF4CPP_LEAPFROGTRIEJOIN_HPP
+#define RDF4CPP_LEAPFROGTRIEJOIN_HPP
+
+#include <rdf4cpp/query/Solution.hpp>
+#include <rdf4cpp/query/Variable.hpp>
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace rdf4cpp::query {
+
+/**
+ * The input of a join for one pattern: the ids of all statements that match its constant positions,
+ * together with the join variable at each position.
+ */
+struct JoinAtom {
+    static constexpr size_t max_width = 4;
+    static constexpr size_t no_variable = std::numeric_limits<size_t>::max();
+
+    using row_type = std::array<storage::identifier::NodeBackendID, max_width>;
+
+    size_t width = 0; //< number of positions of the pattern, 3 for triples, 4 for quads
+
+    /**
+     * index of the join variable at each position, no_variable for constants
+     */
+    std::array<size_t, max_width> variables{no_variable, no_variable, no_variable, no_variable};
+
+    /**
+     * the matching statements, only the first width ids of each row are used
+     */
+    std::vector<row_type> rows;
+};
+
+/**
+ * @return the index of variable in variables, it is appended if it is not present yet
+ */
+size_t find_or_add_variable(std::vector<Variable> &variables, Variable const &variable);
+
+/**
+ * Worst-case optimal join of JoinAtoms on the id level, i.e. leapfrog triejoin (Veldhuizen, ICDT 2014).
+ *
+ * On construction, the variables are ordered by estimated cardinality: the variable with the fewest distinct values in any atom comes first,
+ * and each following variable is preferably one that shares an atom with the already chosen ones.
+ * Every atom is then projected onto its variables in that order and sorted, which turns it into a trie that is navigated by binary search.
+ * The solutions are enumerated one variable at a time: the candidates of a variable are the intersection of the matching trie levels
+ * of all atoms that contain it. Unlike pairwise joins, no intermediate result can be larger than the final result permits,
+ * which keeps cyclic queries (e.g. triangles) from exploding.
+ */
+struct LeapfrogTriejoin {
+private:
+    using id_type = storage::identifier::NodeBackendID;
+    using row_type = JoinAtom::row_type;
+
+    /**
+     * An atom projected onto its variables, sorted and without duplicates
+     */
+    struct Relation {
+        size_t arity = 0;
+        std::vector<row_type> rows;
+    };
+
+    /**
+     * Navigates a Relation as a trie, see the paper for the operations
+     */
+    struct TrieIterator {
+    private:
+        Relation const *relation_ = nullptr;
+        size_t depth_ = 0; //< number of opened levels, the current level is depth_ - 1
+        std::array<size_t, JoinAtom::max_width> begins_{};
+        std::array<size_t, JoinAtom::max_width> ends_{};
+        size_t pos_ = 0;
+
+        /**
+         * @return the first position in [pos_, ends_[depth_ - 1]) whose key is not less than key (strictly greater if strict is true)
+         */
+        [[nodiscard]] size_t gallop(id_type key, bool strict) const noexcept;
+
+    public:
+        TrieIterator() noexcept = default;
+        explicit TrieIterator(Relation const &relation) noexcept;
+
+        void open() noexcept;
+        void up() noexcept;
+        void next() noexcept;
+        void seek(id_type key) noexcept;
+
+        [[nodiscard]] id_type key() const noexcept;
+        [[nodiscard]] bool at_end() const noexcept;
+    };
+
+    struct Level {
+        std::vector<size_t> iterators; //< indices into iterators_ of the relations that contain the variable
+        size_t p = 0;                  //< the iterator that is advanced next
+        id_type value{};               //< the current value of the variable
+    };
+
+    std::vector<Relation> relations_;
+    std::vector<TrieIterator> iterators_;
+    std::vector<Level> levels_;    //< one per variable, in join order
+    std::vector<size_t> order_;    //< the variable of each level
+    std::vector<size_t> level_of_; //< the level of each variable
+    bool empty_ = false;           //< at least one atom has no rows
+    bool started_ = false;
+    bool done_ = false;
+
+    [[nodiscard]] bool open_level(size_t level) noexcept;
+    void close_level(size_t level) noexcept;
+    [[nodiscard]] bool next_at(size_t level) noexcept;
+    [[nodiscard]] bool search(size_t level) noexcept;
+
+public:
+    /**
+     * @param atoms the patterns to join
+     * @param variable_count number of distinct variables, each of them must occur in at least one atom
+     */
+    LeapfrogTriejoin(std::vector<JoinAtom> atoms, size_t variable_count);
+
+    /**
+     * Advances to the next solution, the first call yields the first one
+     * @return false if there are no more solutions
+     */
+    [[nodiscard]] bool next() noexcept;
+
+    /**
+     * Starts over, the next call of next yields the first solution again
+     */
+    void restart() noexcept;
+
+    /**
+     * @return the value of variable in the current solution
+     */
+    [[nodiscard]] id_type value(size_t variable) const noexcept;
+
+    /**
+     * @return the variables in join order, empty if the join has no solutions because an atom is empty
+     */
+    [[nodiscard]] std::vector<size_t> const &variable_order() const noexcept;
+};
+
+/**
+ * The solutions of a join (e.g. Graph::join), computed lazily by a LeapfrogTriejoin.
+ *
+ * As the join state is shared, only one iterator can be used at a time, calling begin starts over.
+ */
+struct JoinSolutionSequence {
+    using value_type = Solution;
+    using sentinel = std::default_sentinel_t;
+
+    struct iterator {
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Solution;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const *;
+        using reference = value_type const &;
+
+    private:
+        std::shared_ptr<LeapfrogTriejoin> join_;
+        storage::DynNodeStoragePtr node_storage_;
+        bool at_end_ = true;
+        value_type cur_;
+
+        void fill_solution() noexcept;
+
+    public:
+        iterator() noexcept = default;
+        iterator(std::shared_ptr<LeapfrogTriejoin> join, std::vector<Variable> const &variables, storage::DynNodeStoragePtr node_storage) noexcept;
+
+        iterator &operator++() noexcept;
+        reference operator*() const noexcept;
+        pointer operator->() const noexcept;
+
+        bool operator==(sentinel) const noexcept;
+        bool operator!=(sentinel) const noexcept;
+    };
+
+    using const_iterator = iterator;
+
+private:
+    std::shared_ptr<LeapfrogTriejoin> join_;
+    std::vector<Variable> variables_;
+    storage::DynNodeStoragePtr node_storage_;
+
+public:
+    /**
+     * @param join the join to enumerate
+     * @param variables the variables of the solutions, the i-th one is the variable with index i in the join
+     * @param node_storage the node storage of the ids in the join
+     */
+    JoinSolutionSequence(std::shared_ptr<LeapfrogTriejoin> join, std::vector<Variable> variables, storage::DynNodeStoragePtr node_storage) noexcept;
+
+    [[nodiscard]] iterator begin() const noexcept;
+    [[nodiscard]] static sentinel end() noexcept {
+        return sentinel{};
+    }
+};
+
+}  // namespace rdf4cpp::query
+
+#endif  //RDF4CPP_LEAPFROGTRIEJOIN_HPP
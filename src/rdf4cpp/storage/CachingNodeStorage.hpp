@@ -0,0 +1,237 @@
+#ifndef RDF4CPP_STORAGE_CACHINGNODESTORAGE_HPP
+#define RDF4CPP_STORAGE_CACHINGNODESTORAGE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+#include <rdf4cpp/storage/NodeStorage.hpp>
+
+namespace rdf4cpp::storage {
+
+namespace caching_node_storage_detail {
+
+/**
+ * Source of globally unique generations for CachingNodeStorage.
+ * Because no two caches ever share a generation, an entry can never be mistaken for one of another (possibly destroyed) cache.
+ */
+inline std::atomic<uint64_t> next_generation = 1;
+
+/**
+ * Thread-local, direct-mapped cache from IRI to NodeBackendID shared by all CachingNodeStorages.
+ */
+struct IRICache {
+    static constexpr size_t size = 256;           //< number of entries, must be a power of two
+    static constexpr size_t max_iri_size = 104;   //< longer IRIs are not cached
+
+    struct Entry {
+        uint64_t generation = 0; //< generation of the owning CachingNodeStorage when the entry was written, 0 if the entry is empty
+        size_t hash;
+        identifier::NodeBackendID id;
+        uint32_t iri_size;
+        std::array<char, max_iri_size> iri;
+    };
+
+    std::array<Entry, size> entries;
+
+    [[nodiscard]] Entry &slot(size_t const hash) noexcept {
+        return entries[hash & (size - 1)];
+    }
+
+    [[nodiscard]] static IRICache &local() noexcept {
+        static thread_local IRICache cache;
+        return cache;
+    }
+};
+
+} // namespace caching_node_storage_detail
+
+/**
+ * Wraps any NodeStorage and puts a small thread-local, direct-mapped cache in front of the IRI lookups of it.
+ * A hit returns the NodeBackendID without touching the wrapped storage (i.e. without hashing into its dictionary or taking its locks),
+ * which pays off when the same IRIs (e.g. predicates and datatype IRIs) are interned over and over again, e.g. by the parser.
+ * All other node types and all id to node lookups are forwarded unchanged.
+ *
+ * Every thread has one cache of caching_node_storage_detail::IRICache::size entries that is shared by all CachingNodeStorages,
+ * IRIs that are longer than caching_node_storage_detail::IRICache::max_iri_size bytes are never cached.
+ *
+ * Invalidation: erase_* and clear of this wrapper invalidate all cache entries of this wrapper (in all threads).
+ * If nodes are erased from the wrapped storage directly (e.g. by a NodeStorageCollector), invalidate must be called afterwards.
+ *
+ * @tparam NS the wrapped NodeStorage type
+ */
+template<NodeStorage NS>
+struct CachingNodeStorage {
+    using cache_type = caching_node_storage_detail::IRICache;
+
+private:
+    NS *inner_;
+    std::atomic<uint64_t> generation_;
+
+    [[nodiscard]] static uint64_t make_generation() noexcept {
+        return caching_node_storage_detail::next_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static size_t hash(view::IRIBackendView const &view) noexcept {
+        return std::hash<view::IRIBackendView>{}(view);
+    }
+
+    /**
+     * @return the cached id for view or the null-id if it is not cached
+     */
+    [[nodiscard]] identifier::NodeBackendID cache_lookup(view::IRIBackendView const &view, size_t const h, uint64_t const generation) const noexcept {
+        auto const &entry = cache_type::local().slot(h);
+        if (entry.generation == generation && entry.hash == h && entry.iri_size == view.identifier.size()
+            && std::memcmp(entry.iri.data(), view.identifier.data(), view.identifier.size()) == 0) {
+            return entry.id;
+        }
+
+        return identifier::NodeBackendID{};
+    }
+
+    /**
+     * Caches view -> id, generation must have been loaded before id was looked up in the wrapped storage
+     */
+    static void cache_insert(view::IRIBackendView const &view, size_t const h, uint64_t const generation, identifier::NodeBackendID const id) noexcept {
+        if (id.null() || view.identifier.size() > cache_type::max_iri_size) {
+            return;
+        }
+
+        auto &entry = cache_type::local().slot(h);
+        entry.generation = generation;
+        entry.hash = h;
+        entry.id = id;
+        entry.iri_size = static_cast<uint32_t>(view.identifier.size());
+        std::memcpy(entry.iri.data(), view.identifier.data(), view.identifier.size());
+    }
+
+public:
+    /**
+     * @param inner the wrapped storage, must outlive this wrapper
+     */
+    explicit CachingNodeStorage(NS &inner) noexcept : inner_{&inner},
+                                                      generation_{make_generation()} {
+    }
+
+    CachingNodeStorage(CachingNodeStorage const &) = delete;
+    CachingNodeStorage &operator=(CachingNodeStorage const &) = delete;
+
+    [[nodiscard]] NS &inner() const noexcept {
+        return *inner_;
+    }
+
+    /**
+     * Invalidates all cache entries of this wrapper in all threads.
+     * Must be called after nodes were erased from the wrapped storage without going through this wrapper.
+     */
+    void invalidate() noexcept {
+        // must happen after the erasure, otherwise a concurrent lookup could cache the erased node under the new generation
+        generation_.store(make_generation(), std::memory_order_release);
+    }
+
+    [[nodiscard]] bool has_specialized_storage_for(identifier::LiteralType const datatype) const noexcept {
+        return inner_->has_specialized_storage_for(datatype);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::IRIBackendView const &view) {
+        auto const h = hash(view);
+        auto const generation = generation_.load(std::memory_order_acquire);
+
+        if (auto const id = cache_lookup(view, h, generation); !id.null()) {
+            return id;
+        }
+
+        auto const id = inner_->find_or_make_id(view);
+        cache_insert(view, h, generation, id);
+        return id;
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view) {
+        return inner_->find_or_make_id(view);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::LiteralBackendView const &view) {
+        return inner_->find_or_make_id(view);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::VariableBackendView const &view) {
+        return inner_->find_or_make_id(view);
+    }
+
+    template<typename View>
+    void find_or_make_ids(std::span<View const> const views, std::span<identifier::NodeBackendID> const ids) {
+        storage::find_or_make_ids(*inner_, views, ids);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept {
+        auto const h = hash(view);
+        auto const generation = generation_.load(std::memory_order_acquire);
+
+        if (auto const id = cache_lookup(view, h, generation); !id.null()) {
+            return id;
+        }
+
+        // misses are not cached, the node might be created later
+        auto const id = inner_->find_id(view);
+        cache_insert(view, h, generation, id);
+        return id;
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::BNodeBackendView const &view) const noexcept {
+        return inner_->find_id(view);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::LiteralBackendView const &view) const noexcept {
+        return inner_->find_id(view);
+    }
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::VariableBackendView const &view) const noexcept {
+        return inner_->find_id(view);
+    }
+
+    [[nodiscard]] view::IRIBackendView find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+        return inner_->find_iri_backend(id);
+    }
+
+    [[nodiscard]] view::LiteralBackendView find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+        return inner_->find_literal_backend(id);
+    }
+
+    [[nodiscard]] view::BNodeBackendView find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+        return inner_->find_bnode_backend(id);
+    }
+
+    [[nodiscard]] view::VariableBackendView find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+        return inner_->find_variable_backend(id);
+    }
+
+    bool erase_iri(identifier::NodeBackendID const id) requires requires (NS &ns) { ns.erase_iri(id); } {
+        auto const erased = inner_->erase_iri(id);
+        invalidate();
+        return erased;
+    }
+
+    bool erase_literal(identifier::NodeBackendID const id) requires requires (NS &ns) { ns.erase_literal(id); } {
+        return inner_->erase_literal(id);
+    }
+
+    bool erase_bnode(identifier::NodeBackendID const id) requires requires (NS &ns) { ns.erase_bnode(id); } {
+        return inner_->erase_bnode(id);
+    }
+
+    bool erase_variable(identifier::NodeBackendID const id) requires requires (NS &ns) { ns.erase_variable(id); } {
+        return inner_->erase_variable(id);
+    }
+
+    void clear() requires requires (NS &ns) { ns.clear(); } {
+        inner_->clear();
+        invalidate();
+    }
+};
+
+} // namespace rdf4cpp::storage
+
+#endif // RDF4CPP_STORAGE_CACHINGNODESTORAGE_HPP
@@ -1,7 +1,9 @@
 #ifndef RDF4CPP_STORAGE_NODESTORAGEVTABLE_HPP
 #define RDF4CPP_STORAGE_NODESTORAGEVTABLE_HPP
 
+#include <cassert>
 #include <concepts>
+#include <span>
 
 #include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
 #include <rdf4cpp/storage/view/BNodeBackendView.hpp>
@@ -112,6 +114,45 @@ concept NodeStorage = requires (NS ns_mut,
     { ns.find_variable_backend(node_id) } -> std::convertible_to<view::VariableBackendView>;
 };
 
+/**
+ * Optional batch interface of a NodeStorage.
+ * A NodeStorage may provide
+ *      void find_or_make_ids(std::span<View const> views, std::span<identifier::NodeBackendID> ids)
+ * for any of the backend view types, which is semantically equivalent to calling find_or_make_id for each view
+ * and writing the results to the corresponding positions in ids (i.e. views.size() == ids.size()).
+ * This allows implementations to amortize the costs of synchronization and hashing over the whole batch.
+ *
+ * @tparam NS NodeStorage type
+ * @tparam View one of view::BNodeBackendView, view::IRIBackendView, view::LiteralBackendView or view::VariableBackendView
+ */
+template<typename NS, typename View>
+concept NodeStorageWithBatchFindOrMakeId = NodeStorage<NS> && requires (NS ns_mut,
+                                                                        std::span<View const> views,
+                                                                        std::span<identifier::NodeBackendID> ids) {
+    { ns_mut.find_or_make_ids(views, ids) } -> std::same_as<void>;
+};
+
+/**
+ * Batch version of ns.find_or_make_id(view).
+ * Uses the batch interface of ns if it provides one, otherwise falls back to calling find_or_make_id for each view.
+ *
+ * @param ns node storage to intern the views in
+ * @param views views of the nodes to intern
+ * @param ids output, ids[ix] is set to the id of views[ix], must have the same size as views
+ */
+template<NodeStorage NS, typename View>
+void find_or_make_ids(NS &ns, std::span<View const> const views, std::span<identifier::NodeBackendID> const ids) {
+    assert(views.size() == ids.size());
+
+    if constexpr (NodeStorageWithBatchFindOrMakeId<NS, View>) {
+        ns.find_or_make_ids(views, ids);
+    } else {
+        for (size_t ix = 0; ix < views.size(); ++ix) {
+            ids[ix] = ns.find_or_make_id(views[ix]);
+        }
+    }
+}
+
 /**
  * A VTable for a NodeStorage
  */
@@ -123,6 +164,11 @@ struct NodeStorageVTable {
     identifier::NodeBackendID (*find_or_make_literal_id)(void *self, view::LiteralBackendView const &view);
     identifier::NodeBackendID (*find_or_make_variable_id)(void *self, view::VariableBackendView const &view);
 
+    void (*find_or_make_iri_ids)(void *self, std::span<view::IRIBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void (*find_or_make_bnode_ids)(void *self, std::span<view::BNodeBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void (*find_or_make_literal_ids)(void *self, std::span<view::LiteralBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void (*find_or_make_variable_ids)(void *self, std::span<view::VariableBackendView const> views, std::span<identifier::NodeBackendID> ids);
+
     identifier::NodeBackendID (*find_iri_id)(void const *self, view::IRIBackendView const &view) noexcept;
     identifier::NodeBackendID (*find_bnode_id)(void const *self, view::BNodeBackendView const &view) noexcept;
     identifier::NodeBackendID (*find_literal_id)(void const *self, view::LiteralBackendView const &view) noexcept;
@@ -151,6 +197,18 @@ struct NodeStorageVTable {
             .find_or_make_variable_id = [](void *self, view::VariableBackendView const &view) -> identifier::NodeBackendID {
                 return static_cast<NS *>(self)->find_or_make_id(view);
             },
+            .find_or_make_iri_ids = [](void *self, std::span<view::IRIBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+                storage::find_or_make_ids(*static_cast<NS *>(self), views, ids);
+            },
+            .find_or_make_bnode_ids = [](void *self, std::span<view::BNodeBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+                storage::find_or_make_ids(*static_cast<NS *>(self), views, ids);
+            },
+            .find_or_make_literal_ids = [](void *self, std::span<view::LiteralBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+                storage::find_or_make_ids(*static_cast<NS *>(self), views, ids);
+            },
+            .find_or_make_variable_ids = [](void *self, std::span<view::VariableBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+                storage::find_or_make_ids(*static_cast<NS *>(self), views, ids);
+            },
             .find_iri_id = [](void const *self, view::IRIBackendView const &view) noexcept -> identifier::NodeBackendID {
                 return static_cast<NS const *>(self)->find_id(view);
             },
@@ -247,6 +305,22 @@ public:
         return vtable_->find_or_make_variable_id(backend_, view);
     }
 
+    void find_or_make_ids(std::span<view::IRIBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+        vtable_->find_or_make_iri_ids(backend_, views, ids);
+    }
+
+    void find_or_make_ids(std::span<view::BNodeBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+        vtable_->find_or_make_bnode_ids(backend_, views, ids);
+    }
+
+    void find_or_make_ids(std::span<view::LiteralBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+        vtable_->find_or_make_literal_ids(backend_, views, ids);
+    }
+
+    void find_or_make_ids(std::span<view::VariableBackendView const> views, std::span<identifier::NodeBackendID> ids) {
+        vtable_->find_or_make_variable_ids(backend_, views, ids);
+    }
+
     [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept {
         return vtable_->find_iri_id(backend_, view);
     }
@@ -289,6 +363,10 @@ public:
 };
 
 static_assert(NodeStorage<DynNodeStoragePtr>);
+static_assert(NodeStorageWithBatchFindOrMakeId<DynNodeStoragePtr, view::IRIBackendView>);
+static_assert(NodeStorageWithBatchFindOrMakeId<DynNodeStoragePtr, view::BNodeBackendView>);
+static_assert(NodeStorageWithBatchFindOrMakeId<DynNodeStoragePtr, view::LiteralBackendView>);
+static_assert(NodeStorageWithBatchFindOrMakeId<DynNodeStoragePtr, view::VariableBackendView>);
 
 /**
  * Pointer to the default node-storage instance. By default it points to rdf4cpp::storage::reference_node_storage::default_instance.
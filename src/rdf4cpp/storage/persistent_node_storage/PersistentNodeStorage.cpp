@@ -0,0 +1,285 @@
+#include "PersistentNodeStorage.hpp"
+
+#include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/datatypes/registry/DatatypeRegistry.hpp>
+#include <rdf4cpp/datatypes/xsd.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+#include <rdf4cpp/writer/BufWriter.hpp>
+
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace rdf4cpp::storage::persistent_node_storage {
+
+/**
+ * Datatypes that are stored in specialized_literal_storage_, the same as for the reference node storages.
+ */
+using reference_node_storage::specialization_detail::specialized_datatypes;
+
+static std::filesystem::path const &prepare_directory(std::filesystem::path const &directory) {
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+PersistentNodeStorage::PersistentNodeStorage(std::filesystem::path const &directory, size_t const max_file_size)
+    : bnode_storage_{prepare_directory(directory), "bnode", max_file_size},
+      iri_storage_{directory, "iri", max_file_size},
+      variable_storage_{directory, "variable", max_file_size},
+      fallback_literal_storage_{directory, "fallback_literal", max_file_size},
+      specialized_literal_storage_{directory, "specialized_literal", max_file_size} {
+
+    if (iri_storage_.mapping.id_space_size() == 0) {
+        // freshly created storage
+        iri_storage_.mapping.reserve_until(identifier::NodeID::min_iri_id);
+        bnode_storage_.mapping.reserve_until(identifier::NodeID::min_bnode_id);
+        variable_storage_.mapping.reserve_until(identifier::NodeID::min_variable_id);
+        fallback_literal_storage_.mapping.reserve_until(identifier::NodeID::min_literal_id);
+        specialized_literal_storage_.mapping.reserve_until(identifier::NodeID::min_literal_id);
+
+        // some iri's like xsd:string are there by default
+        for (auto const &[iri, literal_type] : datatypes::registry::reserved_datatype_ids) {
+            auto const id = literal_type.to_underlying();
+            iri_storage_.mapping.insert_assume_not_present_at(view::IRIBackendView{.identifier = iri}, identifier::NodeID{id});
+        }
+    } else {
+        for (auto const &[iri, literal_type] : datatypes::registry::reserved_datatype_ids) {
+            auto const stored = iri_storage_.mapping.lookup_value(identifier::NodeID{literal_type.to_underlying()});
+            if (!stored.has_value() || stored->identifier != iri) {
+                throw std::runtime_error{"reserved datatype ids of the persistent node storage at " + directory.string() + " do not match"};
+            }
+        }
+    }
+}
+
+size_t PersistentNodeStorage::size() const noexcept {
+    auto const storage_size = []<typename Record>(PersistentNodeTypeStorage<Record> const &storage) noexcept {
+        std::shared_lock lock{storage.mutex};
+        return storage.mapping.size();
+    };
+
+    return storage_size(iri_storage_) +
+           storage_size(bnode_storage_) +
+           storage_size(variable_storage_) +
+           storage_size(fallback_literal_storage_) +
+           storage_size(specialized_literal_storage_);
+}
+
+void PersistentNodeStorage::sync() const {
+    auto const storage_sync = []<typename Record>(PersistentNodeTypeStorage<Record> const &storage) {
+        std::shared_lock lock{storage.mutex};
+        storage.mapping.sync();
+    };
+
+    storage_sync(iri_storage_);
+    storage_sync(bnode_storage_);
+    storage_sync(variable_storage_);
+    storage_sync(fallback_literal_storage_);
+    storage_sync(specialized_literal_storage_);
+}
+
+bool PersistentNodeStorage::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
+    static constexpr auto specialization_lut = []() {
+        std::array<bool, 1 << identifier::LiteralType::width> ret{};
+        dice::template_library::tuple_type_for_each<specialized_datatypes>([&]<typename T>() {
+            ret[T::fixed_id.to_underlying()] = true;
+        });
+        return ret;
+    }();
+
+    return specialization_lut[datatype.to_underlying()];
+}
+
+/**
+ * Serializes the value of a literal with specialized storage into its canonical lexical form,
+ * which is the representation in specialized_literal_storage_.
+ */
+static std::string to_canonical_string(view::ValueLiteralBackendView const &value) {
+    auto const serialize = datatypes::registry::DatatypeRegistry::get_serialize_canonical_string(datatypes::registry::DatatypeIDView{value.datatype});
+    assert(serialize != nullptr);
+
+    return writer::StringWriter::oneshot([&](writer::StringWriter &w) noexcept {
+        return serialize(value.value, w);
+    });
+}
+
+static view::LexicalFormLiteralBackendView make_specialized_view(identifier::LiteralType const datatype, std::string_view const canonical) noexcept {
+    return view::LexicalFormLiteralBackendView{.datatype_id = identifier::literal_type_to_iri_node_id(datatype),
+                                               .lexical_form = canonical,
+                                               .language_tag = "",
+                                               .needs_escape = false};
+}
+
+/**
+ * Synchronized lookup (and creation) of IDs by a provided view of a Node Backend.
+ * @tparam create_if_not_present enables code for creating non-existing Node Backends
+ * @param view contains the data of the requested Node Backend
+ * @param storage the storage where the Node Backend is looked up
+ * @return the NodeID for the looked up Node Backend. Result is the null-id if there was no matching Node Backend.
+ */
+template<bool create_if_not_present, typename Storage>
+static identifier::NodeBackendID lookup_or_insert_impl(typename Storage::backend_view_type const &view,
+                                                       Storage &storage) noexcept(!create_if_not_present) {
+    {
+        std::shared_lock lock{storage.mutex};
+        if (auto const id = storage.mapping.lookup_id(view); id != typename Storage::backend_id_type{}) {
+            return Storage::from_storage_id(id, view);
+        }
+    }
+
+    if constexpr (!create_if_not_present) {
+        return identifier::NodeBackendID{};
+    } else {
+        std::unique_lock lock{storage.mutex};
+
+        // check again, might have changed between unlocking of shared_lock and locking of unique_lock
+        if (auto const id = storage.mapping.lookup_id(view); id != typename Storage::backend_id_type{}) {
+            return Storage::from_storage_id(id, view);
+        }
+
+        auto const id = storage.mapping.insert_assume_not_present(view);
+        return Storage::from_storage_id(id, view);
+    }
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_or_make_id(view::LiteralBackendView const &view) {
+    return view.visit(
+            [this](view::LexicalFormLiteralBackendView const &lexical) {
+                assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
+                return lookup_or_insert_impl<true>(lexical, this->fallback_literal_storage_);
+            },
+            [this](view::ValueLiteralBackendView const &any) {
+                assert(has_specialized_storage_for(any.datatype));
+                auto const canonical = to_canonical_string(any);
+                return lookup_or_insert_impl<true>(make_specialized_view(any.datatype, canonical), this->specialized_literal_storage_);
+            });
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_or_make_id(view::IRIBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, iri_storage_);
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_or_make_id(view::BNodeBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, bnode_storage_);
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_or_make_id(view::VariableBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, variable_storage_);
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_id(view::BNodeBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, bnode_storage_);
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_id(view::IRIBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, iri_storage_);
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_id(view::LiteralBackendView const &view) const noexcept {
+    return view.visit(
+            [this](view::LexicalFormLiteralBackendView const &lexical) noexcept {
+                assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
+                return lookup_or_insert_impl<false>(lexical, this->fallback_literal_storage_);
+            },
+            [this](view::ValueLiteralBackendView const &any) noexcept {
+                assert(has_specialized_storage_for(any.datatype));
+
+                std::string canonical;
+                try {
+                    canonical = to_canonical_string(any);
+                } catch (std::bad_alloc const &) {
+                    // the key cannot be built, so it cannot be looked up either
+                    return identifier::NodeBackendID{};
+                }
+
+                return lookup_or_insert_impl<false>(make_specialized_view(any.datatype, canonical), this->specialized_literal_storage_);
+            });
+}
+
+identifier::NodeBackendID PersistentNodeStorage::find_id(view::VariableBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, variable_storage_);
+}
+
+template<typename Storage>
+static typename Storage::backend_view_type find_backend_view(Storage &storage, identifier::NodeBackendID const id) noexcept {
+    std::shared_lock<std::shared_mutex> shared_lock{storage.mutex};
+
+    if (auto view = storage.mapping.lookup_value(Storage::to_storage_id(id)); view.has_value()) {
+        return *view;
+    } else {
+        assert(false); // assert in debug build; not critical error but should not happen
+        return Storage::get_default_view();
+    }
+}
+
+view::IRIBackendView PersistentNodeStorage::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+    return find_backend_view(iri_storage_, id);
+}
+
+view::LiteralBackendView PersistentNodeStorage::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+    auto const datatype = id.node_id().literal_type();
+
+    if (datatype.is_fixed() && has_specialized_storage_for(datatype)) {
+        auto const canonical = find_backend_view(specialized_literal_storage_, id);
+        auto const factory = datatypes::registry::DatatypeRegistry::get_factory(datatypes::registry::DatatypeIDView{datatype});
+        assert(factory != nullptr);
+
+        try {
+            return view::ValueLiteralBackendView{.datatype = datatype,
+                                                 .value = factory(canonical.lexical_form)};
+        } catch (...) {
+            // the value is re-parsed on every access, which allocates; a corrupt file could also make parsing fail
+            return decltype(fallback_literal_storage_)::get_default_view();
+        }
+    }
+
+    return find_backend_view(fallback_literal_storage_, id);
+}
+
+view::BNodeBackendView PersistentNodeStorage::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+    return find_backend_view(bnode_storage_, id);
+}
+
+view::VariableBackendView PersistentNodeStorage::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+    return find_backend_view(variable_storage_, id);
+}
+
+template<typename Storage>
+static bool erase_impl(Storage &storage, identifier::NodeBackendID const id) {
+    std::unique_lock lock{storage.mutex};
+
+    auto const backend_id = Storage::to_storage_id(id);
+    if (!storage.mapping.lookup_value(backend_id).has_value()) {
+        return false;
+    }
+
+    storage.mapping.erase_assume_present(backend_id);
+    return true;
+}
+
+bool PersistentNodeStorage::erase_iri(identifier::NodeBackendID const id) {
+    // check predefined IRIs
+    if (identifier::iri_node_id_to_literal_type(id).is_fixed()) {
+        return false;
+    }
+
+    return erase_impl(iri_storage_, id);
+}
+
+bool PersistentNodeStorage::erase_literal(identifier::NodeBackendID const id) {
+    if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
+        return erase_impl(specialized_literal_storage_, id);
+    }
+
+    return erase_impl(fallback_literal_storage_, id);
+}
+
+bool PersistentNodeStorage::erase_bnode(identifier::NodeBackendID const id) {
+    return erase_impl(bnode_storage_, id);
+}
+
+bool PersistentNodeStorage::erase_variable(identifier::NodeBackendID const id) {
+    return erase_impl(variable_storage_, id);
+}
+
+}  // namespace rdf4cpp::storage::persistent_node_storage
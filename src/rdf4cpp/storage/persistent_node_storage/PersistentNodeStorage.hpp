@@ -0,0 +1,91 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_HPP
+
+#include <filesystem>
+
+#include <rdf4cpp/storage/NodeStorage.hpp>
+#include <rdf4cpp/storage/persistent_node_storage/Records.hpp>
+#include <rdf4cpp/storage/persistent_node_storage/detail/PersistentNodeTypeStorage.hpp>
+
+namespace rdf4cpp::storage::persistent_node_storage {
+
+/**
+ * Thread-safe NodeStorage that keeps all of its dictionaries in memory-mapped files inside a directory.
+ *
+ * Opening an existing directory is O(1): nothing is parsed or re-interned, and all NodeBackendIDs handed out in previous runs stay valid.
+ * The on-disk layout is versioned with rdf4cpp::pobr_version, opening files written with a different version throws.
+ *
+ * Literals with specialized storage are stored in their canonical lexical form and are converted to their value on access.
+ * Erased nodes leave holes, their ids are never handed out again and their string data is not reclaimed.
+ *
+ * Changes reach the files through the page cache, call sync() to make sure they survive an operating system crash.
+ * There is no crash consistency: the files are not written in any particular order and nothing is flushed (msync) between updates,
+ * so if the process or the operating system crashes while nodes are being inserted or erased, the directory may be left corrupt.
+ * Only a directory that was sync()ed after its last change and closed cleanly is guaranteed to be consistent.
+ * A directory can only be opened by one PersistentNodeStorage at a time.
+ */
+struct PersistentNodeStorage {
+    /**
+     * Number of files of a PersistentNodeStorage, each of them reserves max_file_size bytes of virtual memory.
+     */
+    static constexpr size_t file_count = 15;
+
+    /**
+     * Default for the maximum size of each file (16 GiB). This is the amount of virtual memory reserved per file, not the amount of memory or disk space used.
+     * Pass a larger max_file_size to the constructor for bigger datasets; the whole storage reserves file_count * max_file_size bytes of address space.
+     */
+    static constexpr size_t default_max_file_size = size_t{1} << 34;
+
+private:
+    PersistentNodeTypeStorage<BNodeRecord> bnode_storage_;
+    PersistentNodeTypeStorage<IRIRecord> iri_storage_;
+    PersistentNodeTypeStorage<VariableRecord> variable_storage_;
+
+    PersistentNodeTypeStorage<LiteralRecord> fallback_literal_storage_;
+    PersistentNodeTypeStorage<LiteralRecord> specialized_literal_storage_; //< stores literals with specialized storage in canonical form
+
+public:
+    /**
+     * Opens the storage in the given directory, creates the directory and storage if they do not exist yet.
+     *
+     * @param directory directory containing the files of this storage
+     * @param max_file_size maximum size of each file of this storage
+     * @throws std::system_error if the files cannot be created, opened or mapped
+     * @throws std::runtime_error if the files are not a PersistentNodeStorage or were written with an incompatible pobr_version
+     */
+    explicit PersistentNodeStorage(std::filesystem::path const &directory, size_t max_file_size = default_max_file_size);
+
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * Flushes all changes to disk.
+     */
+    void sync() const;
+
+    [[nodiscard]] static bool has_specialized_storage_for(identifier::LiteralType datatype) noexcept;
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::IRIBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::LiteralBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::VariableBackendView const &view);
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::BNodeBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::LiteralBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::VariableBackendView const &view) const noexcept;
+
+    [[nodiscard]] view::IRIBackendView find_iri_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::LiteralBackendView find_literal_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::BNodeBackendView find_bnode_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::VariableBackendView find_variable_backend(identifier::NodeBackendID id) const noexcept;
+
+    bool erase_iri(identifier::NodeBackendID id);
+    bool erase_literal(identifier::NodeBackendID id);
+    bool erase_bnode(identifier::NodeBackendID id);
+    bool erase_variable(identifier::NodeBackendID id);
+};
+static_assert(NodeStorage<PersistentNodeStorage>);
+
+}  // namespace rdf4cpp::storage::persistent_node_storage
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_HPP
@@ -0,0 +1,147 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_RECORDS_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_RECORDS_HPP
+
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+#include <rdf4cpp/storage/persistent_node_storage/detail/StringHeap.hpp>
+#include <rdf4cpp/storage/view/BNodeBackendView.hpp>
+#include <rdf4cpp/storage/view/IRIBackendView.hpp>
+#include <rdf4cpp/storage/view/LiteralBackendView.hpp>
+#include <rdf4cpp/storage/view/VariableBackendView.hpp>
+
+/**
+ * On-disk records of the PersistentNodeStorage.
+ * Records are trivially copyable and only refer to string data via offsets into a detail::StringHeap.
+ * Changing any of the records requires bumping POBR_VERSION.
+ */
+namespace rdf4cpp::storage::persistent_node_storage {
+
+struct IRIRecord {
+    using view_type = view::IRIBackendView;
+    using id_type = identifier::NodeID;
+
+    static constexpr std::array<char, 8> magic{'r', '4', 'c', 'i', 'r', 'i', '\0', '\0'};
+
+    detail::HeapString identifier;
+
+    IRIRecord(view_type const &view, detail::StringHeap &heap) : identifier{heap.append(view.identifier)} {
+    }
+
+    [[nodiscard]] view_type to_view(detail::StringHeap const &heap) const noexcept {
+        return view_type{.identifier = heap.get(identifier)};
+    }
+
+    static identifier::NodeBackendID from_storage_id(id_type const id, [[maybe_unused]] view_type const &view) noexcept {
+        return identifier::NodeBackendID{id, identifier::RDFNodeType::IRI};
+    }
+
+    static id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return id.node_id();
+    }
+
+    static view_type get_default_view() noexcept {
+        return view_type{};
+    }
+};
+
+struct BNodeRecord {
+    using view_type = view::BNodeBackendView;
+    using id_type = identifier::NodeID;
+
+    static constexpr std::array<char, 8> magic{'r', '4', 'c', 'b', 'n', 'o', 'd', 'e'};
+
+    detail::HeapString identifier;
+
+    BNodeRecord(view_type const &view, detail::StringHeap &heap) : identifier{heap.append(view.identifier)} {
+    }
+
+    [[nodiscard]] view_type to_view(detail::StringHeap const &heap) const noexcept {
+        return view_type{.identifier = heap.get(identifier)};
+    }
+
+    static identifier::NodeBackendID from_storage_id(id_type const id, [[maybe_unused]] view_type const &view) noexcept {
+        return identifier::NodeBackendID{id, identifier::RDFNodeType::BNode};
+    }
+
+    static id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return id.node_id();
+    }
+
+    static view_type get_default_view() noexcept {
+        return view_type{};
+    }
+};
+
+struct VariableRecord {
+    using view_type = view::VariableBackendView;
+    using id_type = identifier::NodeID;
+
+    static constexpr std::array<char, 8> magic{'r', '4', 'c', 'v', 'a', 'r', '\0', '\0'};
+
+    detail::HeapString name;
+    bool is_anonymous;
+
+    VariableRecord(view_type const &view, detail::StringHeap &heap) : name{heap.append(view.name)},
+                                                                      is_anonymous{view.is_anonymous} {
+    }
+
+    [[nodiscard]] view_type to_view(detail::StringHeap const &heap) const noexcept {
+        return view_type{.name = heap.get(name), .is_anonymous = is_anonymous};
+    }
+
+    static identifier::NodeBackendID from_storage_id(id_type const id, [[maybe_unused]] view_type const &view) noexcept {
+        return identifier::NodeBackendID{id, identifier::RDFNodeType::Variable};
+    }
+
+    static id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return id.node_id();
+    }
+
+    static view_type get_default_view() noexcept {
+        return view_type{.name = "", .is_anonymous = false};
+    }
+};
+
+/**
+ * Record for literals in lexical form.
+ * Used for both fallback literals and specialized literals. The latter are stored in their canonical lexical form.
+ */
+struct LiteralRecord {
+    using view_type = view::LexicalFormLiteralBackendView;
+    using id_type = identifier::LiteralID;
+
+    static constexpr std::array<char, 8> magic{'r', '4', 'c', 'l', 'i', 't', '\0', '\0'};
+
+    identifier::NodeBackendID datatype_id;
+    detail::HeapString lexical_form;
+    detail::HeapString language_tag;
+    bool needs_escape;
+
+    LiteralRecord(view_type const &view, detail::StringHeap &heap) : datatype_id{view.datatype_id},
+                                                                     lexical_form{heap.append(view.lexical_form)},
+                                                                     language_tag{heap.append(view.language_tag)},
+                                                                     needs_escape{view.needs_escape} {
+    }
+
+    [[nodiscard]] view_type to_view(detail::StringHeap const &heap) const noexcept {
+        return view_type{.datatype_id = datatype_id,
+                         .lexical_form = heap.get(lexical_form),
+                         .language_tag = heap.get(language_tag),
+                         .needs_escape = needs_escape};
+    }
+
+    static identifier::NodeBackendID from_storage_id(id_type const id, view_type const &view) noexcept {
+        return identifier::NodeBackendID{identifier::NodeID{id, iri_node_id_to_literal_type(view.datatype_id)}, identifier::RDFNodeType::Literal};
+    }
+
+    static id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return id.node_id().literal_id();
+    }
+
+    static view_type get_default_view() noexcept {
+        return view_type{.datatype_id = identifier::NodeBackendID::xsd_string_iri.first, .lexical_form = "", .language_tag = "", .needs_escape = false};
+    }
+};
+
+}  // namespace rdf4cpp::storage::persistent_node_storage
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_RECORDS_HPP
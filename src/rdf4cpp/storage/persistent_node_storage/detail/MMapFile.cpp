@@ -0,0 +1,148 @@
+#include "MMapFile.hpp"
+
+#include <rdf4cpp/version.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace rdf4cpp::storage::persistent_node_storage::detail {
+
+static constexpr size_t initial_file_size = 1 << 16;
+
+[[noreturn]] static void throw_errno(std::string const &what, std::filesystem::path const &path) {
+    throw std::system_error{errno, std::generic_category(), what + " " + path.string()};
+}
+
+MMapFile::MMapFile(std::filesystem::path path, std::array<char, 8> const &magic, size_t const element_size, size_t const max_size)
+    : path_{std::move(path)},
+      max_size_{max_size} {
+
+    fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw_errno("unable to open", path_);
+    }
+
+    try {
+        if (::flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+            throw_errno("unable to lock (is it opened by another storage?)", path_);
+        }
+
+        struct stat st{};
+        if (::fstat(fd_, &st) != 0) {
+            throw_errno("unable to stat", path_);
+        }
+
+        file_size_ = static_cast<size_t>(st.st_size);
+        bool const created = file_size_ == 0;
+
+        if (created) {
+            file_size_ = std::min(initial_file_size, max_size_);
+            if (::ftruncate(fd_, static_cast<off_t>(file_size_)) != 0) {
+                throw_errno("unable to resize", path_);
+            }
+        }
+
+        if (file_size_ < sizeof(MMapFileHeader) || file_size_ > max_size_) {
+            throw std::runtime_error{"invalid size of " + path_.string()};
+        }
+
+        void *const addr = ::mmap(nullptr, max_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, fd_, 0);
+        if (addr == MAP_FAILED) {
+            throw_errno("unable to map", path_);
+        }
+        data_ = static_cast<std::byte *>(addr);
+
+        if (created) {
+            header() = MMapFileHeader{.magic = magic,
+                                      .pobr_version = static_cast<uint64_t>(pobr_version),
+                                      .element_size = element_size,
+                                      .size = 0,
+                                      .count = 0};
+        } else if (header().magic != magic) {
+            throw std::runtime_error{"unexpected file type of " + path_.string()};
+        } else if (header().pobr_version != static_cast<uint64_t>(pobr_version)) {
+            throw std::runtime_error{"incompatible binary representation version (pobr_version " + std::to_string(header().pobr_version)
+                                     + ", expected " + std::to_string(pobr_version) + ") of " + path_.string()};
+        } else if (header().element_size != element_size) {
+            throw std::runtime_error{"incompatible element layout of " + path_.string()};
+        }
+    } catch (...) {
+        if (data_ != nullptr) {
+            ::munmap(data_, max_size_);
+        }
+        ::close(fd_);
+        throw;
+    }
+}
+
+MMapFile::~MMapFile() {
+    if (data_ != nullptr) {
+        ::munmap(data_, max_size_);
+    }
+
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+MMapFile::MMapFile(MMapFile &&other) noexcept : path_{std::move(other.path_)},
+                                                fd_{std::exchange(other.fd_, -1)},
+                                                data_{std::exchange(other.data_, nullptr)},
+                                                file_size_{std::exchange(other.file_size_, 0)},
+                                                max_size_{std::exchange(other.max_size_, 0)} {
+}
+
+MMapFile &MMapFile::operator=(MMapFile &&other) noexcept {
+    // other releases the previous resources of this on destruction
+    std::swap(path_, other.path_);
+    std::swap(fd_, other.fd_);
+    std::swap(data_, other.data_);
+    std::swap(file_size_, other.file_size_);
+    std::swap(max_size_, other.max_size_);
+    return *this;
+}
+
+void MMapFile::reserve_payload(size_t const min_payload_size) {
+    auto const min_file_size = min_payload_size + sizeof(MMapFileHeader);
+    if (min_file_size <= file_size_) {
+        return;
+    }
+
+    if (min_file_size > max_size_) {
+        throw std::length_error{"maximum size exceeded for " + path_.string()};
+    }
+
+    auto const page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    auto new_file_size = std::max(min_file_size, file_size_ * 2);
+    new_file_size = std::min((new_file_size + page_size - 1) / page_size * page_size, max_size_);
+
+    if (::ftruncate(fd_, static_cast<off_t>(new_file_size)) != 0) {
+        throw_errno("unable to resize", path_);
+    }
+
+    file_size_ = new_file_size;
+}
+
+void MMapFile::rename(std::filesystem::path new_path) {
+    std::filesystem::rename(path_, new_path);
+    path_ = std::move(new_path);
+}
+
+void MMapFile::sync() const {
+    if (::msync(data_, file_size_, MS_SYNC) != 0) {
+        throw_errno("unable to sync", path_);
+    }
+}
+
+}  // namespace rdf4cpp::storage::persistent_node_storage::detail
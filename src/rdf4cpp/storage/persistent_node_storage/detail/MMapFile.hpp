@@ -0,0 +1,109 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_MMAPFILE_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_MMAPFILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace rdf4cpp::storage::persistent_node_storage::detail {
+
+/**
+ * Header at the beginning of every file managed by MMapFile.
+ * The meaning of size and count is defined by the user of the file.
+ */
+struct alignas(64) MMapFileHeader {
+    std::array<char, 8> magic;
+    uint64_t pobr_version; //< rdf4cpp::pobr_version of the writer of the file
+    uint64_t element_size; //< sizeof of the elements stored in the file, guards against layout changes
+    uint64_t size;
+    uint64_t count;
+};
+
+/**
+ * A file that is memory-mapped into a fixed, reserved region of virtual memory.
+ * The file can grow up to max_size without ever being remapped, therefore pointers into the file stay valid for the whole lifetime of the MMapFile.
+ *
+ * Every file starts with a MMapFileHeader, which is validated when an existing file is opened.
+ * Only a single MMapFile may have a file opened at any given time (enforced via an advisory lock).
+ */
+struct MMapFile {
+private:
+    std::filesystem::path path_;
+    int fd_ = -1;
+    std::byte *data_ = nullptr;
+    size_t file_size_ = 0;
+    size_t max_size_ = 0;
+
+public:
+    /**
+     * Opens the file at path or creates it if it does not exist.
+     *
+     * @param path path to the file
+     * @param magic magic identifying the kind of file
+     * @param element_size size of the elements stored in the file
+     * @param max_size maximum size the file can grow to, this is the amount of virtual memory reserved for the mapping
+     * @throws std::system_error if the file cannot be opened, locked or mapped
+     * @throws std::runtime_error if the file exists but its header does not match magic, element_size or rdf4cpp::pobr_version
+     */
+    MMapFile(std::filesystem::path path, std::array<char, 8> const &magic, size_t element_size, size_t max_size);
+    ~MMapFile();
+
+    MMapFile(MMapFile const &) = delete;
+    MMapFile(MMapFile &&other) noexcept;
+    MMapFile &operator=(MMapFile const &) = delete;
+    MMapFile &operator=(MMapFile &&other) noexcept;
+
+    [[nodiscard]] std::filesystem::path const &path() const noexcept {
+        return path_;
+    }
+
+    [[nodiscard]] MMapFileHeader &header() noexcept {
+        return *reinterpret_cast<MMapFileHeader *>(data_);
+    }
+
+    [[nodiscard]] MMapFileHeader const &header() const noexcept {
+        return *reinterpret_cast<MMapFileHeader const *>(data_);
+    }
+
+    /**
+     * @return pointer to the first byte after the header
+     */
+    [[nodiscard]] std::byte *payload() noexcept {
+        return data_ + sizeof(MMapFileHeader);
+    }
+
+    [[nodiscard]] std::byte const *payload() const noexcept {
+        return data_ + sizeof(MMapFileHeader);
+    }
+
+    /**
+     * @return number of usable payload bytes, i.e. file size without header
+     */
+    [[nodiscard]] size_t payload_capacity() const noexcept {
+        return file_size_ - sizeof(MMapFileHeader);
+    }
+
+    /**
+     * Makes sure that at least min_payload_size bytes of payload are backed by the file.
+     * Grows the file geometrically if necessary. Existing pointers into the file stay valid.
+     *
+     * @throws std::length_error if the file would exceed its max_size
+     * @throws std::system_error if the file cannot be resized
+     */
+    void reserve_payload(size_t min_payload_size);
+
+    /**
+     * Atomically moves the file to new_path, replacing any file at new_path.
+     */
+    void rename(std::filesystem::path new_path);
+
+    /**
+     * Flushes all changes to disk.
+     */
+    void sync() const;
+};
+
+}  // namespace rdf4cpp::storage::persistent_node_storage::detail
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_MMAPFILE_HPP
@@ -0,0 +1,304 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTDICTIONARY_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTDICTIONARY_HPP
+
+#include <rdf4cpp/storage/persistent_node_storage/detail/MMapFile.hpp>
+#include <rdf4cpp/storage/persistent_node_storage/detail/StringHeap.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace rdf4cpp::storage::persistent_node_storage::detail {
+
+/**
+ * A bidirectional map from Id to Record that lives in three memory-mapped files:
+ *  - <name>.entries: the records, indexed by id - 1
+ *  - <name>.heap: the string data of the records
+ *  - <name>.index: an open-addressing hash table from hash of the view to id
+ *
+ * Opening an existing dictionary is O(1), nothing is rebuilt or re-interned.
+ * Ids are never reused, erased entries leave a hole and their string data is not reclaimed.
+ *
+ * @tparam Record one of the records in Records.hpp
+ */
+template<typename Record>
+struct PersistentDictionary {
+    using record_type = Record;
+    using view_type = typename Record::view_type;
+    using id_type = typename Record::id_type;
+    using size_type = size_t;
+
+private:
+    static_assert(std::is_trivially_copyable_v<Record>);
+
+    struct Entry {
+        Record record;
+        bool occupied;
+    };
+
+    struct Slot {
+        uint64_t hash;
+        uint64_t id; //< 0 if the slot is empty, tombstone_id if the slot was erased
+    };
+
+    static constexpr uint64_t tombstone_id = std::numeric_limits<uint64_t>::max();
+    static constexpr size_type min_index_capacity = 1024;
+    static constexpr std::array<char, 8> index_magic{'r', '4', 'c', 'i', 'n', 'd', 'e', 'x'};
+
+    size_type max_file_size_;
+    MMapFile entries_; //< header().size is the number of ids handed out, header().count the number of occupied entries
+    MMapFile index_;   //< header().size is the capacity, header().count the number of non-empty slots (including tombstones)
+    StringHeap heap_;
+
+    [[nodiscard]] static constexpr size_type to_index(uint64_t const id) noexcept {
+        return static_cast<size_type>(id) - 1;
+    }
+
+    [[nodiscard]] Entry *entries() noexcept {
+        return reinterpret_cast<Entry *>(entries_.payload());
+    }
+
+    [[nodiscard]] Entry const *entries() const noexcept {
+        return reinterpret_cast<Entry const *>(entries_.payload());
+    }
+
+    [[nodiscard]] static Slot *slots(MMapFile &index) noexcept {
+        return reinterpret_cast<Slot *>(index.payload());
+    }
+
+    [[nodiscard]] static Slot const *slots(MMapFile const &index) noexcept {
+        return reinterpret_cast<Slot const *>(index.payload());
+    }
+
+    static void init_index(MMapFile &index, size_type const capacity) {
+        index.reserve_payload(capacity * sizeof(Slot));
+        index.header().size = capacity;
+        index.header().count = 0;
+    }
+
+    /**
+     * Finds the slot for view.
+     * @return pointer to the slot containing the id of view, or nullptr if view is not present
+     */
+    [[nodiscard]] Slot const *find_slot(view_type const &view, uint64_t const hash) const noexcept {
+        auto const mask = index_.header().size - 1;
+        auto const *s = slots(index_);
+
+        for (auto ix = hash & mask;; ix = (ix + 1) & mask) {
+            auto const &slot = s[ix];
+            if (slot.id == 0) {
+                return nullptr;
+            }
+
+            if (slot.id != tombstone_id && slot.hash == hash) {
+                auto const &entry = entries()[to_index(slot.id)];
+                if (entry.occupied && entry.record.to_view(heap_) == view) {
+                    return &slot;
+                }
+            }
+        }
+    }
+
+    /**
+     * Puts (hash, id) into the first empty slot of index.
+     * Does not check for capacity.
+     */
+    static void index_insert(MMapFile &index, uint64_t const hash, uint64_t const id) noexcept {
+        auto const mask = index.header().size - 1;
+        auto *s = slots(index);
+
+        auto ix = hash & mask;
+        while (s[ix].id != 0 && s[ix].id != tombstone_id) {
+            ix = (ix + 1) & mask;
+        }
+
+        if (s[ix].id == 0) {
+            ++index.header().count;
+        }
+        s[ix] = Slot{.hash = hash, .id = id};
+    }
+
+    /**
+     * Rebuilds the index with the given capacity, dropping all tombstones.
+     * The new index is built next to the old one and atomically replaces it afterwards.
+     */
+    void rehash(size_type const new_capacity) {
+        auto const path = index_.path();
+        auto tmp_path = path;
+        tmp_path += ".tmp";
+        std::filesystem::remove(tmp_path);
+
+        MMapFile new_index{tmp_path, index_magic, sizeof(Slot), max_file_size_};
+        init_index(new_index, new_capacity);
+
+        auto const *old_slots = slots(index_);
+        for (size_type ix = 0; ix < index_.header().size; ++ix) {
+            if (auto const &slot = old_slots[ix]; slot.id != 0 && slot.id != tombstone_id) {
+                index_insert(new_index, slot.hash, slot.id);
+            }
+        }
+
+        new_index.rename(path);
+        index_ = std::move(new_index);
+    }
+
+    void emplace_entry(view_type const &view, uint64_t const id) {
+        // keep load factor (including tombstones) below 0.7
+        if ((index_.header().count + 1) * 10 > index_.header().size * 7) {
+            rehash(std::max(min_index_capacity, std::bit_ceil((entries_.header().count + 1) * 2)));
+        }
+
+        auto &entry = entries()[to_index(id)];
+        entry.record = Record{view, heap_};
+        entry.occupied = true;
+        ++entries_.header().count;
+
+        index_insert(index_, view.hash(), id);
+    }
+
+public:
+    /**
+     * Opens the dictionary with the given name in directory or creates it if it does not exist.
+     *
+     * @param directory directory containing the files of the dictionary
+     * @param name common prefix of the files of the dictionary
+     * @param max_file_size maximum size of each file of the dictionary
+     */
+    PersistentDictionary(std::filesystem::path const &directory, std::string const &name, size_type const max_file_size)
+        : max_file_size_{max_file_size},
+          entries_{directory / (name + ".entries"), Record::magic, sizeof(Entry), max_file_size},
+          index_{directory / (name + ".index"), index_magic, sizeof(Slot), max_file_size},
+          heap_{directory / (name + ".heap"), max_file_size} {
+
+        if (index_.header().size == 0) {
+            init_index(index_, min_index_capacity);
+        }
+    }
+
+    PersistentDictionary(PersistentDictionary const &) = delete;
+    PersistentDictionary(PersistentDictionary &&) = delete;
+    PersistentDictionary &operator=(PersistentDictionary const &) = delete;
+    PersistentDictionary &operator=(PersistentDictionary &&) = delete;
+
+    /**
+     * Number of elements stored in this dictionary
+     */
+    [[nodiscard]] size_type size() const noexcept {
+        return entries_.header().count;
+    }
+
+    /**
+     * Number of ids that were handed out (or reserved) so far
+     */
+    [[nodiscard]] size_type id_space_size() const noexcept {
+        return entries_.header().size;
+    }
+
+    /**
+     * Look up the value corresponding to the given id
+     *
+     * @param id id for value to look up
+     * @return if a value was found: a view to that value, otherwise nullopt
+     */
+    [[nodiscard]] std::optional<view_type> lookup_value(id_type const id) const noexcept {
+        if (id == id_type{}) [[unlikely]] {
+            return std::nullopt;
+        }
+
+        auto const ix = to_index(id.to_underlying());
+        if (ix >= entries_.header().size || !entries()[ix].occupied) {
+            return std::nullopt;
+        }
+
+        return entries()[ix].record.to_view(heap_);
+    }
+
+    /**
+     * Look up the id corresponding the given view
+     *
+     * @param view view of value of which to find the id
+     * @return id of the value if it was found, otherwise id_type{}
+     */
+    [[nodiscard]] id_type lookup_id(view_type const &view) const noexcept {
+        if (auto const *slot = find_slot(view, view.hash()); slot != nullptr) {
+            return id_type{slot->id};
+        }
+
+        return id_type{};
+    }
+
+    /**
+     * Reserve ids such that min_id is the next id that is handed out
+     */
+    void reserve_until(id_type const min_id) {
+        auto const new_size = to_index(min_id.to_underlying());
+        if (new_size <= entries_.header().size) {
+            return;
+        }
+
+        entries_.reserve_payload(new_size * sizeof(Entry));
+        entries_.header().size = new_size;
+    }
+
+    /**
+     * Insert a value at the next id
+     *
+     * @precondition the value is not yet present in this dictionary
+     * @return id of the inserted value
+     */
+    [[nodiscard]] id_type insert_assume_not_present(view_type const &view) {
+        auto const id = entries_.header().size + 1;
+        entries_.reserve_payload(id * sizeof(Entry));
+        entries_.header().size = id;
+
+        emplace_entry(view, id);
+        return id_type{id};
+    }
+
+    /**
+     * Insert a value at the given (previously reserved) id
+     *
+     * @precondition the value is not yet present in this dictionary and the id is reserved but not occupied
+     */
+    void insert_assume_not_present_at(view_type const &view, id_type const id) {
+        assert(to_index(id.to_underlying()) < entries_.header().size);
+        assert(!entries()[to_index(id.to_underlying())].occupied);
+
+        emplace_entry(view, id.to_underlying());
+    }
+
+    /**
+     * Erase the value with the given id, the id is not handed out again
+     *
+     * @precondition the value is present
+     */
+    void erase_assume_present(id_type const id) {
+        auto &entry = entries()[to_index(id.to_underlying())];
+        assert(entry.occupied);
+
+        auto const view = entry.record.to_view(heap_);
+        auto *slot = const_cast<Slot *>(find_slot(view, view.hash()));
+        assert(slot != nullptr);
+
+        slot->id = tombstone_id;
+        entry.occupied = false;
+        --entries_.header().count;
+    }
+
+    /**
+     * Flushes all changes to disk
+     */
+    void sync() const {
+        heap_.sync();
+        entries_.sync();
+        index_.sync();
+    }
+};
+
+}  // namespace rdf4cpp::storage::persistent_node_storage::detail
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTDICTIONARY_HPP
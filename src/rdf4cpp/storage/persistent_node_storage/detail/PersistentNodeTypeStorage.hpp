@@ -0,0 +1,51 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTNODETYPESTORAGE_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTNODETYPESTORAGE_HPP
+
+#include <rdf4cpp/storage/persistent_node_storage/detail/PersistentDictionary.hpp>
+
+#include <shared_mutex>
+
+namespace rdf4cpp::storage::persistent_node_storage {
+
+/**
+ * Storage for one of the node types. Includes a shared mutex to synchronize access and a persistent bidirectional mapping between the Record type and its id.
+ * @tparam Record_t one of IRIRecord, BNodeRecord, VariableRecord and LiteralRecord
+ */
+template<typename Record_t>
+struct PersistentNodeTypeStorage {
+    using backend_type = Record_t;
+    using backend_view_type = typename backend_type::view_type;
+    using backend_id_type = typename backend_type::id_type;
+
+    detail::PersistentDictionary<backend_type> mapping;
+    std::shared_mutex mutable mutex;
+
+    PersistentNodeTypeStorage(std::filesystem::path const &directory, std::string const &name, size_t max_file_size)
+        : mapping{directory, name, max_file_size} {
+    }
+
+    /**
+     * Translates the given backend_id_type into a NodeID
+     */
+    static identifier::NodeBackendID from_storage_id(backend_id_type const id, backend_view_type const &view) noexcept {
+        return backend_type::from_storage_id(id, view);
+    }
+
+    /**
+     * Translates the given NodeID into a backend_id_type
+     */
+    static backend_id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return backend_type::to_storage_id(id);
+    }
+
+    /**
+     * Gets the default value for the view type of this backend
+     */
+    static backend_view_type get_default_view() noexcept {
+        return backend_type::get_default_view();
+    }
+};
+
+}  // namespace rdf4cpp::storage::persistent_node_storage
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_PERSISTENTNODETYPESTORAGE_HPP
@@ -0,0 +1,65 @@
+#ifndef RDF4CPP_PERSISTENTNODESTORAGE_STRINGHEAP_HPP
+#define RDF4CPP_PERSISTENTNODESTORAGE_STRINGHEAP_HPP
+
+#include <rdf4cpp/storage/persistent_node_storage/detail/MMapFile.hpp>
+
+#include <cstring>
+#include <string_view>
+
+namespace rdf4cpp::storage::persistent_node_storage::detail {
+
+/**
+ * Reference to a string stored in a StringHeap
+ */
+struct HeapString {
+    uint64_t offset;
+    uint64_t size;
+};
+
+/**
+ * Append-only heap of string data backed by a MMapFile.
+ * Strings are never moved, so string_views returned by get stay valid for the lifetime of the heap.
+ */
+struct StringHeap {
+private:
+    static constexpr std::array<char, 8> magic{'r', '4', 'c', 'h', 'e', 'a', 'p', '\0'};
+
+    MMapFile file_; //< header().size is the number of used bytes
+
+public:
+    StringHeap(std::filesystem::path path, size_t max_size) : file_{std::move(path), magic, 1, max_size} {
+    }
+
+    /**
+     * Copies s into the heap
+     * @return reference to the copy of s
+     */
+    [[nodiscard]] HeapString append(std::string_view const s) {
+        auto &header = file_.header();
+        file_.reserve_payload(header.size + s.size());
+
+        HeapString const ret{.offset = header.size, .size = s.size()};
+        std::memcpy(file_.payload() + header.size, s.data(), s.size());
+        header.size += s.size();
+        return ret;
+    }
+
+    [[nodiscard]] std::string_view get(HeapString const s) const noexcept {
+        return std::string_view{reinterpret_cast<char const *>(file_.payload()) + s.offset, s.size};
+    }
+
+    /**
+     * Number of bytes occupied by strings
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return file_.header().size;
+    }
+
+    void sync() const {
+        file_.sync();
+    }
+};
+
+}  // namespace rdf4cpp::storage::persistent_node_storage::detail
+
+#endif  //RDF4CPP_PERSISTENTNODESTORAGE_STRINGHEAP_HPP
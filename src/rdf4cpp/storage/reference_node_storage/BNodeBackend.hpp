@@ -3,19 +3,21 @@
 
 #include <rdf4cpp/storage/view/BNodeBackendView.hpp>
 #include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
-#include <rdf4cpp/storage/reference_node_storage/detail/ConstString.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
 struct BNodeBackend {
     using view_type = view::BNodeBackendView;
     using id_type = identifier::NodeID;
+    using allocator_type = detail::StringArenaAllocator<char>;
+    static constexpr bool arena_allocated = true; //< only owns memory allocated with allocator_type, see detail::ArenaAllocated
 
     size_t hash;
-    detail::ConstString identifier;
+    detail::ArenaConstString identifier;
 
-    explicit BNodeBackend(view_type const &view) noexcept : hash{view.hash()},
-                                                            identifier{view.identifier} {
+    explicit BNodeBackend(view_type const &view, allocator_type const &alloc = allocator_type{}) noexcept : hash{view.hash()},
+                                                                                                            identifier{view.identifier, alloc} {
     }
 
     explicit operator view_type() const noexcept {
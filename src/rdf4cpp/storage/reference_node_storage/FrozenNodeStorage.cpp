@@ -0,0 +1,273 @@
+#include "FrozenNodeStorage.hpp"
+
+#include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/ReconstructionBuffer.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+using detail::FrontCodedDictionary;
+
+struct FrozenNodeStorage::Staging {
+    std::vector<FrontCodedDictionary::Entry> bnodes;
+    std::vector<FrontCodedDictionary::Entry> iris;
+    std::vector<FrontCodedDictionary::Entry> variables;
+    std::vector<FrontCodedDictionary::Entry> fallback_literals;
+    decltype(FrozenNodeStorage::specialized_literal_storage_) *specialized_literals;
+};
+
+/*
+ * Variables and literals consist of more than a single string,
+ * they are encoded into a single string key to be able to store them in a FrontCodedDictionary.
+ */
+
+static void encode_variable(view::VariableBackendView const &view, std::string &out) {
+    out.clear();
+    out.reserve(1 + view.name.size());
+    out.push_back(view.is_anonymous ? '\1' : '\0');
+    out.append(view.name);
+}
+
+static view::VariableBackendView decode_variable(std::string_view const key) noexcept {
+    return view::VariableBackendView{.name = key.substr(1), .is_anonymous = key[0] != '\0'};
+}
+
+static void encode_lexical_literal(view::LexicalFormLiteralBackendView const &view, std::string &out) {
+    auto const datatype = view.datatype_id.to_underlying();
+
+    out.clear();
+    out.reserve(sizeof(datatype) + 2 + view.language_tag.size() + view.lexical_form.size());
+    for (size_t byte = sizeof(datatype); byte > 0; --byte) {
+        out.push_back(static_cast<char>(datatype >> ((byte - 1) * 8)));
+    }
+    out.push_back(view.needs_escape ? '\1' : '\0');
+    out.append(view.language_tag);
+    out.push_back('\0'); // language tags never contain \0
+    out.append(view.lexical_form);
+}
+
+static view::LexicalFormLiteralBackendView decode_lexical_literal(std::string_view const key) noexcept {
+    identifier::NodeBackendID::underlying_type datatype = 0;
+    for (size_t byte = 0; byte < sizeof(datatype); ++byte) {
+        datatype = (datatype << 8) | static_cast<unsigned char>(key[byte]);
+    }
+
+    auto const rest = key.substr(sizeof(datatype) + 1);
+    auto const separator = rest.find('\0');
+
+    return view::LexicalFormLiteralBackendView{.datatype_id = identifier::NodeBackendID{datatype},
+                                               .lexical_form = rest.substr(separator + 1),
+                                               .language_tag = rest.substr(0, separator),
+                                               .needs_escape = key[sizeof(datatype)] != '\0'};
+}
+
+void FrozenNodeStorage::stage(Staging &staging, identifier::NodeBackendID const id, view::BNodeBackendView const &view) {
+    staging.bnodes.push_back(FrontCodedDictionary::Entry{.key = std::string{view.identifier}, .id = id, .index = id.node_id().to_underlying()});
+}
+
+void FrozenNodeStorage::stage(Staging &staging, identifier::NodeBackendID const id, view::IRIBackendView const &view) {
+    staging.iris.push_back(FrontCodedDictionary::Entry{.key = std::string{view.identifier}, .id = id, .index = id.node_id().to_underlying()});
+}
+
+void FrozenNodeStorage::stage(Staging &staging, identifier::NodeBackendID const id, view::VariableBackendView const &view) {
+    std::string key;
+    encode_variable(view, key);
+    staging.variables.push_back(FrontCodedDictionary::Entry{.key = std::move(key), .id = id, .index = id.node_id().to_underlying()});
+}
+
+void FrozenNodeStorage::stage(Staging &staging, identifier::NodeBackendID const id, view::LexicalFormLiteralBackendView const &view) {
+    std::string key;
+    encode_lexical_literal(view, key);
+    staging.fallback_literals.push_back(FrontCodedDictionary::Entry{.key = std::move(key), .id = id, .index = id.node_id().literal_id().to_underlying()});
+}
+
+void FrozenNodeStorage::stage(Staging &staging, identifier::NodeBackendID const id, view::ValueLiteralBackendView const &view) {
+    specialization_detail::visit_specialized(*staging.specialized_literals, view.datatype, [id, &view](auto &table) {
+        using backend_type = typename std::remove_cvref_t<decltype(table)>::backend_type;
+        table.insert(backend_type::to_storage_id(id), view);
+    });
+}
+
+FrozenNodeStorage::FrozenNodeStorage(std::function<void(Staging &)> const &populate) {
+    Staging staging{.specialized_literals = &specialized_literal_storage_};
+    populate(staging);
+
+    bnode_storage_ = FrontCodedDictionary{std::move(staging.bnodes)};
+    iri_storage_ = FrontCodedDictionary{std::move(staging.iris)};
+    variable_storage_ = FrontCodedDictionary{std::move(staging.variables)};
+    fallback_literal_storage_ = FrontCodedDictionary{std::move(staging.fallback_literals)};
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [](auto &table) {
+        table.seal();
+    });
+}
+
+size_t FrozenNodeStorage::size() const noexcept {
+    return iri_storage_.size() +
+           bnode_storage_.size() +
+           variable_storage_.size() +
+           fallback_literal_storage_.size() +
+           dice::template_library::tuple_fold(specialized_literal_storage_, 0, [](auto acc, auto const &table) noexcept {
+               return acc + table.size();
+           });
+}
+
+void FrozenNodeStorage::shrink_to_fit() noexcept {
+    // already as compact as possible
+}
+
+bool FrozenNodeStorage::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
+    static constexpr auto specialization_lut = specialization_detail::make_storage_specialization_lut<decltype(specialized_literal_storage_)>();
+    return specialization_lut[datatype.to_underlying()];
+}
+
+/**
+ * Returns id if it is not null, otherwise throws because the node would need to be inserted.
+ */
+static identifier::NodeBackendID require_present(identifier::NodeBackendID const id, std::string_view const node_kind) {
+    if (id.null()) [[unlikely]] {
+        throw std::runtime_error{"cannot insert " + std::string{node_kind} + " into FrozenNodeStorage, it is read-only"};
+    }
+
+    return id;
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_or_make_id(view::BNodeBackendView const &view) {
+    return require_present(find_id(view), "blank node");
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_or_make_id(view::IRIBackendView const &view) {
+    return require_present(find_id(view), "IRI");
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_or_make_id(view::LiteralBackendView const &view) {
+    return require_present(find_id(view), "literal");
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_or_make_id(view::VariableBackendView const &view) {
+    return require_present(find_id(view), "variable");
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_id(view::BNodeBackendView const &view) const noexcept {
+    return bnode_storage_.find_id(view.identifier);
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_id(view::IRIBackendView const &view) const noexcept {
+    return iri_storage_.find_id(view.identifier);
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_id(view::LiteralBackendView const &view) const noexcept {
+    return view.visit(
+            [this](view::LexicalFormLiteralBackendView const &lexical) noexcept {
+                assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
+
+                auto &key = detail::next_reconstruction_buffer();
+                try {
+                    encode_lexical_literal(lexical, key);
+                } catch (std::bad_alloc const &) {
+                    // the key cannot be built, so it cannot be looked up either
+                    return identifier::NodeBackendID{};
+                }
+
+                return fallback_literal_storage_.find_id(key);
+            },
+            [this](view::ValueLiteralBackendView const &any) noexcept {
+                assert(has_specialized_storage_for(any.datatype));
+                return specialization_detail::visit_specialized(specialized_literal_storage_, any.datatype, [&any](auto const &table) noexcept {
+                    using backend_type = typename std::remove_cvref_t<decltype(table)>::backend_type;
+
+                    auto const id = table.find_id(any);
+                    if (id == typename backend_type::id_type{}) {
+                        return identifier::NodeBackendID{};
+                    }
+
+                    return backend_type::from_storage_id(id, any);
+                });
+            });
+}
+
+identifier::NodeBackendID FrozenNodeStorage::find_id(view::VariableBackendView const &view) const noexcept {
+    auto &key = detail::next_reconstruction_buffer();
+    try {
+        encode_variable(view, key);
+    } catch (std::bad_alloc const &) {
+        // the key cannot be built, so it cannot be looked up either
+        return identifier::NodeBackendID{};
+    }
+
+    return variable_storage_.find_id(key);
+}
+
+/**
+ * Decodes the string with the given index from the dictionary into a reconstruction buffer.
+ */
+static std::string_view find_key(FrontCodedDictionary const &dictionary, size_t const index) noexcept {
+    auto &buffer = detail::next_reconstruction_buffer();
+    if (!dictionary.find_key(index, buffer)) {
+        assert(false); // assert in debug build; not critical error but should not happen
+        buffer.clear();
+    }
+
+    return buffer;
+}
+
+view::IRIBackendView FrozenNodeStorage::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+    return view::IRIBackendView{.identifier = find_key(iri_storage_, id.node_id().to_underlying())};
+}
+
+view::LiteralBackendView FrozenNodeStorage::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+    if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
+        return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto const &table) noexcept -> view::LiteralBackendView {
+            using backend_type = typename std::remove_cvref_t<decltype(table)>::backend_type;
+
+            if (auto value = table.find_value(backend_type::to_storage_id(id)); value.has_value()) {
+                return *value;
+            }
+
+            assert(false); // assert in debug build; not critical error but should not happen
+            return backend_type::get_default_view();
+        });
+    }
+
+    auto const key = find_key(fallback_literal_storage_, id.node_id().literal_id().to_underlying());
+    if (key.empty()) [[unlikely]] {
+        return view::LexicalFormLiteralBackendView{};
+    }
+
+    return decode_lexical_literal(key);
+}
+
+view::BNodeBackendView FrozenNodeStorage::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+    return view::BNodeBackendView{.identifier = find_key(bnode_storage_, id.node_id().to_underlying())};
+}
+
+view::VariableBackendView FrozenNodeStorage::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+    auto const key = find_key(variable_storage_, id.node_id().to_underlying());
+    if (key.empty()) [[unlikely]] {
+        return view::VariableBackendView{};
+    }
+
+    return decode_variable(key);
+}
+
+bool FrozenNodeStorage::erase_iri([[maybe_unused]] identifier::NodeBackendID const id) noexcept {
+    return false;
+}
+
+bool FrozenNodeStorage::erase_literal([[maybe_unused]] identifier::NodeBackendID const id) noexcept {
+    return false;
+}
+
+bool FrozenNodeStorage::erase_bnode([[maybe_unused]] identifier::NodeBackendID const id) noexcept {
+    return false;
+}
+
+bool FrozenNodeStorage::erase_variable([[maybe_unused]] identifier::NodeBackendID const id) noexcept {
+    return false;
+}
+
+}  // namespace rdf4cpp::storage::reference_node_storage
@@ -0,0 +1,111 @@
+#ifndef RDF4CPP_FROZENNODESTORAGE_HPP
+#define RDF4CPP_FROZENNODESTORAGE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+
+#include <rdf4cpp/storage/NodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SpecializedLiteralBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/FrontCodedDictionary.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/FrozenValueTable.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+/**
+ * A NodeStorage that can enumerate all of its nodes, see SyncReferenceNodeStorage::for_each_node
+ */
+template<typename NS>
+concept FreezableNodeStorage = NodeStorage<NS> && requires (NS const &ns) {
+    ns.for_each_node([](identifier::NodeBackendID, auto const &) {});
+};
+
+/**
+ * Immutable, compact NodeStorage built ("frozen") from a populated reference node storage.
+ * Every node keeps the NodeBackendID it had in the source storage.
+ *
+ * Strings (IRIs, blank nodes, variables and literals without specialized storage) are stored in sorted, front-coded blocks (see detail::FrontCodedDictionary)
+ * instead of hash maps, values of literals with specialized storage are stored in flat arrays.
+ *
+ * Inserting nodes that are not present is rejected with an exception, erasing nodes is not possible.
+ *
+ * @warning Because the strings are compressed they need to be reconstructed to hand out views (see detail::next_reconstruction_buffer).
+ *      The strings of views returned by find_*_backend are only valid until the same thread has requested
+ *      detail::reconstruction_buffer_count further reconstruction buffers.
+ */
+struct FrozenNodeStorage {
+private:
+    detail::FrontCodedDictionary bnode_storage_;
+    detail::FrontCodedDictionary iri_storage_;
+    detail::FrontCodedDictionary variable_storage_;
+
+    detail::FrontCodedDictionary fallback_literal_storage_;
+
+    template<typename Datatype>
+    using specialized_literal_storage = detail::FrozenValueTable<SpecializedLiteralBackend<Datatype>>;
+
+    specialization_detail::specialized_storage_tuple<specialized_literal_storage> specialized_literal_storage_;
+
+    /**
+     * Collects the nodes of the source storage during construction
+     */
+    struct Staging;
+
+    static void stage(Staging &staging, identifier::NodeBackendID id, view::BNodeBackendView const &view);
+    static void stage(Staging &staging, identifier::NodeBackendID id, view::IRIBackendView const &view);
+    static void stage(Staging &staging, identifier::NodeBackendID id, view::VariableBackendView const &view);
+    static void stage(Staging &staging, identifier::NodeBackendID id, view::LexicalFormLiteralBackendView const &view);
+    static void stage(Staging &staging, identifier::NodeBackendID id, view::ValueLiteralBackendView const &view);
+
+    explicit FrozenNodeStorage(std::function<void(Staging &)> const &populate);
+
+public:
+    /**
+     * Freezes the given storage, i.e. copies all of its nodes.
+     * The source storage is not modified and can be destroyed afterwards.
+     */
+    template<FreezableNodeStorage Source>
+    explicit FrozenNodeStorage(Source const &source) : FrozenNodeStorage{[&source](Staging &staging) {
+                                                          source.for_each_node([&staging](identifier::NodeBackendID const id, auto const &view) {
+                                                              stage(staging, id, view);
+                                                          });
+                                                      }} {
+    }
+
+    [[nodiscard]] size_t size() const noexcept;
+    void shrink_to_fit() noexcept;
+
+    [[nodiscard]] static bool has_specialized_storage_for(identifier::LiteralType datatype) noexcept;
+
+    /**
+     * @throws std::runtime_error if the node is not present, because the storage cannot be modified
+     */
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::IRIBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::LiteralBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::VariableBackendView const &view);
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::BNodeBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::LiteralBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::VariableBackendView const &view) const noexcept;
+
+    [[nodiscard]] view::IRIBackendView find_iri_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::LiteralBackendView find_literal_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::BNodeBackendView find_bnode_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::VariableBackendView find_variable_backend(identifier::NodeBackendID id) const noexcept;
+
+    /**
+     * Always return false, because the storage cannot be modified
+     */
+    bool erase_iri(identifier::NodeBackendID id) noexcept;
+    bool erase_literal(identifier::NodeBackendID id) noexcept;
+    bool erase_bnode(identifier::NodeBackendID id) noexcept;
+    bool erase_variable(identifier::NodeBackendID id) noexcept;
+};
+static_assert(NodeStorage<FrozenNodeStorage>);
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+
+#endif  //RDF4CPP_FROZENNODESTORAGE_HPP
@@ -2,19 +2,21 @@
 #define RDF4CPP_IRIBACKEND_HPP
 
 #include <rdf4cpp/storage/view/IRIBackendView.hpp>
-#include <rdf4cpp/storage/reference_node_storage/detail/ConstString.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
 struct IRIBackend {
     using view_type = view::IRIBackendView;
     using id_type = identifier::NodeID;
+    using allocator_type = detail::StringArenaAllocator<char>;
+    static constexpr bool arena_allocated = true; //< only owns memory allocated with allocator_type, see detail::ArenaAllocated
 
     size_t hash;
-    detail::ConstString identifier;
+    detail::ArenaConstString identifier;
 
-    explicit IRIBackend(view_type const &view) noexcept : hash{view.hash()},
-                                                          identifier{view.identifier} {
+    explicit IRIBackend(view_type const &view, allocator_type const &alloc = allocator_type{}) noexcept : hash{view.hash()},
+                                                                                                          identifier{view.identifier, alloc} {
     }
 
     explicit operator view_type() const noexcept {
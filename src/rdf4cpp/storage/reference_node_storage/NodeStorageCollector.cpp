@@ -0,0 +1,96 @@
+#include "NodeStorageCollector.hpp"
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+template<typename IRIBackend_t>
+BasicNodeStorageCollector<IRIBackend_t>::BasicNodeStorageCollector(storage_type &storage, std::chrono::milliseconds const interval) : storage_{&storage} {
+    storage_->track_epochs(&tracker_);
+
+    if (interval > std::chrono::milliseconds::zero()) {
+        worker_ = std::jthread{[this, interval](std::stop_token const &stop) {
+            run(stop, interval);
+        }};
+    }
+}
+
+template<typename IRIBackend_t>
+BasicNodeStorageCollector<IRIBackend_t>::~BasicNodeStorageCollector() {
+    if (worker_.joinable()) {
+        worker_.request_stop();
+        worker_.join();
+    }
+
+    storage_->track_epochs(nullptr);
+}
+
+template<typename IRIBackend_t>
+void BasicNodeStorageCollector<IRIBackend_t>::run(std::stop_token const &stop, std::chrono::milliseconds const interval) {
+    std::unique_lock lock{worker_mutex_};
+
+    while (!stop.stop_requested()) {
+        // the predicate only becomes true if stop is requested
+        if (worker_cv_.wait_for(lock, stop, interval, [] { return false; }) || stop.stop_requested()) {
+            break;
+        }
+
+        lock.unlock();
+        try {
+            collect();
+        } catch (...) {
+            // e.g. out of memory during the collection, try again next time
+        }
+        lock.lock();
+    }
+}
+
+template<typename IRIBackend_t>
+typename BasicNodeStorageCollector<IRIBackend_t>::Guard BasicNodeStorageCollector<IRIBackend_t>::pin() noexcept {
+    return Guard{tracker_};
+}
+
+template<typename IRIBackend_t>
+typename BasicNodeStorageCollector<IRIBackend_t>::root_handle BasicNodeStorageCollector<IRIBackend_t>::add_root(root_type root) {
+    std::lock_guard lock{roots_mutex_};
+    auto const handle = next_root_++;
+    roots_.emplace(handle, std::move(root));
+    return handle;
+}
+
+template<typename IRIBackend_t>
+void BasicNodeStorageCollector<IRIBackend_t>::remove_root(root_handle const handle) {
+    std::lock_guard lock{roots_mutex_};
+    roots_.erase(handle);
+}
+
+template<typename IRIBackend_t>
+size_t BasicNodeStorageCollector<IRIBackend_t>::collect() {
+    std::lock_guard collect_lock{collect_mutex_};
+
+    // everything that is marked from now on is stamped with at least this epoch
+    auto const epoch = tracker_.advance();
+
+    {
+        std::lock_guard roots_lock{roots_mutex_};
+        mark_type const mark = [this](identifier::NodeBackendID const id) {
+            storage_->touch(id);
+        };
+
+        for (auto const &[_, root] : roots_) {
+            root(mark);
+        }
+    }
+
+    auto const erased = storage_->sweep(tracker_.safe_epoch(epoch));
+    collected_.fetch_add(erased, std::memory_order_relaxed);
+    return erased;
+}
+
+template<typename IRIBackend_t>
+size_t BasicNodeStorageCollector<IRIBackend_t>::collected() const noexcept {
+    return collected_.load(std::memory_order_relaxed);
+}
+
+template struct BasicNodeStorageCollector<IRIBackend>;
+template struct BasicNodeStorageCollector<PrefixCompressedIRIBackend>;
+
+}  // namespace rdf4cpp::storage::reference_node_storage
@@ -0,0 +1,171 @@
+#ifndef RDF4CPP_NODESTORAGECOLLECTOR_HPP
+#define RDF4CPP_NODESTORAGECOLLECTOR_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/EpochTracker.hpp>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+/**
+ * Epoch-based garbage collector for a SyncReferenceNodeStorage.
+ * Nodes that are no longer used are erased from the storage, their ids are recycled by the storage (see detail::IndexFreeList).
+ *
+ * Nodes are not reference counted (Node is a trivially copyable handle), instead the collector relies on the following contract:
+ *  - Every node that is kept long term must be reachable from a root (see add_root), e.g. a root that enumerates the nodes of a Graph.
+ *  - Every other use of a node (e.g. between parsing a triple and inserting it into a Graph) must happen while a Guard is held (see pin).
+ *    The Guard must be held until the node is reachable from a root or is not needed anymore.
+ *
+ * A collection (see collect) erases all nodes that are neither reachable from a root
+ * nor were looked up or created since the oldest Guard that is still held was created.
+ * Collections happen either manually or periodically on a background thread.
+ *
+ * While the collector exists the storage tracks when each node was last used, which costs an additional atomic access per lookup.
+ *
+ * @tparam IRIBackend_t IRI backend type of the collected storage
+ */
+template<typename IRIBackend_t>
+struct BasicNodeStorageCollector {
+    using storage_type = BasicSyncReferenceNodeStorage<IRIBackend_t>;
+
+    /**
+     * Marks a node as reachable
+     */
+    using mark_type = std::function<void(identifier::NodeBackendID)>;
+
+    /**
+     * A root calls the provided mark function for every node it keeps alive
+     */
+    using root_type = std::function<void(mark_type const &)>;
+
+    using root_handle = size_t;
+
+    /**
+     * Protects all nodes that are used while it is held from being collected, see BasicNodeStorageCollector.
+     */
+    struct Guard {
+    private:
+        detail::EpochTracker *tracker_;
+        size_t slot_;
+
+        friend struct BasicNodeStorageCollector;
+
+        explicit Guard(detail::EpochTracker &tracker) noexcept : tracker_{&tracker},
+                                                                 slot_{tracker.enter()} {
+        }
+
+    public:
+        Guard(Guard const &) = delete;
+        Guard &operator=(Guard const &) = delete;
+
+        Guard(Guard &&other) noexcept : tracker_{std::exchange(other.tracker_, nullptr)},
+                                        slot_{other.slot_} {
+        }
+
+        Guard &operator=(Guard &&other) noexcept {
+            if (this != &other) {
+                release();
+                tracker_ = std::exchange(other.tracker_, nullptr);
+                slot_ = other.slot_;
+            }
+            return *this;
+        }
+
+        ~Guard() {
+            release();
+        }
+
+        /**
+         * Releases the guard before it is destroyed
+         */
+        void release() noexcept {
+            if (tracker_ != nullptr) {
+                tracker_->exit(slot_);
+                tracker_ = nullptr;
+            }
+        }
+    };
+
+private:
+    storage_type *storage_;
+    detail::EpochTracker tracker_;
+
+    std::mutex roots_mutex_;
+    std::map<root_handle, root_type> roots_;
+    root_handle next_root_ = 0;
+
+    std::mutex collect_mutex_; //< serializes collections
+    std::atomic<size_t> collected_ = 0;
+
+    std::mutex worker_mutex_;
+    std::condition_variable_any worker_cv_;
+    std::jthread worker_; //< must be the last member, so that it is stopped before everything else is destroyed
+
+    void run(std::stop_token const &stop, std::chrono::milliseconds interval);
+
+public:
+    /**
+     * Starts tracking the usage of the nodes in storage.
+     *
+     * @param storage the storage to collect, must outlive this collector and must not be tracked by a different collector
+     * @param interval time between two automatic collections on a background thread,
+     *      if it is zero no background thread is started and collections need to be triggered via collect
+     */
+    explicit BasicNodeStorageCollector(storage_type &storage, std::chrono::milliseconds interval = std::chrono::milliseconds::zero());
+
+    BasicNodeStorageCollector(BasicNodeStorageCollector const &) = delete;
+    BasicNodeStorageCollector(BasicNodeStorageCollector &&) = delete;
+    BasicNodeStorageCollector &operator=(BasicNodeStorageCollector const &) = delete;
+    BasicNodeStorageCollector &operator=(BasicNodeStorageCollector &&) = delete;
+
+    /**
+     * Stops the background thread and stops tracking the storage. Does not erase any nodes.
+     */
+    ~BasicNodeStorageCollector();
+
+    /**
+     * @return a guard that protects all nodes used by this thread from now on until the guard is released
+     */
+    [[nodiscard]] Guard pin() noexcept;
+
+    /**
+     * Registers a root. The root is called during every collection, possibly on the background thread, and must be thread-safe.
+     * @return handle to unregister the root with
+     */
+    root_handle add_root(root_type root);
+
+    /**
+     * Unregisters a root. Does not return before an ongoing call to the root has finished.
+     */
+    void remove_root(root_handle handle);
+
+    /**
+     * Collects all unused nodes now. Thread-safe, blocks until a concurrent collection has finished.
+     * @return number of erased nodes
+     */
+    size_t collect();
+
+    /**
+     * @return total number of nodes erased by this collector
+     */
+    [[nodiscard]] size_t collected() const noexcept;
+};
+
+extern template struct BasicNodeStorageCollector<IRIBackend>;
+extern template struct BasicNodeStorageCollector<PrefixCompressedIRIBackend>;
+
+using NodeStorageCollector = BasicNodeStorageCollector<IRIBackend>;
+using PrefixCompressedNodeStorageCollector = BasicNodeStorageCollector<PrefixCompressedIRIBackend>;
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+
+#endif  //RDF4CPP_NODESTORAGECOLLECTOR_HPP
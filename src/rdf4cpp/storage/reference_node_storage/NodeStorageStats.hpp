@@ -0,0 +1,70 @@
+#ifndef RDF4CPP_NODESTORAGESTATS_HPP
+#define RDF4CPP_NODESTORAGESTATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+/**
+ * Statistics of the dictionary of a single node type.
+ *
+ * The structural statistics (entries up to vacant_ids) are always available.
+ * The counters (lookup_hits up to unique_lock_wait_ns) are only collected if rdf4cpp is built with RDF4CPP_NODE_STORAGE_STATS,
+ * otherwise they are always zero and do not cost anything.
+ */
+struct NodeTypeStats {
+    size_t entries = 0;       //< number of stored nodes
+    size_t string_bytes = 0;  //< bytes of string payload (IRIs, lexical forms, ...) of the stored nodes
+    double load_factor = 0.0; //< load factor of the hash table from node to id
+    size_t id_capacity = 0;   //< ids handed out so far, including reserved and vacant ones
+    size_t vacant_ids = 0;    //< ids that were freed by erasure and not reused yet, vacant_ids / id_capacity is the freelist fragmentation
+
+    uint64_t lookup_hits = 0;         //< lookups that found an existing node
+    uint64_t lookup_misses = 0;       //< lookups that did not find an existing node, including the ones followed by an insert
+    uint64_t inserts = 0;             //< inserted nodes
+    uint64_t shared_lock_wait_ns = 0; //< total time spent waiting for the shared lock
+    uint64_t unique_lock_wait_ns = 0; //< total time spent waiting for the unique lock
+
+    NodeTypeStats &operator+=(NodeTypeStats const &other) noexcept {
+        auto const slots = static_cast<double>(id_capacity + other.id_capacity);
+        if (slots > 0) {
+            // weighted by capacity, which approximates the table sizes
+            load_factor = (load_factor * static_cast<double>(id_capacity) + other.load_factor * static_cast<double>(other.id_capacity)) / slots;
+        }
+
+        entries += other.entries;
+        string_bytes += other.string_bytes;
+        id_capacity += other.id_capacity;
+        vacant_ids += other.vacant_ids;
+        lookup_hits += other.lookup_hits;
+        lookup_misses += other.lookup_misses;
+        inserts += other.inserts;
+        shared_lock_wait_ns += other.shared_lock_wait_ns;
+        unique_lock_wait_ns += other.unique_lock_wait_ns;
+        return *this;
+    }
+};
+
+/**
+ * Statistics of a reference node storage, per node type.
+ * A plain aggregate, meant to be exported to a metrics pipeline.
+ */
+struct NodeStorageStats {
+    static constexpr bool counters_enabled =
+#ifdef RDF4CPP_NODE_STORAGE_STATS
+            true;
+#else
+            false;
+#endif
+
+    NodeTypeStats iris;
+    NodeTypeStats bnodes;
+    NodeTypeStats variables;
+    NodeTypeStats lexical_literals;     //< literals stored by their lexical form
+    NodeTypeStats specialized_literals; //< literals stored by their value, summed over all datatypes
+};
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+
+#endif  //RDF4CPP_NODESTORAGESTATS_HPP
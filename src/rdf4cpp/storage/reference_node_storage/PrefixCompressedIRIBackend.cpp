@@ -0,0 +1,17 @@
+#include "PrefixCompressedIRIBackend.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+std::string_view reconstruct_iri(std::string_view const prefix, std::string_view const local_name) noexcept {
+    assert(prefix.size() + local_name.size() <= fixed_reconstruction_buffer_size);
+
+    auto &buffer = next_fixed_reconstruction_buffer();
+    std::copy(prefix.begin(), prefix.end(), buffer.data());
+    std::copy(local_name.begin(), local_name.end(), buffer.data() + prefix.size());
+    return std::string_view{buffer.data(), prefix.size() + local_name.size()};
+}
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
@@ -0,0 +1,152 @@
+#ifndef RDF4CPP_PREFIXCOMPRESSEDIRIBACKEND_HPP
+#define RDF4CPP_PREFIXCOMPRESSEDIRIBACKEND_HPP
+
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+#include <rdf4cpp/storage/view/IRIBackendView.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/ReconstructionBuffer.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
+
+#include <string_view>
+#include <utility>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+namespace detail {
+
+/**
+ * Splits an IRI into (prefix, local name) after the last '/' or '#' that is followed by a non-empty local name.
+ * If there is no such '/' or '#', the prefix is empty.
+ */
+[[nodiscard]] constexpr std::pair<std::string_view, std::string_view> split_iri(std::string_view const iri) noexcept {
+    if (iri.size() < 2) {
+        return {std::string_view{}, iri};
+    }
+
+    auto const split_pos = iri.find_last_of("/#", iri.size() - 2);
+    if (split_pos == std::string_view::npos) {
+        return {std::string_view{}, iri};
+    }
+
+    return {iri.substr(0, split_pos + 1), iri.substr(split_pos + 1)};
+}
+
+/**
+ * Concatenates prefix and local_name into a fixed-size thread-local reconstruction buffer (see next_fixed_reconstruction_buffer).
+ * @precondition prefix.size() + local_name.size() <= fixed_reconstruction_buffer_size
+ */
+[[nodiscard]] std::string_view reconstruct_iri(std::string_view prefix, std::string_view local_name) noexcept;
+
+} // namespace detail
+
+/**
+ * Drop-in alternative for IRIBackend that stores every IRI as (pointer to a prefix interned in the detail::StringArena of its storage, local name).
+ * IRIs that share a namespace only store the namespace once, which saves a lot of memory in typical datasets.
+ * A prefix is released as soon as the last IRI using it is erased, or together with the arena when the storage is cleared.
+ *
+ * @warning Converting a PrefixCompressedIRIBackend into a view::IRIBackendView needs to reconstruct the IRI (see detail::reconstruct_iri).
+ *      The identifier of such a view is only valid until the same thread has requested detail::reconstruction_buffer_count further
+ *      fixed-size reconstruction buffers (see detail::next_fixed_reconstruction_buffer), instead of as long as the IRI exists in the storage.
+ *      IRIs without prefix do not need to be reconstructed, so views of them do not have this restriction.
+ *      IRIs longer than max_compressed_size are stored without prefix, such that reconstruction never needs to allocate.
+ *      IRIs that are not allocated from an arena are stored without prefix as well.
+ */
+struct PrefixCompressedIRIBackend {
+    using view_type = view::IRIBackendView;
+    using id_type = identifier::NodeID;
+    using allocator_type = detail::StringArenaAllocator<char>;
+    static constexpr bool arena_allocated = true; //< only owns memory allocated with allocator_type, see detail::ArenaAllocated
+
+    /**
+     * Maximum size of IRIs that are stored prefix-compressed, such that they fit into a fixed-size reconstruction buffer
+     */
+    static constexpr size_t max_compressed_size = detail::fixed_reconstruction_buffer_size;
+
+    size_t hash;
+    std::string_view const *prefix; //< prefix interned in the arena of local_name, or nullptr if the IRI is stored without prefix
+    detail::ArenaConstString local_name;
+
+private:
+    [[nodiscard]] static std::pair<std::string_view, std::string_view> split(std::string_view const iri, allocator_type const &alloc) noexcept {
+        if (alloc.arena() == nullptr || iri.size() > max_compressed_size) [[unlikely]] {
+            return {std::string_view{}, iri};
+        }
+
+        return detail::split_iri(iri);
+    }
+
+    PrefixCompressedIRIBackend(size_t const hash,
+                               std::pair<std::string_view, std::string_view> const &prefix_and_local_name,
+                               allocator_type const &alloc) : hash{hash},
+                                                              prefix{nullptr},
+                                                              local_name{prefix_and_local_name.second, alloc} {
+        if (!prefix_and_local_name.first.empty()) {
+            prefix = alloc.arena()->intern(prefix_and_local_name.first);
+        }
+    }
+
+public:
+    explicit PrefixCompressedIRIBackend(view_type const &view, allocator_type const &alloc = allocator_type{}) : PrefixCompressedIRIBackend{view.hash(), split(view.identifier, alloc), alloc} {
+    }
+
+    PrefixCompressedIRIBackend(PrefixCompressedIRIBackend &&other) noexcept : hash{other.hash},
+                                                                              prefix{std::exchange(other.prefix, nullptr)},
+                                                                              local_name{std::move(other.local_name)} {
+    }
+
+    PrefixCompressedIRIBackend &operator=(PrefixCompressedIRIBackend &&other) noexcept {
+        std::swap(hash, other.hash);
+        std::swap(prefix, other.prefix);
+        swap(local_name, other.local_name);
+        return *this;
+    }
+
+    ~PrefixCompressedIRIBackend() {
+        if (prefix != nullptr) {
+            local_name.get_allocator().arena()->release_interned(prefix);
+        }
+    }
+
+    explicit operator view_type() const noexcept {
+        if (prefix == nullptr) {
+            return view_type{.identifier = local_name};
+        }
+
+        return view_type{.identifier = detail::reconstruct_iri(*prefix, local_name)};
+    }
+
+    /**
+     * Compares views and backends without reconstructing the IRI
+     */
+    struct equal {
+        using is_transparent = void;
+
+        [[nodiscard]] static bool eq(view_type const &view, PrefixCompressedIRIBackend const &backend) noexcept {
+            std::string_view const prefix = backend.prefix == nullptr ? std::string_view{} : std::string_view{*backend.prefix};
+            std::string_view const local_name = backend.local_name;
+
+            return view.identifier.size() == prefix.size() + local_name.size()
+                   && view.identifier.starts_with(prefix)
+                   && view.identifier.ends_with(local_name);
+        }
+
+        bool operator()(view_type const &lhs, PrefixCompressedIRIBackend const &rhs) const noexcept {
+            return eq(lhs, rhs);
+        }
+
+        bool operator()(PrefixCompressedIRIBackend const &lhs, view_type const &rhs) const noexcept {
+            return eq(rhs, lhs);
+        }
+    };
+
+    static identifier::NodeBackendID from_storage_id(id_type const id, [[maybe_unused]] view_type const view) noexcept {
+        return identifier::NodeBackendID{id, identifier::RDFNodeType::IRI};
+    }
+
+    static id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return id.node_id();
+    }
+};
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+
+#endif  //RDF4CPP_PREFIXCOMPRESSEDIRIBACKEND_HPP
@@ -0,0 +1,445 @@
+#include "ShardedReferenceNodeStorage.hpp"
+
+#include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+template<typename Tuple, size_t ...Ixs>
+static Tuple make_specialized_literal_storage(size_t const shard_count, std::index_sequence<Ixs...>) {
+    return Tuple{std::tuple_element_t<Ixs, Tuple>{shard_count, identifier::NodeID::min_literal_id}...};
+}
+
+size_t ShardedReferenceNodeStorage::default_shard_count() noexcept {
+    return std::bit_ceil(std::max(std::thread::hardware_concurrency(), 1U));
+}
+
+ShardedReferenceNodeStorage::ShardedReferenceNodeStorage(size_t const shard_count)
+    : bnode_storage_{shard_count, identifier::NodeID::min_bnode_id},
+      iri_storage_{shard_count, identifier::NodeID::min_iri_id},
+      variable_storage_{shard_count, identifier::NodeID::min_variable_id},
+      fallback_literal_storage_{shard_count, identifier::NodeID::min_literal_id},
+      specialized_literal_storage_{make_specialized_literal_storage<decltype(specialized_literal_storage_)>(shard_count, std::make_index_sequence<std::tuple_size_v<decltype(specialized_literal_storage_)>>{})} {
+
+    // some iri's like xsd:string are there by default
+    // they live outside of the shards, below NodeID::min_iri_id
+    reserved_iri_storage_.mapping.reserve_until(identifier::NodeID::min_iri_id);
+    for (const auto &[iri, literal_type] : datatypes::registry::reserved_datatype_ids) {
+        auto const id = literal_type.to_underlying();
+        reserved_iri_storage_.mapping.insert_assume_not_present_at(view::IRIBackendView{.identifier = iri}, identifier::NodeID{id});
+    }
+}
+
+size_t ShardedReferenceNodeStorage::shard_count() const noexcept {
+    return iri_storage_.shard_count();
+}
+
+template<typename Backend>
+static size_t storage_size(ShardedNodeTypeStorage<Backend> const &storage) noexcept {
+    size_t size = 0;
+    for (size_t shard_ix = 0; shard_ix < storage.shard_count(); ++shard_ix) {
+        auto const &shard = storage.shard(shard_ix);
+
+        std::shared_lock<std::shared_mutex> l{shard.mutex};
+        size += shard.mapping.size();
+    }
+    return size;
+}
+
+size_t ShardedReferenceNodeStorage::size() const noexcept {
+    return reserved_iri_storage_.mapping.size() +
+           storage_size(iri_storage_) +
+           storage_size(bnode_storage_) +
+           storage_size(variable_storage_) +
+           storage_size(fallback_literal_storage_) +
+           dice::template_library::tuple_fold(specialized_literal_storage_, 0, [](auto acc, auto const &storage) noexcept {
+               return acc + storage_size(storage);
+           });
+}
+
+template<typename Backend>
+static void storage_shrink_to_fit(ShardedNodeTypeStorage<Backend> &storage) {
+    for (size_t shard_ix = 0; shard_ix < storage.shard_count(); ++shard_ix) {
+        auto &shard = storage.shard(shard_ix);
+
+        std::unique_lock<std::shared_mutex> l{shard.mutex};
+        shard.shrink_to_fit();
+    }
+}
+
+void ShardedReferenceNodeStorage::shrink_to_fit() {
+    storage_shrink_to_fit(iri_storage_);
+    storage_shrink_to_fit(bnode_storage_);
+    storage_shrink_to_fit(variable_storage_);
+    storage_shrink_to_fit(fallback_literal_storage_);
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [](auto &storage) {
+        storage_shrink_to_fit(storage);
+    });
+}
+
+NodeStorageStats ShardedReferenceNodeStorage::stats() const {
+    NodeStorageStats ret{.iris = reserved_iri_storage_.stats(),
+                         .bnodes = bnode_storage_.stats(),
+                         .variables = variable_storage_.stats(),
+                         .lexical_literals = fallback_literal_storage_.stats()};
+
+    ret.iris += iri_storage_.stats();
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&ret](auto const &storage) {
+        ret.specialized_literals += storage.stats();
+    });
+
+    return ret;
+}
+
+bool ShardedReferenceNodeStorage::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
+    static constexpr auto specialization_lut = specialization_detail::make_storage_specialization_lut<decltype(specialized_literal_storage_)>();
+    return specialization_lut[datatype.to_underlying()];
+}
+
+namespace {
+
+/**
+ * Lookup function for node types without reserved ids
+ */
+struct NoReservedIds {
+    template<typename View>
+    std::nullopt_t operator()([[maybe_unused]] View const &view) const noexcept {
+        return std::nullopt;
+    }
+};
+
+}  // namespace
+
+/**
+ * Synchronized lookup (and creation) of IDs by a provided view of a Node Backend.
+ * Only the shard responsible for the view is locked.
+ *
+ * @tparam create_if_not_present enables code for creating non-existing Node Backends
+ * @param view contains the data of the requested Node Backend
+ * @param storage the storage where the Node Backend is looked up
+ * @param lookup_reserved lookup of reserved ids that live outside of storage, only consulted if view is not in storage
+ * @return the NodeID for the looked up Node Backend. Result is the null-id if there was no matching Node Backend.
+ */
+template<bool create_if_not_present, typename Storage, typename LookupReserved = NoReservedIds>
+static identifier::NodeBackendID lookup_or_insert_impl(typename Storage::backend_view_type const &view,
+                                                       Storage &storage,
+                                                       LookupReserved const &lookup_reserved = {}) noexcept(!create_if_not_present) {
+    using backend_id_type = typename Storage::backend_id_type;
+
+    auto const hash = typename Storage::backend_hasher{}(view);
+    auto const shard_ix = storage.shard_index_of_hash(hash);
+    auto &shard = storage.shard(shard_ix);
+
+    {
+        auto lock = shard.lock_shared();
+        if (auto const id = shard.mapping.lookup_id(view, hash); id != backend_id_type{}) {
+            shard.counters.hit();
+            return Storage::from_storage_id(storage.to_global_id(shard_ix, id), view);
+        }
+    }
+
+    // reserved ids are never inserted into a shard, so they need to be checked before inserting
+    if (std::optional<backend_id_type> const id = lookup_reserved(view); id.has_value()) {
+        return Storage::from_storage_id(*id, view);
+    }
+
+    shard.counters.miss();
+
+    if constexpr (!create_if_not_present) {
+        return identifier::NodeBackendID{};
+    } else {
+        auto lock = shard.lock_unique();
+
+        // check again, might have changed between unlocking of shared_lock and locking of unique_lock
+        if (auto const id = shard.mapping.lookup_id(view, hash); id != backend_id_type{}) {
+            return Storage::from_storage_id(storage.to_global_id(shard_ix, id), view);
+        }
+
+        auto const id = storage.insert_assume_not_present(shard_ix, view, hash);
+        shard.counters.insert();
+        return Storage::from_storage_id(id, view);
+    }
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_or_make_id(view::LiteralBackendView const &view) {
+    return view.visit(
+            [this](view::LexicalFormLiteralBackendView const &lexical) {
+                assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
+                return lookup_or_insert_impl<true>(lexical, this->fallback_literal_storage_);
+            },
+            [this](view::ValueLiteralBackendView const &any) {
+                assert(has_specialized_storage_for(any.datatype));
+                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any](auto &storage) {
+                    return lookup_or_insert_impl<true>(any, storage);
+                });
+            });
+}
+
+std::optional<identifier::NodeID> ShardedReferenceNodeStorage::find_reserved_iri_id(view::IRIBackendView const &view) const noexcept {
+    if (auto const id = reserved_iri_storage_.mapping.lookup_id(view); id != identifier::NodeID{}) {
+        return id;
+    }
+    return std::nullopt;
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_or_make_id(view::IRIBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, iri_storage_, [this](view::IRIBackendView const &iri) noexcept {
+        return this->find_reserved_iri_id(iri);
+    });
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_or_make_id(view::BNodeBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, bnode_storage_);
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_or_make_id(view::VariableBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, variable_storage_);
+}
+
+/**
+ * Number of views processed at once by lookup_or_insert_batch_impl
+ */
+static constexpr size_t batch_block_size = 256;
+
+/**
+ * Synchronized batch lookup and creation of IDs for a range of views of Node Backends.
+ * The views of a block are hashed and grouped by shard before locking, then every involved shard is locked once per block.
+ *
+ * @param views contains the data of the requested Node Backends
+ * @param ids output, ids[ix] is set to the NodeID of views[ix]
+ * @param storage the storage where the Node Backends are looked up
+ * @param lookup_reserved lookup of reserved ids that live outside of storage, only consulted for views that are not in storage
+ */
+template<typename Storage, typename LookupReserved = NoReservedIds>
+static void lookup_or_insert_batch_impl(std::span<typename Storage::backend_view_type const> const views,
+                                        std::span<identifier::NodeBackendID> const ids,
+                                        Storage &storage,
+                                        LookupReserved const &lookup_reserved = {}) {
+    using backend_id_type = typename Storage::backend_id_type;
+
+    struct Entry {
+        size_t shard_ix;
+        size_t hash;
+        size_t ix; //< index into views and ids
+    };
+
+    assert(views.size() == ids.size());
+
+    std::array<Entry, batch_block_size> entries;
+
+    for (size_t block_begin = 0; block_begin < views.size(); block_begin += batch_block_size) {
+        auto const block_size = std::min(batch_block_size, views.size() - block_begin);
+        auto const block = std::span{entries}.first(block_size);
+
+        for (size_t off = 0; off < block_size; ++off) {
+            auto const hash = typename Storage::backend_hasher{}(views[block_begin + off]);
+            block[off] = Entry{.shard_ix = storage.shard_index_of_hash(hash), .hash = hash, .ix = block_begin + off};
+        }
+
+        std::ranges::sort(block, std::ranges::less{}, &Entry::shard_ix);
+
+        for (auto run_begin = block.begin(); run_begin != block.end();) {
+            auto const shard_ix = run_begin->shard_ix;
+            auto const run_end = std::ranges::find_if(run_begin, block.end(), [shard_ix](Entry const &e) noexcept { return e.shard_ix != shard_ix; });
+            auto const run = std::ranges::subrange(run_begin, run_end);
+            run_begin = run_end;
+
+            auto &shard = storage.shard(shard_ix);
+            bool any_missing = false;
+
+            {
+                auto lock = shard.lock_shared();
+                for (auto const &e : run) {
+                    if (auto const id = shard.mapping.lookup_id(views[e.ix], e.hash); id != backend_id_type{}) {
+                        shard.counters.hit();
+                        ids[e.ix] = Storage::from_storage_id(storage.to_global_id(shard_ix, id), views[e.ix]);
+                    } else {
+                        ids[e.ix] = identifier::NodeBackendID{};
+                        any_missing = true;
+                    }
+                }
+            }
+
+            if (!any_missing) {
+                continue;
+            }
+
+            // reserved ids are never inserted into a shard, so they need to be checked before inserting
+            any_missing = false;
+            for (auto const &e : run) {
+                if (!ids[e.ix].null()) {
+                    continue;
+                }
+
+                if (std::optional<backend_id_type> const id = lookup_reserved(views[e.ix]); id.has_value()) {
+                    ids[e.ix] = Storage::from_storage_id(*id, views[e.ix]);
+                } else {
+                    shard.counters.miss();
+                    any_missing = true;
+                }
+            }
+
+            if (!any_missing) {
+                continue;
+            }
+
+            auto lock = shard.lock_unique();
+            for (auto const &e : run) {
+                if (!ids[e.ix].null()) {
+                    continue;
+                }
+
+                // check again, might have changed between unlocking of shared_lock and locking of unique_lock
+                // or might have been inserted by an earlier view in the same block
+                if (auto const id = shard.mapping.lookup_id(views[e.ix], e.hash); id != backend_id_type{}) {
+                    ids[e.ix] = Storage::from_storage_id(storage.to_global_id(shard_ix, id), views[e.ix]);
+                } else {
+                    ids[e.ix] = Storage::from_storage_id(storage.insert_assume_not_present(shard_ix, views[e.ix], e.hash), views[e.ix]);
+                    shard.counters.insert();
+                }
+            }
+        }
+    }
+}
+
+void ShardedReferenceNodeStorage::find_or_make_ids(std::span<view::BNodeBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, bnode_storage_);
+}
+
+void ShardedReferenceNodeStorage::find_or_make_ids(std::span<view::IRIBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, iri_storage_, [this](view::IRIBackendView const &iri) noexcept {
+        return this->find_reserved_iri_id(iri);
+    });
+}
+
+void ShardedReferenceNodeStorage::find_or_make_ids(std::span<view::VariableBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, variable_storage_);
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_id(view::BNodeBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, bnode_storage_);
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_id(view::IRIBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, iri_storage_, [this](view::IRIBackendView const &iri) noexcept {
+        return this->find_reserved_iri_id(iri);
+    });
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_id(view::LiteralBackendView const &view) const noexcept {
+    return view.visit(
+            [this](view::LexicalFormLiteralBackendView const &lexical) noexcept {
+                assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
+                return lookup_or_insert_impl<false>(lexical, this->fallback_literal_storage_);
+            },
+            [this](view::ValueLiteralBackendView const &any) noexcept {
+                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any](auto const &storage) noexcept {
+                    assert(has_specialized_storage_for(any.datatype));
+                    return lookup_or_insert_impl<false>(any, storage);
+                });
+            });
+}
+
+identifier::NodeBackendID ShardedReferenceNodeStorage::find_id(view::VariableBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, variable_storage_);
+}
+
+/**
+ * Lookup of a Node Backend by its id.
+ * Locks the shared mutex of the responsible shard, see SyncNodeTypeStorage::lookup_value.
+ */
+template<typename Storage>
+static typename Storage::backend_view_type find_backend_view(Storage &storage, identifier::NodeBackendID const id) noexcept {
+    auto const [shard_ix, local_id] = storage.to_local_id(Storage::to_storage_id(id));
+    auto const &shard = storage.shard(shard_ix);
+
+    if (auto view = shard.lookup_value(local_id); view.has_value()) {
+        return *view;
+    } else {
+        assert(false); // assert in debug build; not critical error but should not happen
+        return Storage::get_default_view();
+    }
+}
+
+view::IRIBackendView ShardedReferenceNodeStorage::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+    if (id.node_id() < identifier::NodeID::min_iri_id) {
+        auto const view = reserved_iri_storage_.mapping.lookup_value(id.node_id());
+        assert(view.has_value());
+        return *view;
+    }
+
+    return find_backend_view(iri_storage_, id);
+}
+
+view::LiteralBackendView ShardedReferenceNodeStorage::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+    if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
+        return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto const &storage) noexcept {
+            return find_backend_view(storage, id);
+        });
+    }
+
+    return find_backend_view(fallback_literal_storage_, id);
+}
+
+view::BNodeBackendView ShardedReferenceNodeStorage::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+    return find_backend_view(bnode_storage_, id);
+}
+
+view::VariableBackendView ShardedReferenceNodeStorage::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+    return find_backend_view(variable_storage_, id);
+}
+
+template<typename Storage>
+static bool erase_impl(Storage &storage, identifier::NodeBackendID const id) {
+    auto const [shard_ix, local_id] = storage.to_local_id(Storage::to_storage_id(id));
+    auto &shard = storage.shard(shard_ix);
+
+    std::unique_lock lock{shard.mutex};
+
+    if (!shard.mapping.lookup_value(local_id).has_value()) {
+        return false;
+    }
+
+    shard.mapping.erase_assume_present(local_id);
+    return true;
+}
+
+bool ShardedReferenceNodeStorage::erase_iri(identifier::NodeBackendID const id) {
+    // check predefined IRIs
+    if (identifier::iri_node_id_to_literal_type(id).is_fixed()) {
+        return false;
+    }
+
+    return erase_impl(iri_storage_, id);
+}
+
+bool ShardedReferenceNodeStorage::erase_literal(identifier::NodeBackendID const id) {
+    if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
+        return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto &storage) noexcept {
+            return erase_impl(storage, id);
+        });
+    }
+
+    return erase_impl(fallback_literal_storage_, id);
+}
+
+bool ShardedReferenceNodeStorage::erase_bnode(identifier::NodeBackendID const id) {
+    return erase_impl(bnode_storage_, id);
+}
+
+bool ShardedReferenceNodeStorage::erase_variable(identifier::NodeBackendID const id) {
+    return erase_impl(variable_storage_, id);
+}
+
+}  // namespace rdf4cpp::storage::reference_node_storage
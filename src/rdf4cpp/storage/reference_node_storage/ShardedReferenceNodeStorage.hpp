@@ -0,0 +1,132 @@
+#ifndef RDF4CPP_SHARDEDREFERENCENODESTORAGE_HPP
+#define RDF4CPP_SHARDEDREFERENCENODESTORAGE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <tuple>
+
+#include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/storage/NodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/BNodeBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/FallbackLiteralBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/IRIBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SpecializedLiteralBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/VariableBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/ShardedNodeTypeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/UnsyncNodeTypeStorage.hpp>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+/**
+ * Thread-safe reference implementation of a INodeStorageBackend that scales to many concurrently interning threads.
+ *
+ * In contrast to SyncReferenceNodeStorage, which guards each node type with a single mutex,
+ * every node type is split into a number of independently locked shards (see ShardedNodeTypeStorage).
+ * Each shard owns a disjoint sub-range of the ids, so ids stay unique across shards without any coordination.
+ * The ids handed out are therefore not dense, but they are as stable as the ones of SyncReferenceNodeStorage.
+ */
+struct ShardedReferenceNodeStorage {
+private:
+    // the reserved datatype IRIs are never modified after construction, therefore they do not need synchronization
+    UnsyncNodeTypeStorage<IRIBackend> reserved_iri_storage_;
+    ShardedNodeTypeStorage<BNodeBackend> bnode_storage_;
+    ShardedNodeTypeStorage<IRIBackend> iri_storage_;
+    ShardedNodeTypeStorage<VariableBackend> variable_storage_;
+
+    ShardedNodeTypeStorage<FallbackLiteralBackend> fallback_literal_storage_;
+
+    template<typename Datatype>
+    using specialized_literal_storage = ShardedNodeTypeStorage<SpecializedLiteralBackend<Datatype>>;
+
+    specialization_detail::specialized_storage_tuple<specialized_literal_storage> specialized_literal_storage_;
+
+    [[nodiscard]] std::optional<identifier::NodeID> find_reserved_iri_id(view::IRIBackendView const &view) const noexcept;
+
+public:
+    /**
+     * @return the number of shards used by default, i.e. the number of hardware threads rounded up to the next power of two
+     */
+    [[nodiscard]] static size_t default_shard_count() noexcept;
+
+    /**
+     * @param shard_count number of shards per node type, must be at least 1
+     */
+    explicit ShardedReferenceNodeStorage(size_t shard_count = default_shard_count());
+
+    [[nodiscard]] size_t shard_count() const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept;
+    void shrink_to_fit();
+
+    /**
+     * @return statistics per node type, summed up over all shards.
+     *      The lookup and lock counters are only collected if RDF4CPP_NODE_STORAGE_STATS is defined
+     */
+    [[nodiscard]] NodeStorageStats stats() const;
+
+    [[nodiscard]] static bool has_specialized_storage_for(identifier::LiteralType datatype) noexcept;
+
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::IRIBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::LiteralBackendView const &view);
+    [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::VariableBackendView const &view);
+
+    /**
+     * Batch versions of find_or_make_id, see NodeStorageWithBatchFindOrMakeId.
+     * Literals are not supported in batches, because they are spread over multiple storages.
+     */
+    void find_or_make_ids(std::span<view::BNodeBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void find_or_make_ids(std::span<view::IRIBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void find_or_make_ids(std::span<view::VariableBackendView const> views, std::span<identifier::NodeBackendID> ids);
+
+    [[nodiscard]] identifier::NodeBackendID find_id(view::BNodeBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::LiteralBackendView const &view) const noexcept;
+    [[nodiscard]] identifier::NodeBackendID find_id(view::VariableBackendView const &view) const noexcept;
+
+    [[nodiscard]] view::IRIBackendView find_iri_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::LiteralBackendView find_literal_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::BNodeBackendView find_bnode_backend(identifier::NodeBackendID id) const noexcept;
+    [[nodiscard]] view::VariableBackendView find_variable_backend(identifier::NodeBackendID id) const noexcept;
+
+    bool erase_iri(identifier::NodeBackendID id);
+    bool erase_literal(identifier::NodeBackendID id);
+    bool erase_bnode(identifier::NodeBackendID id);
+    bool erase_variable(identifier::NodeBackendID id);
+
+    /**
+     * Calls f(id, view) for every node in this storage, e.g. to build a FrozenNodeStorage from it.
+     * The view is one of the backend view types, for literals either view::LexicalFormLiteralBackendView or view::ValueLiteralBackendView.
+     * Each shard is locked while it is visited, f must not call back into this storage.
+     */
+    template<typename F>
+    void for_each_node(F &&f) const {
+        reserved_iri_storage_.mapping.for_each([&f](auto const id, auto const &view) {
+            f(IRIBackend::from_storage_id(id, view), view);
+        });
+
+        auto visit_storage = [&f]<typename Storage>(Storage const &storage) {
+            for (size_t shard_ix = 0; shard_ix < storage.shard_count(); ++shard_ix) {
+                auto const &shard = storage.shard(shard_ix);
+
+                std::shared_lock lock{shard.mutex};
+                shard.mapping.for_each([&](auto const id, auto const &view) {
+                    f(Storage::from_storage_id(storage.to_global_id(shard_ix, id), view), view);
+                });
+            }
+        };
+
+        visit_storage(bnode_storage_);
+        visit_storage(iri_storage_);
+        visit_storage(variable_storage_);
+        visit_storage(fallback_literal_storage_);
+        dice::template_library::tuple_for_each(specialized_literal_storage_, visit_storage);
+    }
+};
+static_assert(NodeStorage<ShardedReferenceNodeStorage>);
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+#endif  //RDF4CPP_SHARDEDREFERENCENODESTORAGE_HPP
@@ -1,11 +1,20 @@
 #include "SyncReferenceNodeStorage.hpp"
 
 #include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/NodeStorageSnapshot.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
 namespace rdf4cpp::storage::reference_node_storage {
 
-SyncReferenceNodeStorage::SyncReferenceNodeStorage() noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::BasicSyncReferenceNodeStorage() noexcept {
     iri_storage_.mapping.reserve_until(identifier::NodeID::min_iri_id);
     bnode_storage_.mapping.reserve_until(identifier::NodeID::min_bnode_id);
     variable_storage_.mapping.reserve_until(identifier::NodeID::min_variable_id);
@@ -22,13 +31,32 @@ SyncReferenceNodeStorage::SyncReferenceNodeStorage() noexcept {
     }
 }
 
-template<typename Backend>
-static size_t storage_size(SyncNodeTypeStorage<Backend> const &storage) noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::BasicSyncReferenceNodeStorage(NegativeLookupFilterOptions const &options) : BasicSyncReferenceNodeStorage{} {
+    auto enable_filter = [&options]<typename Storage>(Storage &storage) {
+        storage.negative_lookup_filter.emplace(options.expected_nodes, options.false_positive_rate);
+
+        // e.g. the predefined IRIs
+        storage.mapping.for_each([&storage](auto, auto const &view) noexcept {
+            storage.negative_lookup_filter->insert(typename Storage::backend_hasher{}(view));
+        });
+    };
+
+    enable_filter(iri_storage_);
+    enable_filter(bnode_storage_);
+    enable_filter(variable_storage_);
+    enable_filter(fallback_literal_storage_);
+    dice::template_library::tuple_for_each(specialized_literal_storage_, enable_filter);
+}
+
+template<typename Storage>
+static size_t storage_size(Storage const &storage) noexcept {
     std::shared_lock<std::shared_mutex> l{storage.mutex};
     return storage.mapping.size();
 }
 
-size_t SyncReferenceNodeStorage::size() const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+size_t BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::size() const noexcept {
     return storage_size(iri_storage_) +
            storage_size(bnode_storage_) +
            storage_size(variable_storage_) +
@@ -38,13 +66,14 @@ size_t SyncReferenceNodeStorage::size() const noexcept {
            });
 }
 
-template<typename Backend>
-static void storage_shrink_to_fit(SyncNodeTypeStorage<Backend> &storage) {
+template<typename Storage>
+static void storage_shrink_to_fit(Storage &storage) {
     std::unique_lock<std::shared_mutex> l{storage.mutex};
-    storage.mapping.shrink_to_fit();
+    storage.shrink_to_fit();
 }
 
-void SyncReferenceNodeStorage::shrink_to_fit() {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::shrink_to_fit() {
     storage_shrink_to_fit(iri_storage_);
     storage_shrink_to_fit(bnode_storage_);
     storage_shrink_to_fit(variable_storage_);
@@ -55,7 +84,22 @@ void SyncReferenceNodeStorage::shrink_to_fit() {
     });
 }
 
-bool SyncReferenceNodeStorage::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+NodeStorageStats BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::stats() const {
+    NodeStorageStats ret{.iris = iri_storage_.stats(),
+                         .bnodes = bnode_storage_.stats(),
+                         .variables = variable_storage_.stats(),
+                         .lexical_literals = fallback_literal_storage_.stats()};
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&ret](auto const &storage) {
+        ret.specialized_literals += storage.stats();
+    });
+
+    return ret;
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+bool BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
     static constexpr auto specialization_lut = specialization_detail::make_storage_specialization_lut<decltype(specialized_literal_storage_)>();
     return specialization_lut[datatype.to_underlying()];
 }
@@ -65,91 +109,217 @@ bool SyncReferenceNodeStorage::has_specialized_storage_for(identifier::LiteralTy
  * @tparam create_if_not_present enables code for creating non-existing Node Backends
  * @param view contains the data of the requested Node Backend
  * @param storage the storage where the Node Backend is looked up
+ * @param tracker if not nullptr, the found or created Node Backend is marked as used in its current epoch
  * @return the NodeID for the looked up Node Backend. Result is the null-id if there was no matching Node Backend.
  */
 template<bool create_if_not_present, typename Storage>
 static identifier::NodeBackendID lookup_or_insert_impl(typename Storage::backend_view_type const &view,
-                                                       Storage &storage) noexcept(!create_if_not_present) {
-
-    {
-        std::shared_lock lock{storage.mutex};
-        if (auto const id = storage.mapping.lookup_id(view); id != typename Storage::backend_id_type{}) {
+                                                       Storage &storage,
+                                                       detail::EpochTracker const *tracker) noexcept(!create_if_not_present) {
+
+    auto const hash = typename Storage::backend_hasher{}(view);
+
+    // a negative answer of the filter is definite, the shared lock can be skipped
+    if (storage.may_contain(hash)) {
+        auto lock = storage.lock_shared();
+        if (auto const id = storage.mapping.lookup_id(view, hash); id != typename Storage::backend_id_type{}) {
+            storage.counters.hit();
+            if (tracker != nullptr) {
+                storage.mark_used(id, tracker->current());
+            }
             return Storage::from_storage_id(id, view);
         }
     }
 
+    storage.counters.miss();
+
     if constexpr (!create_if_not_present) {
         return identifier::NodeBackendID{};
     } else {
-        std::unique_lock lock{storage.mutex};
+        auto lock = storage.lock_unique();
 
         // check again, might have changed between unlocking of shared_lock and locking of unique_lock
-        if (auto const id = storage.mapping.lookup_id(view); id != typename Storage::backend_id_type{}) {
-            return Storage::from_storage_id(id, view);
+        auto id = storage.mapping.lookup_id(view, hash);
+        if (id == typename Storage::backend_id_type{}) {
+            id = storage.insert_assume_not_present(view, hash);
+            storage.counters.insert();
         }
 
-        auto const id = storage.mapping.insert_assume_not_present(view);
+        if (tracker != nullptr) {
+            storage.mark_used_growing(id, tracker->current());
+        }
         return Storage::from_storage_id(id, view);
     }
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_or_make_id(view::LiteralBackendView const &view) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_id(view::LiteralBackendView const &view) {
+    auto const *tracker = epoch_tracker_.load(std::memory_order_acquire);
+
     return view.visit(
-            [this](view::LexicalFormLiteralBackendView const &lexical) {
+            [this, tracker](view::LexicalFormLiteralBackendView const &lexical) {
                 assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
-                return lookup_or_insert_impl<true>(lexical, this->fallback_literal_storage_);
+                return lookup_or_insert_impl<true>(lexical, this->fallback_literal_storage_, tracker);
             },
-            [this](view::ValueLiteralBackendView const &any) {
+            [this, tracker](view::ValueLiteralBackendView const &any) {
                 assert(has_specialized_storage_for(any.datatype));
-                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any](auto &storage) {
-                    return lookup_or_insert_impl<true>(any, storage);
+                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any, tracker](auto &storage) {
+                    return lookup_or_insert_impl<true>(any, storage, tracker);
                 });
             });
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_or_make_id(view::IRIBackendView const &view) {
-    return lookup_or_insert_impl<true>(view, iri_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_id(view::IRIBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, iri_storage_, epoch_tracker_.load(std::memory_order_acquire));
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_id(view::BNodeBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, bnode_storage_, epoch_tracker_.load(std::memory_order_acquire));
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_id(view::VariableBackendView const &view) {
+    return lookup_or_insert_impl<true>(view, variable_storage_, epoch_tracker_.load(std::memory_order_acquire));
+}
+
+/**
+ * Number of views processed per critical section by lookup_or_insert_batch_impl
+ */
+static constexpr size_t batch_block_size = 256;
+
+/**
+ * Synchronized batch lookup and creation of IDs for a range of views of Node Backends.
+ * The hashes of a block of views are calculated before locking, and the locks are taken once per block instead of once per view.
+ *
+ * @param views contains the data of the requested Node Backends
+ * @param ids output, ids[ix] is set to the NodeID of views[ix]
+ * @param storage the storage where the Node Backends are looked up
+ * @param tracker if not nullptr, the found or created Node Backends are marked as used in its current epoch
+ */
+template<typename Storage>
+static void lookup_or_insert_batch_impl(std::span<typename Storage::backend_view_type const> const views,
+                                        std::span<identifier::NodeBackendID> const ids,
+                                        Storage &storage,
+                                        detail::EpochTracker const *tracker) {
+    using backend_id_type = typename Storage::backend_id_type;
+
+    assert(views.size() == ids.size());
+
+    std::array<size_t, batch_block_size> hashes;
+
+    for (size_t block_begin = 0; block_begin < views.size(); block_begin += batch_block_size) {
+        auto const block_end = std::min(block_begin + batch_block_size, views.size());
+
+        for (auto ix = block_begin; ix < block_end; ++ix) {
+            hashes[ix - block_begin] = typename Storage::backend_hasher{}(views[ix]);
+        }
+
+        bool any_missing = false;
+
+        {
+            auto lock = storage.lock_shared();
+            for (auto ix = block_begin; ix < block_end; ++ix) {
+                if (!storage.may_contain(hashes[ix - block_begin])) {
+                    storage.counters.miss();
+                    ids[ix] = identifier::NodeBackendID{};
+                    any_missing = true;
+                } else if (auto const id = storage.mapping.lookup_id(views[ix], hashes[ix - block_begin]); id != backend_id_type{}) {
+                    storage.counters.hit();
+                    if (tracker != nullptr) {
+                        storage.mark_used(id, tracker->current());
+                    }
+                    ids[ix] = Storage::from_storage_id(id, views[ix]);
+                } else {
+                    storage.counters.miss();
+                    ids[ix] = identifier::NodeBackendID{};
+                    any_missing = true;
+                }
+            }
+        }
+
+        if (!any_missing) {
+            continue;
+        }
+
+        auto lock = storage.lock_unique();
+        for (auto ix = block_begin; ix < block_end; ++ix) {
+            if (!ids[ix].null()) {
+                continue;
+            }
+
+            // check again, might have changed between unlocking of shared_lock and locking of unique_lock
+            // or might have been inserted by an earlier view in the same block
+            auto id = storage.mapping.lookup_id(views[ix], hashes[ix - block_begin]);
+            if (id == backend_id_type{}) {
+                id = storage.insert_assume_not_present(views[ix], hashes[ix - block_begin]);
+                storage.counters.insert();
+            }
+
+            if (tracker != nullptr) {
+                storage.mark_used_growing(id, tracker->current());
+            }
+
+            ids[ix] = Storage::from_storage_id(id, views[ix]);
+        }
+    }
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_ids(std::span<view::BNodeBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, bnode_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_or_make_id(view::BNodeBackendView const &view) {
-    return lookup_or_insert_impl<true>(view, bnode_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_ids(std::span<view::IRIBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, iri_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_or_make_id(view::VariableBackendView const &view) {
-    return lookup_or_insert_impl<true>(view, variable_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_or_make_ids(std::span<view::VariableBackendView const> const views, std::span<identifier::NodeBackendID> const ids) {
+    lookup_or_insert_batch_impl(views, ids, variable_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_id(view::BNodeBackendView const &view) const noexcept {
-    return lookup_or_insert_impl<false>(view, bnode_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_id(view::BNodeBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, bnode_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_id(view::IRIBackendView const &view) const noexcept {
-    return lookup_or_insert_impl<false>(view, iri_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_id(view::IRIBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, iri_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_id(view::LiteralBackendView const &view) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_id(view::LiteralBackendView const &view) const noexcept {
+    auto const *tracker = epoch_tracker_.load(std::memory_order_acquire);
+
     return view.visit(
-            [this](view::LexicalFormLiteralBackendView const &lexical) noexcept {
+            [this, tracker](view::LexicalFormLiteralBackendView const &lexical) noexcept {
                 assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
-                return lookup_or_insert_impl<false>(lexical, this->fallback_literal_storage_);
+                return lookup_or_insert_impl<false>(lexical, this->fallback_literal_storage_, tracker);
             },
-            [this](view::ValueLiteralBackendView const &any) noexcept {
-                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any](auto const &storage) noexcept {
+            [this, tracker](view::ValueLiteralBackendView const &any) noexcept {
+                return specialization_detail::visit_specialized(this->specialized_literal_storage_, any.datatype, [&any, tracker](auto const &storage) noexcept {
                     assert(has_specialized_storage_for(any.datatype));
-                    return lookup_or_insert_impl<false>(any, storage);
+                    return lookup_or_insert_impl<false>(any, storage, tracker);
                 });
             });
 }
 
-identifier::NodeBackendID SyncReferenceNodeStorage::find_id(view::VariableBackendView const &view) const noexcept {
-    return lookup_or_insert_impl<false>(view, variable_storage_);
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+identifier::NodeBackendID BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_id(view::VariableBackendView const &view) const noexcept {
+    return lookup_or_insert_impl<false>(view, variable_storage_, epoch_tracker_.load(std::memory_order_acquire));
 }
 
+/**
+ * Lookup of a Node Backend by its id.
+ * Only locks storage.mutex if the storage does not have lock-free reads, see SyncNodeTypeStorage::lookup_value.
+ */
 template<typename Storage>
 static typename Storage::backend_view_type find_backend_view(Storage &storage, identifier::NodeBackendID const id) noexcept {
-    std::shared_lock<std::shared_mutex> shared_lock{storage.mutex};
-
-    if (auto view = storage.mapping.lookup_value(Storage::to_storage_id(id)); view.has_value()) {
+    if (auto view = storage.lookup_value(Storage::to_storage_id(id)); view.has_value()) {
         return *view;
     } else {
         assert(false); // assert in debug build; not critical error but should not happen
@@ -157,11 +327,13 @@ static typename Storage::backend_view_type find_backend_view(Storage &storage, i
     }
 }
 
-view::IRIBackendView SyncReferenceNodeStorage::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+view::IRIBackendView BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(iri_storage_, id);
 }
 
-view::LiteralBackendView SyncReferenceNodeStorage::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+view::LiteralBackendView BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
     if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
         return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto const &storage) noexcept {
             return find_backend_view(storage, id);
@@ -171,17 +343,24 @@ view::LiteralBackendView SyncReferenceNodeStorage::find_literal_backend(identifi
     return find_backend_view(fallback_literal_storage_, id);
 }
 
-view::BNodeBackendView SyncReferenceNodeStorage::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+view::BNodeBackendView BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(bnode_storage_, id);
 }
 
-view::VariableBackendView SyncReferenceNodeStorage::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+view::VariableBackendView BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(variable_storage_, id);
 }
 
 template<typename Storage>
 static bool erase_impl(Storage &storage, identifier::NodeBackendID const id) {
-    std::unique_lock lock{storage.mutex};
+    if constexpr (Storage::lock_free_reads) {
+        // lock-free readers might be accessing the node at any time
+        return false;
+    }
+
+    auto lock = storage.lock_unique();
 
     auto const backend_id = Storage::to_storage_id(id);
     if (!storage.mapping.lookup_value(backend_id).has_value()) {
@@ -192,7 +371,8 @@ static bool erase_impl(Storage &storage, identifier::NodeBackendID const id) {
     return true;
 }
 
-bool SyncReferenceNodeStorage::erase_iri(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+bool BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::erase_iri(identifier::NodeBackendID const id) {
     // check predefined IRIs
     if (identifier::iri_node_id_to_literal_type(id).is_fixed()) {
         return false;
@@ -201,7 +381,8 @@ bool SyncReferenceNodeStorage::erase_iri(identifier::NodeBackendID const id) {
     return erase_impl(iri_storage_, id);
 }
 
-bool SyncReferenceNodeStorage::erase_literal(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+bool BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::erase_literal(identifier::NodeBackendID const id) {
     if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
         return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto &storage) noexcept {
             return erase_impl(storage, id);
@@ -211,12 +392,185 @@ bool SyncReferenceNodeStorage::erase_literal(identifier::NodeBackendID const id)
     return erase_impl(fallback_literal_storage_, id);
 }
 
-bool SyncReferenceNodeStorage::erase_bnode(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+bool BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::erase_bnode(identifier::NodeBackendID const id) {
     return erase_impl(bnode_storage_, id);
 }
 
-bool SyncReferenceNodeStorage::erase_variable(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+bool BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::erase_variable(identifier::NodeBackendID const id) {
     return erase_impl(variable_storage_, id);
 }
 
+template<typename Storage>
+static void start_tracking(Storage &storage, uint64_t const epoch) {
+    auto lock = storage.lock_unique();
+
+    for (size_t ix = 0; ix < storage.last_used.size(); ++ix) {
+        storage.last_used[ix].store(epoch, std::memory_order_relaxed);
+    }
+
+    while (storage.last_used.size() < storage.mapping.size()) {
+        storage.last_used.emplace_back(epoch);
+    }
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::track_epochs(detail::EpochTracker const *tracker) {
+    // publish the tracker first, so that nodes inserted concurrently are marked by the inserting thread
+    epoch_tracker_.store(tracker, std::memory_order_release);
+
+    if (tracker == nullptr) {
+        return;
+    }
+
+    auto const epoch = tracker->current();
+    start_tracking(iri_storage_, epoch);
+    start_tracking(bnode_storage_, epoch);
+    start_tracking(variable_storage_, epoch);
+    start_tracking(fallback_literal_storage_, epoch);
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [epoch](auto &storage) {
+        start_tracking(storage, epoch);
+    });
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::touch(identifier::NodeBackendID const id) const noexcept {
+    auto const *tracker = epoch_tracker_.load(std::memory_order_acquire);
+    if (tracker == nullptr || id.null() || id.is_inlined()) {
+        return;
+    }
+
+    auto const epoch = tracker->current();
+    auto mark = [id, epoch]<typename Storage>(Storage const &storage) noexcept {
+        storage.mark_used(Storage::to_storage_id(id), epoch);
+    };
+
+    if (id.is_iri()) {
+        mark(iri_storage_);
+    } else if (id.is_blank_node()) {
+        mark(bnode_storage_);
+    } else if (id.is_variable()) {
+        mark(variable_storage_);
+    } else if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
+        specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), mark);
+    } else {
+        mark(fallback_literal_storage_);
+    }
+}
+
+/**
+ * Number of nodes erased per critical section by sweep_impl
+ */
+static constexpr size_t sweep_block_size = 1024;
+
+/**
+ * Erases all nodes with an id of at least min_id from storage that were last used before safe_epoch.
+ * Candidates are collected while holding a shared lock, they are only rechecked and erased while holding the unique lock.
+ * Nodes that have no entry in last_used are kept, their usage is unknown.
+ *
+ * @return number of erased nodes
+ */
+template<typename Storage>
+static size_t sweep_impl(Storage &storage, uint64_t const safe_epoch, typename Storage::backend_id_type const min_id) {
+    using backend_id_type = typename Storage::backend_id_type;
+
+    auto const unused = [&storage, safe_epoch](backend_id_type const id) noexcept {
+        auto const ix = static_cast<size_t>(id.to_underlying()) - 1;
+        return ix < storage.last_used.size() && storage.last_used[ix].load(std::memory_order_relaxed) < safe_epoch;
+    };
+
+    std::vector<backend_id_type> candidates;
+    {
+        auto lock = storage.lock_shared();
+        storage.mapping.for_each([&](backend_id_type const id, auto const &) {
+            if (id.to_underlying() >= min_id.to_underlying() && unused(id)) {
+                candidates.push_back(id);
+            }
+        });
+    }
+
+    size_t erased = 0;
+    for (size_t block_begin = 0; block_begin < candidates.size(); block_begin += sweep_block_size) {
+        auto const block_end = std::min(block_begin + sweep_block_size, candidates.size());
+
+        auto lock = storage.lock_unique();
+        for (auto ix = block_begin; ix < block_end; ++ix) {
+            // check again, the node might have been used or erased (and its id reused) in the meantime
+            if (auto const id = candidates[ix]; storage.mapping.lookup_value(id).has_value() && unused(id)) {
+                storage.mapping.erase_assume_present(id);
+                ++erased;
+            }
+        }
+    }
+
+    return erased;
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+size_t BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::sweep(uint64_t const safe_epoch) {
+    if constexpr (LockFreeReads) {
+        // nodes are never erased, lock-free readers might be accessing them at any time
+        return 0;
+    }
+
+    size_t erased = 0;
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&erased, safe_epoch]<typename Storage>(Storage &storage) {
+        erased += sweep_impl(storage, safe_epoch, typename Storage::backend_id_type{});
+    });
+
+    erased += sweep_impl(fallback_literal_storage_, safe_epoch, identifier::LiteralID{});
+
+    {
+        // the remaining literals keep their datatype IRIs alive
+        auto lock = fallback_literal_storage_.lock_shared();
+        fallback_literal_storage_.mapping.for_each([this, safe_epoch](auto, view::LexicalFormLiteralBackendView const &view) noexcept {
+            iri_storage_.mark_used(decltype(iri_storage_)::to_storage_id(view.datatype_id), safe_epoch);
+        });
+    }
+
+    // the predefined datatype IRIs are never erased
+    erased += sweep_impl(iri_storage_, safe_epoch, identifier::NodeID::min_iri_id);
+    erased += sweep_impl(bnode_storage_, safe_epoch, identifier::NodeID{});
+    erased += sweep_impl(variable_storage_, safe_epoch, identifier::NodeID{});
+
+    return erased;
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t, bool LockFreeReads>
+void BasicSyncReferenceNodeStorage<IRIBackend_t, Allocator_t, LockFreeReads>::dump(std::ostream &out) const {
+    // all node types are locked at once (always in the same order), such that no literal refers to a datatype IRI that is missing in the snapshot
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(4 + std::tuple_size_v<decltype(specialized_literal_storage_)>);
+
+    locks.push_back(bnode_storage_.lock_shared());
+    locks.push_back(iri_storage_.lock_shared());
+    locks.push_back(variable_storage_.lock_shared());
+    locks.push_back(fallback_literal_storage_.lock_shared());
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&locks](auto const &storage) {
+        locks.push_back(storage.lock_shared());
+    });
+
+    detail::snapshot::write_header(out, 4 + std::tuple_size_v<decltype(specialized_literal_storage_)>);
+    detail::snapshot::write_section(out, detail::snapshot::tags::bnode, bnode_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::iri, iri_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::variable, variable_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::fallback_literal, fallback_literal_storage_);
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&out]<typename Storage>(Storage const &storage) {
+        detail::snapshot::write_section(out, detail::snapshot::tags::specialized_literal<Storage>, storage);
+    });
+
+    if (!out) {
+        throw std::runtime_error{"unable to write node storage snapshot"};
+    }
+}
+
+template struct BasicSyncReferenceNodeStorage<IRIBackend>;
+template struct BasicSyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+template struct BasicSyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+template struct BasicSyncReferenceNodeStorage<IRIBackend, std::allocator, true>;
+
 }  // namespace rdf4cpp::storage::reference_node_storage
@@ -1,57 +1,82 @@
 #ifndef RDF4CPP_SYNCREFERENCENODESTORAGE_HPP
 #define RDF4CPP_SYNCREFERENCENODESTORAGE_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <span>
 #include <tuple>
 
+#include <dice/template-library/tuple_algorithm.hpp>
 #include <rdf4cpp/storage/NodeStorage.hpp>
 #include <rdf4cpp/storage/reference_node_storage/BNodeBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/FallbackLiteralBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/IRIBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
+#include <rdf4cpp/storage/reference_node_storage/PrefixCompressedIRIBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/SpecializedLiteralBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/VariableBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/HugePageAllocator.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/EpochTracker.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/SyncNodeTypeStorage.hpp>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
+/**
+ * Configuration of the negative lookup filters of a BasicSyncReferenceNodeStorage, see detail::BloomFilter.
+ * The same configuration is used for the filter of every node type.
+ */
+struct NegativeLookupFilterOptions {
+    size_t expected_nodes = 1 << 20; //< number of nodes per node type the filters are sized for, more nodes increase the false-positive rate
+    double false_positive_rate = 0.01; //< targeted false-positive rate when expected_nodes nodes are present, must be in (0, 1)
+};
+
 /**
  * Thread-safe reference implementation of a INodeStorageBackend.
+ * @tparam IRIBackend_t backend type for IRIs, either IRIBackend or PrefixCompressedIRIBackend
+ * @tparam Allocator_t stateless allocator template for the dictionaries, either std::allocator or detail::HugePageAllocator
+ * @tparam LockFreeReads if true, find_*_backend do not take any lock (see SyncNodeTypeStorage).
+ *      In exchange, nodes are never erased: erase_* always return false and sweep never erases anything.
  */
-struct SyncReferenceNodeStorage {
+template<typename IRIBackend_t, template<typename> typename Allocator_t = std::allocator, bool LockFreeReads = false>
+struct BasicSyncReferenceNodeStorage {
 private:
-    SyncNodeTypeStorage<BNodeBackend> bnode_storage_;
-    SyncNodeTypeStorage<IRIBackend> iri_storage_;
-    SyncNodeTypeStorage<VariableBackend> variable_storage_;
-
-    SyncNodeTypeStorage<FallbackLiteralBackend> fallback_literal_storage_;
-
-    std::tuple<SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Integer>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NonNegativeInteger>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::PositiveInteger>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NonPositiveInteger>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NegativeInteger>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Long>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::UnsignedLong>>,
-
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Decimal>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Double>>,
-
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Base64Binary>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::HexBinary>>,
-
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Date>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DateTime>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DateTimeStamp>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::GYearMonth>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Duration>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DayTimeDuration>>,
-               SyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::YearMonthDuration>>> specialized_literal_storage_;
+    template<typename Backend>
+    using node_type_storage = SyncNodeTypeStorage<Backend, Allocator_t, LockFreeReads>;
+
+    node_type_storage<BNodeBackend> bnode_storage_;
+    node_type_storage<IRIBackend_t> iri_storage_;
+    node_type_storage<VariableBackend> variable_storage_;
+
+    node_type_storage<FallbackLiteralBackend> fallback_literal_storage_;
+
+    template<typename Datatype>
+    using specialized_literal_storage = node_type_storage<SpecializedLiteralBackend<Datatype>>;
+
+    specialization_detail::specialized_storage_tuple<specialized_literal_storage> specialized_literal_storage_;
+
+    std::atomic<detail::EpochTracker const *> epoch_tracker_ = nullptr; //< if not nullptr, every lookup records the current epoch of the tracker
 
 public:
-    SyncReferenceNodeStorage() noexcept;
+    BasicSyncReferenceNodeStorage() noexcept;
+
+    /**
+     * Creates a storage that keeps a Bloom filter per node type in front of find_id and find_or_make_id.
+     * Looking up nodes that are not present then usually does not need to take any lock,
+     * at the cost of a few memory accesses for every lookup and the filter memory.
+     */
+    explicit BasicSyncReferenceNodeStorage(NegativeLookupFilterOptions const &options);
 
     [[nodiscard]] size_t size() const noexcept;
     void shrink_to_fit();
 
+    /**
+     * @return statistics per node type, the lookup and lock counters are only collected if RDF4CPP_NODE_STORAGE_STATS is defined
+     */
+    [[nodiscard]] NodeStorageStats stats() const;
+
     [[nodiscard]] static bool has_specialized_storage_for(identifier::LiteralType datatype) noexcept;
 
     [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view);
@@ -59,6 +84,14 @@ public:
     [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::LiteralBackendView const &view);
     [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::VariableBackendView const &view);
 
+    /**
+     * Batch versions of find_or_make_id, see NodeStorageWithBatchFindOrMakeId.
+     * Literals are not supported in batches, because they are spread over multiple storages.
+     */
+    void find_or_make_ids(std::span<view::BNodeBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void find_or_make_ids(std::span<view::IRIBackendView const> views, std::span<identifier::NodeBackendID> ids);
+    void find_or_make_ids(std::span<view::VariableBackendView const> views, std::span<identifier::NodeBackendID> ids);
+
     [[nodiscard]] identifier::NodeBackendID find_id(view::BNodeBackendView const &view) const noexcept;
     [[nodiscard]] identifier::NodeBackendID find_id(view::IRIBackendView const &view) const noexcept;
     [[nodiscard]] identifier::NodeBackendID find_id(view::LiteralBackendView const &view) const noexcept;
@@ -73,9 +106,88 @@ public:
     bool erase_literal(identifier::NodeBackendID id);
     bool erase_bnode(identifier::NodeBackendID id);
     bool erase_variable(identifier::NodeBackendID id);
+
+    /**
+     * Starts (or stops if tracker is nullptr) recording in which epoch of tracker each node was last used.
+     * All nodes that are present when tracking starts are recorded as used in the current epoch.
+     * Used by NodeStorageCollector, there is usually no need to call this directly.
+     */
+    void track_epochs(detail::EpochTracker const *tracker);
+
+    /**
+     * Records that the given node is used in the current epoch. Does nothing if epochs are not tracked.
+     */
+    void touch(identifier::NodeBackendID id) const noexcept;
+
+    /**
+     * Erases all nodes that were last used before safe_epoch, except the predefined datatype IRIs
+     * and the datatype IRIs of the remaining literals. Erases nothing if LockFreeReads.
+     * The ids of the erased nodes are reused for new nodes.
+     * Used by NodeStorageCollector, there is usually no need to call this directly.
+     *
+     * @return number of erased nodes
+     */
+    size_t sweep(uint64_t safe_epoch);
+
+    /**
+     * Writes a binary snapshot of this storage to out, see detail/NodeStorageSnapshot.hpp for the format.
+     * The snapshot can be restored with BasicUnsyncReferenceNodeStorage::restore, in the same or in another process.
+     * All node types are locked shared while the snapshot is written, so it is consistent even if this storage is modified concurrently.
+     *
+     * @throws std::runtime_error if out fails
+     */
+    void dump(std::ostream &out) const;
+
+    /**
+     * Calls f(id, view) for every node in this storage, e.g. to build a FrozenNodeStorage from it.
+     * The view is one of the backend view types, for literals either view::LexicalFormLiteralBackendView or view::ValueLiteralBackendView.
+     * Each node type is locked while it is visited, f must not call back into this storage.
+     */
+    template<typename F>
+    void for_each_node(F &&f) const {
+        auto visit_storage = [&f]<typename Storage>(Storage const &storage) {
+            std::shared_lock lock{storage.mutex};
+            storage.mapping.for_each([&f](auto const id, auto const &view) {
+                f(Storage::from_storage_id(id, view), view);
+            });
+        };
+
+        visit_storage(bnode_storage_);
+        visit_storage(iri_storage_);
+        visit_storage(variable_storage_);
+        visit_storage(fallback_literal_storage_);
+        dice::template_library::tuple_for_each(specialized_literal_storage_, visit_storage);
+    }
 };
+
+extern template struct BasicSyncReferenceNodeStorage<IRIBackend>;
+extern template struct BasicSyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+extern template struct BasicSyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+extern template struct BasicSyncReferenceNodeStorage<IRIBackend, std::allocator, true>;
+
+using SyncReferenceNodeStorage = BasicSyncReferenceNodeStorage<IRIBackend>;
 static_assert(NodeStorage<SyncReferenceNodeStorage>);
 
+/**
+ * SyncReferenceNodeStorage that stores IRIs prefix-compressed, see PrefixCompressedIRIBackend for the caveats.
+ */
+using PrefixCompressedSyncReferenceNodeStorage = BasicSyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+static_assert(NodeStorage<PrefixCompressedSyncReferenceNodeStorage>);
+
+/**
+ * SyncReferenceNodeStorage that allocates its dictionaries with detail::HugePageAllocator,
+ * i.e. large tables are backed by transparent huge pages (and interleaved over all NUMA nodes if RDF4CPP_NUMA_INTERLEAVE is enabled).
+ */
+using HugePageSyncReferenceNodeStorage = BasicSyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+static_assert(NodeStorage<HugePageSyncReferenceNodeStorage>);
+
+/**
+ * SyncReferenceNodeStorage that resolves ids to nodes (find_*_backend) without taking any lock,
+ * for workloads that mostly translate ids back to nodes from many threads. Never erases nodes, see BasicSyncReferenceNodeStorage.
+ */
+using LockFreeReadSyncReferenceNodeStorage = BasicSyncReferenceNodeStorage<IRIBackend, std::allocator, true>;
+static_assert(NodeStorage<LockFreeReadSyncReferenceNodeStorage>);
+
 extern SyncReferenceNodeStorage default_instance;
 
 }  // namespace rdf4cpp::storage::reference_node_storage
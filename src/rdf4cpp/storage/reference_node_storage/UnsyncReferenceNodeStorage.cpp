@@ -1,11 +1,20 @@
 #include "UnsyncReferenceNodeStorage.hpp"
 
 #include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/NodeStorageSnapshot.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
 namespace rdf4cpp::storage::reference_node_storage {
 
-void UnsyncReferenceNodeStorage::init() {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+void BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::init() {
     iri_storage_.mapping.reserve_until(identifier::NodeID::min_iri_id);
     bnode_storage_.mapping.reserve_until(identifier::NodeID::min_bnode_id);
     variable_storage_.mapping.reserve_until(identifier::NodeID::min_variable_id);
@@ -22,11 +31,13 @@ void UnsyncReferenceNodeStorage::init() {
     }
 }
 
-UnsyncReferenceNodeStorage::UnsyncReferenceNodeStorage() {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::BasicUnsyncReferenceNodeStorage() {
     init();
 }
 
-size_t UnsyncReferenceNodeStorage::size() const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+size_t BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::size() const noexcept {
     return iri_storage_.mapping.size() +
            bnode_storage_.mapping.size() +
            variable_storage_.mapping.size() +
@@ -36,18 +47,34 @@ size_t UnsyncReferenceNodeStorage::size() const noexcept {
            });
 }
 
-void UnsyncReferenceNodeStorage::shrink_to_fit() {
-    iri_storage_.mapping.shrink_to_fit();
-    bnode_storage_.mapping.shrink_to_fit();
-    variable_storage_.mapping.shrink_to_fit();
-    fallback_literal_storage_.mapping.shrink_to_fit();
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+NodeStorageStats BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::stats() const noexcept {
+    NodeStorageStats ret{.iris = iri_storage_.stats(),
+                         .bnodes = bnode_storage_.stats(),
+                         .variables = variable_storage_.stats(),
+                         .lexical_literals = fallback_literal_storage_.stats()};
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&ret](auto const &storage) noexcept {
+        ret.specialized_literals += storage.stats();
+    });
+
+    return ret;
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+void BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::shrink_to_fit() {
+    iri_storage_.shrink_to_fit();
+    bnode_storage_.shrink_to_fit();
+    variable_storage_.shrink_to_fit();
+    fallback_literal_storage_.shrink_to_fit();
 
     dice::template_library::tuple_for_each(specialized_literal_storage_, [](auto &storage) {
-        storage.mapping.shrink_to_fit();
+        storage.shrink_to_fit();
     });
 }
 
-bool UnsyncReferenceNodeStorage::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+bool BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::has_specialized_storage_for(identifier::LiteralType const datatype) noexcept {
     static constexpr auto specialization_lut = specialization_detail::make_storage_specialization_lut<decltype(specialized_literal_storage_)>();
     return specialization_lut[datatype.to_underlying()];
 }
@@ -75,7 +102,8 @@ static identifier::NodeBackendID lookup_or_insert_impl(typename Storage::backend
     }
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_or_make_id(view::LiteralBackendView const &view) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_or_make_id(view::LiteralBackendView const &view) {
     return view.visit(
             [this](view::LexicalFormLiteralBackendView const &lexical) {
                 assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
@@ -89,27 +117,33 @@ identifier::NodeBackendID UnsyncReferenceNodeStorage::find_or_make_id(view::Lite
             });
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_or_make_id(view::IRIBackendView const &view) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_or_make_id(view::IRIBackendView const &view) {
     return lookup_or_insert_impl<true>(view, iri_storage_);
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_or_make_id(view::BNodeBackendView const &view) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_or_make_id(view::BNodeBackendView const &view) {
     return lookup_or_insert_impl<true>(view, bnode_storage_);
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_or_make_id(view::VariableBackendView const &view) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_or_make_id(view::VariableBackendView const &view) {
     return lookup_or_insert_impl<true>(view, variable_storage_);
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_id(view::BNodeBackendView const &view) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_id(view::BNodeBackendView const &view) const noexcept {
     return lookup_or_insert_impl<false>(view, bnode_storage_);
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_id(view::IRIBackendView const &view) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_id(view::IRIBackendView const &view) const noexcept {
     return lookup_or_insert_impl<false>(view, iri_storage_);
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_id(view::LiteralBackendView const &view) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_id(view::LiteralBackendView const &view) const noexcept {
     return view.visit(
             [this](view::LexicalFormLiteralBackendView const &lexical) noexcept {
                 assert(!has_specialized_storage_for(identifier::iri_node_id_to_literal_type(lexical.datatype_id)));
@@ -123,7 +157,8 @@ identifier::NodeBackendID UnsyncReferenceNodeStorage::find_id(view::LiteralBacke
             });
 }
 
-identifier::NodeBackendID UnsyncReferenceNodeStorage::find_id(view::VariableBackendView const &view) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+identifier::NodeBackendID BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_id(view::VariableBackendView const &view) const noexcept {
     return lookup_or_insert_impl<false>(view, variable_storage_);
 }
 
@@ -137,11 +172,13 @@ static typename Storage::backend_view_type find_backend_view(Storage &storage, i
     }
 }
 
-view::IRIBackendView UnsyncReferenceNodeStorage::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+view::IRIBackendView BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_iri_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(iri_storage_, id);
 }
 
-view::LiteralBackendView UnsyncReferenceNodeStorage::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+view::LiteralBackendView BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_literal_backend(identifier::NodeBackendID const id) const noexcept {
     if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
         return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto const &storage) noexcept {
             return find_backend_view(storage, id);
@@ -151,11 +188,13 @@ view::LiteralBackendView UnsyncReferenceNodeStorage::find_literal_backend(identi
     return find_backend_view(fallback_literal_storage_, id);
 }
 
-view::BNodeBackendView UnsyncReferenceNodeStorage::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+view::BNodeBackendView BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_bnode_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(bnode_storage_, id);
 }
 
-view::VariableBackendView UnsyncReferenceNodeStorage::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+view::VariableBackendView BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::find_variable_backend(identifier::NodeBackendID const id) const noexcept {
     return find_backend_view(variable_storage_, id);
 }
 
@@ -170,7 +209,8 @@ static bool erase_impl(Storage &storage, identifier::NodeBackendID const id) {
     return true;
 }
 
-bool UnsyncReferenceNodeStorage::erase_iri(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+bool BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::erase_iri(identifier::NodeBackendID const id) {
     // check predefined IRIs
     if (identifier::iri_node_id_to_literal_type(id).is_fixed()) {
         return false;
@@ -179,7 +219,8 @@ bool UnsyncReferenceNodeStorage::erase_iri(identifier::NodeBackendID const id) {
     return erase_impl(iri_storage_, id);
 }
 
-bool UnsyncReferenceNodeStorage::erase_literal(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+bool BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::erase_literal(identifier::NodeBackendID const id) {
     if (id.node_id().literal_type().is_fixed() && has_specialized_storage_for(id.node_id().literal_type())) {
         return specialization_detail::visit_specialized(specialized_literal_storage_, id.node_id().literal_type(), [id](auto &storage) noexcept {
             return erase_impl(storage, id);
@@ -189,25 +230,178 @@ bool UnsyncReferenceNodeStorage::erase_literal(identifier::NodeBackendID const i
     return erase_impl(fallback_literal_storage_, id);
 }
 
-bool UnsyncReferenceNodeStorage::erase_bnode(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+bool BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::erase_bnode(identifier::NodeBackendID const id) {
     return erase_impl(bnode_storage_, id);
 }
 
-bool UnsyncReferenceNodeStorage::erase_variable(identifier::NodeBackendID const id) {
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+bool BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::erase_variable(identifier::NodeBackendID const id) {
     return erase_impl(variable_storage_, id);
 }
 
-void UnsyncReferenceNodeStorage::clear() noexcept {
-    iri_storage_.mapping.clear();
-    bnode_storage_.mapping.clear();
-    variable_storage_.mapping.clear();
-    fallback_literal_storage_.mapping.clear();
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+void BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::clear() noexcept {
+    iri_storage_.clear();
+    bnode_storage_.clear();
+    variable_storage_.clear();
+    fallback_literal_storage_.clear();
 
     dice::template_library::tuple_for_each(specialized_literal_storage_, [](auto &storage) {
-        storage.mapping.clear();
+        storage.clear();
     });
 
     init();
 }
 
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+void BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::dump(std::ostream &out) const {
+    detail::snapshot::write_header(out, 4 + std::tuple_size_v<decltype(specialized_literal_storage_)>);
+    detail::snapshot::write_section(out, detail::snapshot::tags::bnode, bnode_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::iri, iri_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::variable, variable_storage_);
+    detail::snapshot::write_section(out, detail::snapshot::tags::fallback_literal, fallback_literal_storage_);
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&out]<typename Storage>(Storage const &storage) {
+        detail::snapshot::write_section(out, detail::snapshot::tags::specialized_literal<Storage>, storage);
+    });
+
+    if (!out) {
+        throw std::runtime_error{"unable to write node storage snapshot"};
+    }
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+void BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::restore(std::istream &in) {
+    clear();
+
+    try {
+        detail::snapshot::read_header(in, 4 + std::tuple_size_v<decltype(specialized_literal_storage_)>);
+        detail::snapshot::read_section(in, detail::snapshot::tags::bnode, bnode_storage_, identifier::NodeID::min_bnode_id);
+        detail::snapshot::read_section(in, detail::snapshot::tags::iri, iri_storage_, identifier::NodeID::min_iri_id);
+        detail::snapshot::read_section(in, detail::snapshot::tags::variable, variable_storage_, identifier::NodeID::min_variable_id);
+        detail::snapshot::read_section(in, detail::snapshot::tags::fallback_literal, fallback_literal_storage_, identifier::NodeID::min_literal_id);
+
+        dice::template_library::tuple_for_each(specialized_literal_storage_, [&in]<typename Storage>(Storage &storage) {
+            detail::snapshot::read_section(in, detail::snapshot::tags::specialized_literal<Storage>, storage, identifier::NodeID::min_literal_id);
+        });
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+/**
+ * Renumbers all nodes of storage with an id of at least min_id, see BasicUnsyncReferenceNodeStorage::renumber.
+ *
+ * @param transform_view transform_view(view) is the view that is stored under the new id,
+ *      used to translate the ids that are referenced by the view (e.g. the datatype IRI of a literal)
+ * @param remapping output, receives all ids that change
+ */
+template<typename Storage, typename TransformView>
+static void renumber_impl(Storage &storage,
+                          typename Storage::backend_id_type const min_id,
+                          std::function<size_t(identifier::NodeBackendID)> const &frequency,
+                          TransformView &&transform_view,
+                          NodeIDRemapping &remapping) {
+    using backend_id_type = typename Storage::backend_id_type;
+    using backend_view_type = typename Storage::backend_view_type;
+
+    static constexpr bool order_by_identifier = std::is_same_v<backend_view_type, view::IRIBackendView>;
+
+    struct Entry {
+        backend_id_type id;
+        size_t frequency;
+        std::string identifier; //< only used for IRIs
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(storage.mapping.entry_count());
+
+    storage.mapping.for_each([&](backend_id_type const id, backend_view_type const &view) {
+        if (id.to_underlying() < min_id.to_underlying()) {
+            return; // reserved, e.g. predefined datatype IRIs
+        }
+
+        Entry entry{.id = id, .frequency = frequency(Storage::from_storage_id(id, view)), .identifier = {}};
+        if constexpr (order_by_identifier) {
+            entry.identifier = view.identifier;
+        }
+
+        entries.push_back(std::move(entry));
+    });
+
+    std::ranges::stable_sort(entries, [](Entry const &lhs, Entry const &rhs) noexcept {
+        if (lhs.frequency != rhs.frequency) {
+            return lhs.frequency > rhs.frequency;
+        }
+
+        if constexpr (order_by_identifier) {
+            return lhs.identifier < rhs.identifier;
+        } else {
+            return false;
+        }
+    });
+
+    // the views of storage refer to its arena, so the renumbered content is staged in a second storage
+    auto const end_id = backend_id_type{min_id.to_underlying() + entries.size()};
+    auto staged = std::make_unique<Storage>();
+    staged->mapping.reserve_until(end_id);
+
+    storage.mapping.for_each([&](backend_id_type const id, backend_view_type const &view) {
+        if (id.to_underlying() < min_id.to_underlying()) {
+            staged->mapping.insert_assume_not_present_at(transform_view(view), id);
+        }
+    });
+
+    for (size_t ix = 0; ix < entries.size(); ++ix) {
+        auto const old_id = entries[ix].id;
+        auto const new_id = backend_id_type{min_id.to_underlying() + ix};
+        auto const old_view = *storage.mapping.lookup_value(old_id);
+        auto const new_view = transform_view(old_view);
+
+        staged->mapping.insert_assume_not_present_at(new_view, new_id);
+
+        auto const old_node_id = Storage::from_storage_id(old_id, old_view);
+        if (auto const new_node_id = Storage::from_storage_id(new_id, new_view); new_node_id != old_node_id) {
+            remapping.assign(old_node_id, new_node_id);
+        }
+    }
+
+    storage.clear();
+    storage.mapping.reserve_until(end_id);
+    staged->mapping.for_each([&storage](backend_id_type const id, backend_view_type const &view) {
+        storage.mapping.insert_assume_not_present_at(view, id);
+    });
+}
+
+template<typename IRIBackend_t, template<typename> typename Allocator_t>
+NodeIDRemapping BasicUnsyncReferenceNodeStorage<IRIBackend_t, Allocator_t>::renumber(std::function<size_t(identifier::NodeBackendID)> const &frequency) {
+    NodeIDRemapping remapping{*this, *this};
+
+    auto const identity = []<typename View>(View const &view) noexcept -> View const & {
+        return view;
+    };
+
+    renumber_impl(bnode_storage_, identifier::NodeID::min_bnode_id, frequency, identity, remapping);
+    renumber_impl(iri_storage_, identifier::NodeID::min_iri_id, frequency, identity, remapping);
+    renumber_impl(variable_storage_, identifier::NodeID::min_variable_id, frequency, identity, remapping);
+
+    // the datatype IRIs of the fallback literals were renumbered above
+    renumber_impl(fallback_literal_storage_, identifier::NodeID::min_literal_id, frequency, [&remapping](view::LexicalFormLiteralBackendView view) noexcept {
+        view.datatype_id = remapping[view.datatype_id];
+        return view;
+    }, remapping);
+
+    dice::template_library::tuple_for_each(specialized_literal_storage_, [&](auto &storage) {
+        renumber_impl(storage, identifier::NodeID::min_literal_id, frequency, identity, remapping);
+    });
+
+    return remapping;
+}
+
+template struct BasicUnsyncReferenceNodeStorage<IRIBackend>;
+template struct BasicUnsyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+template struct BasicUnsyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+
 }  // namespace rdf4cpp::storage::reference_node_storage
\ No newline at end of file
@@ -2,59 +2,64 @@
 #define RDF4CPP_UNSYNCREFERENCENODESTORAGE_HPP
 
 #include <cstddef>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <tuple>
+#include <vector>
 
+#include <dice/template-library/tuple_algorithm.hpp>
+#include <rdf4cpp/NodeIDRemapping.hpp>
 #include <rdf4cpp/storage/NodeStorage.hpp>
 #include <rdf4cpp/storage/reference_node_storage/BNodeBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/FallbackLiteralBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/IRIBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
+#include <rdf4cpp/storage/reference_node_storage/PrefixCompressedIRIBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/SpecializedLiteralBackend.hpp>
 #include <rdf4cpp/storage/reference_node_storage/VariableBackend.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/HugePageAllocator.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/SpecializationDetail.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/UnsyncNodeTypeStorage.hpp>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
 /**
  * NON-Thread-safe reference implementation of a INodeStorageBackend.
+ * @tparam IRIBackend_t backend type for IRIs, either IRIBackend or PrefixCompressedIRIBackend
+ * @tparam Allocator_t stateless allocator template for the dictionaries, either std::allocator or detail::HugePageAllocator
  */
-struct UnsyncReferenceNodeStorage {
+template<typename IRIBackend_t, template<typename> typename Allocator_t = std::allocator>
+struct BasicUnsyncReferenceNodeStorage {
 private:
-    UnsyncNodeTypeStorage<BNodeBackend> bnode_storage_;
-    UnsyncNodeTypeStorage<IRIBackend> iri_storage_;
-    UnsyncNodeTypeStorage<VariableBackend> variable_storage_;
-
-    UnsyncNodeTypeStorage<FallbackLiteralBackend> fallback_literal_storage_;
-
-    std::tuple<UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Integer>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NonNegativeInteger>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::PositiveInteger>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NonPositiveInteger>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::NegativeInteger>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Long>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::UnsignedLong>>,
-
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Decimal>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Double>>,
-
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Base64Binary>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::HexBinary>>,
-
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Date>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DateTime>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DateTimeStamp>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::GYearMonth>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::Duration>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::DayTimeDuration>>,
-               UnsyncNodeTypeStorage<SpecializedLiteralBackend<datatypes::xsd::YearMonthDuration>>> specialized_literal_storage_;
+    template<typename Backend>
+    using node_type_storage = UnsyncNodeTypeStorage<Backend, std::vector, Allocator_t>;
+
+    node_type_storage<BNodeBackend> bnode_storage_;
+    node_type_storage<IRIBackend_t> iri_storage_;
+    node_type_storage<VariableBackend> variable_storage_;
+
+    node_type_storage<FallbackLiteralBackend> fallback_literal_storage_;
+
+    template<typename Datatype>
+    using specialized_literal_storage = node_type_storage<SpecializedLiteralBackend<Datatype>>;
+
+    specialization_detail::specialized_storage_tuple<specialized_literal_storage> specialized_literal_storage_;
 
     void init();
 
 public:
-    UnsyncReferenceNodeStorage();
+    BasicUnsyncReferenceNodeStorage();
 
     [[nodiscard]] size_t size() const noexcept;
     void shrink_to_fit();
 
+    /**
+     * @return statistics per node type, the lookup and lock counters are always zero because this storage does not synchronize
+     */
+    [[nodiscard]] NodeStorageStats stats() const noexcept;
+
     [[nodiscard]] static bool has_specialized_storage_for(identifier::LiteralType datatype) noexcept;
 
     [[nodiscard]] identifier::NodeBackendID find_or_make_id(view::BNodeBackendView const &view);
@@ -77,11 +82,80 @@ public:
     bool erase_bnode(identifier::NodeBackendID id);
     bool erase_variable(identifier::NodeBackendID id);
 
+    /**
+     * Calls f(id, view) for every node in this storage, e.g. to build a FrozenNodeStorage from it.
+     * The view is one of the backend view types, for literals either view::LexicalFormLiteralBackendView or view::ValueLiteralBackendView.
+     */
+    template<typename F>
+    void for_each_node(F &&f) const {
+        auto visit_storage = [&f]<typename Storage>(Storage const &storage) {
+            storage.mapping.for_each([&f](auto const id, auto const &view) {
+                f(Storage::from_storage_id(id, view), view);
+            });
+        };
+
+        visit_storage(bnode_storage_);
+        visit_storage(iri_storage_);
+        visit_storage(variable_storage_);
+        visit_storage(fallback_literal_storage_);
+        dice::template_library::tuple_for_each(specialized_literal_storage_, visit_storage);
+    }
+
     void clear() noexcept;
+
+    /**
+     * Writes a binary snapshot of this storage to out, see detail/NodeStorageSnapshot.hpp for the format.
+     * The snapshot can be restored with restore, in the same or in another process.
+     *
+     * @throws std::runtime_error if out fails
+     */
+    void dump(std::ostream &out) const;
+
+    /**
+     * Replaces the content of this storage by the content of a snapshot written by dump.
+     * All NodeBackendIDs are preserved, i.e. ids that were handed out by the dumped storage are valid for this storage.
+     * The snapshot must have been written by a storage of the same type (IRIBackend_t) with the same rdf4cpp::pobr_version.
+     *
+     * @throws std::runtime_error if the snapshot is invalid, truncated or incompatible, this storage is cleared in that case
+     */
+    void restore(std::istream &in);
+
+    /**
+     * Offline compaction pass that renumbers all nodes of this storage to improve the locality of the id to node lookups (find_*_backend).
+     * Within each node type, nodes are ordered by descending frequency, such that frequently used nodes are adjacent
+     * in memory. IRIs of equal frequency are ordered lexicographically, which clusters them by namespace.
+     * Other nodes of equal frequency keep their relative order. Holes left behind by erasure are removed.
+     * The ids of the predefined datatype IRIs and of inlined literals never change.
+     *
+     * All ids of this storage that are held anywhere (e.g. in a Graph) are invalidated and must be rewritten with the returned remapping
+     * (see Graph::remap_node_ids and Dataset::remap_node_ids).
+     *
+     * @param frequency frequency(id) is the weight of the node with the given id, e.g. its number of occurrences in the graphs using this storage
+     * @return the mapping from the old to the new ids
+     */
+    [[nodiscard]] NodeIDRemapping renumber(std::function<size_t(identifier::NodeBackendID)> const &frequency);
 };
 
+extern template struct BasicUnsyncReferenceNodeStorage<IRIBackend>;
+extern template struct BasicUnsyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+extern template struct BasicUnsyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+
+using UnsyncReferenceNodeStorage = BasicUnsyncReferenceNodeStorage<IRIBackend>;
 static_assert(NodeStorage<UnsyncReferenceNodeStorage>);
 
+/**
+ * UnsyncReferenceNodeStorage that stores IRIs prefix-compressed, see PrefixCompressedIRIBackend for the caveats.
+ */
+using PrefixCompressedUnsyncReferenceNodeStorage = BasicUnsyncReferenceNodeStorage<PrefixCompressedIRIBackend>;
+static_assert(NodeStorage<PrefixCompressedUnsyncReferenceNodeStorage>);
+
+/**
+ * UnsyncReferenceNodeStorage that allocates its dictionaries with detail::HugePageAllocator,
+ * i.e. large tables are backed by transparent huge pages (and interleaved over all NUMA nodes if RDF4CPP_NUMA_INTERLEAVE is enabled).
+ */
+using HugePageUnsyncReferenceNodeStorage = BasicUnsyncReferenceNodeStorage<IRIBackend, detail::HugePageAllocator>;
+static_assert(NodeStorage<HugePageUnsyncReferenceNodeStorage>);
+
 }  // namespace rdf4cpp::storage::reference_node_storage
 
 #endif  //RDF4CPP_UNSYNCREFERENCENODESTORAGE_HPP
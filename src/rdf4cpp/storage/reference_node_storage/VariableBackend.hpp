@@ -2,21 +2,23 @@
 #define RDF4CPP_VARIABLEBACKEND_HPP
 
 #include <rdf4cpp/storage/view/VariableBackendView.hpp>
-#include <rdf4cpp/storage/reference_node_storage/detail/ConstString.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
 struct VariableBackend {
     using view_type = view::VariableBackendView;
     using id_type = identifier::NodeID;
+    using allocator_type = detail::StringArenaAllocator<char>;
+    static constexpr bool arena_allocated = true; //< only owns memory allocated with allocator_type, see detail::ArenaAllocated
 
     size_t hash;
-    detail::ConstString name;
+    detail::ArenaConstString name;
     bool is_anonymous;
 
-    explicit VariableBackend(view_type const &view) noexcept : hash{view.hash()},
-                                                               name{view.name},
-                                                               is_anonymous{view.is_anonymous} {
+    explicit VariableBackend(view_type const &view, allocator_type const &alloc = allocator_type{}) noexcept : hash{view.hash()},
+                                                                                                               name{view.name, alloc},
+                                                                                                               is_anonymous{view.is_anonymous} {
     }
 
     explicit operator view_type() const noexcept {
@@ -3,6 +3,16 @@
 
 #include <dice/sparse-map/sparse_set.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/IndexFreeList.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace rdf4cpp::storage::reference_node_storage::detail {
 
@@ -15,8 +25,15 @@ namespace rdf4cpp::storage::reference_node_storage::detail {
  * @tparam Hash hash for View
  * @tparam Equal equality for View and Value
  * @tparam Allocator allocator
+ * If Value is ArenaAllocated and Allocator is a StringArenaAllocator with an arena, clear and the destructor do not destroy the values one by one,
+ * the owner of the arena must release their memory at once with StringArena::clear instead (see UnsyncNodeTypeStorage::clear).
+ *
+ * @tparam ForwardContainer vector-like container for the Id to Value direction.
+ *      If it is a StableChunkedVector, lookup_value can be called concurrently with insertions of new ids without any synchronization,
+ *      as long as no value is ever erased (erasure and the reuse of erased ids modify values in place).
  */
-template<typename Id, typename Value, typename View, typename Hash = std::hash<View>, typename Equal = std::equal_to<>, typename Allocator = std::allocator<Value>>
+template<typename Id, typename Value, typename View, typename Hash = std::hash<View>, typename Equal = std::equal_to<>, typename Allocator = std::allocator<Value>,
+         template<typename, typename> typename ForwardContainer = std::vector>
 struct BiDirFlatMap {
     using id_type = Id;
     using mapped_type = Value;
@@ -27,9 +44,83 @@ struct BiDirFlatMap {
     using key_equal = Equal;
 
 private:
-    using forward_value_type = std::optional<mapped_type>;
+    static constexpr bool values_released_with_arena = ArenaAllocated<mapped_type> && requires(allocator_type const &alloc) {
+        { alloc.arena() } -> std::convertible_to<StringArena *>;
+    };
+
+    /**
+     * Replaces std::optional<mapped_type> in forward_ if values_released_with_arena.
+     * It is trivially destructible, such that clearing or destroying forward_ does not visit every value.
+     * Values are destroyed explicitly with reset (i.e. on erasure) or released together with their arena.
+     */
+    struct ArenaValueSlot {
+    private:
+        alignas(mapped_type) std::byte storage_[sizeof(mapped_type)];
+        bool engaged_ = false;
+
+        [[nodiscard]] mapped_type *ptr() noexcept {
+            return std::launder(reinterpret_cast<mapped_type *>(storage_));
+        }
+
+        [[nodiscard]] mapped_type const *ptr() const noexcept {
+            return std::launder(reinterpret_cast<mapped_type const *>(storage_));
+        }
+
+    public:
+        ArenaValueSlot() noexcept = default;
+
+        ArenaValueSlot(mapped_type &&value) noexcept(std::is_nothrow_move_constructible_v<mapped_type>) {
+            std::construct_at(reinterpret_cast<mapped_type *>(storage_), std::move(value));
+            engaged_ = true;
+        }
+
+        // destructive move, because the destructor does not destroy the value (used when forward_ relocates its elements)
+        ArenaValueSlot(ArenaValueSlot &&other) noexcept(std::is_nothrow_move_constructible_v<mapped_type>) {
+            if (other.engaged_) {
+                std::construct_at(reinterpret_cast<mapped_type *>(storage_), std::move(*other));
+                engaged_ = true;
+                other.reset();
+            }
+        }
+
+        ArenaValueSlot(ArenaValueSlot const &) = delete;
+        ArenaValueSlot &operator=(ArenaValueSlot const &) = delete;
+        ArenaValueSlot &operator=(ArenaValueSlot &&) = delete;
+        ~ArenaValueSlot() = default;
+
+        ArenaValueSlot &operator=(mapped_type &&value) {
+            reset();
+            std::construct_at(reinterpret_cast<mapped_type *>(storage_), std::move(value));
+            engaged_ = true;
+            return *this;
+        }
+
+        [[nodiscard]] bool has_value() const noexcept {
+            return engaged_;
+        }
+
+        [[nodiscard]] mapped_type &operator*() noexcept {
+            assert(engaged_);
+            return *ptr();
+        }
+
+        [[nodiscard]] mapped_type const &operator*() const noexcept {
+            assert(engaged_);
+            return *ptr();
+        }
+
+        void reset() noexcept {
+            if (engaged_) {
+                std::destroy_at(ptr());
+                engaged_ = false;
+            }
+        }
+    };
+
+    using forward_value_type = std::conditional_t<values_released_with_arena, ArenaValueSlot, std::optional<mapped_type>>;
+    static_assert(!values_released_with_arena || std::is_trivially_destructible_v<forward_value_type>);
     using forward_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<forward_value_type>;
-    using forward_type = std::vector<forward_value_type, forward_allocator_type>;
+    using forward_type = ForwardContainer<forward_value_type, forward_allocator_type>;
 
     struct backward_key_type {
         size_t hash; //< hash of the Value being looked up
@@ -93,6 +184,22 @@ private:
     index_free_list_type freelist_; //< freelist for forward_
     [[no_unique_address]] allocator_type alloc_;
 
+    /**
+     * Destroys all values, unless their memory is released together with the arena of alloc_ (see values_released_with_arena).
+     * Otherwise, forward_ destroys the values itself.
+     */
+    void destroy_values_not_released_with_arena() noexcept {
+        if constexpr (values_released_with_arena) {
+            if (alloc_.arena() != nullptr) {
+                return;
+            }
+
+            for (size_type ix = 0; ix < forward_.size(); ++ix) {
+                forward_[ix].reset();
+            }
+        }
+    }
+
     /**
      * Translates the given id into an index into forward_
      */
@@ -124,6 +231,10 @@ public:
     BiDirFlatMap &operator=(BiDirFlatMap const &) = delete;
     BiDirFlatMap &operator=(BiDirFlatMap &&) = delete;
 
+    ~BiDirFlatMap() {
+        destroy_values_not_released_with_arena();
+    }
+
     /**
      * Number of elements stored in this map
      */
@@ -131,6 +242,27 @@ public:
         return forward_.size();
     }
 
+    /**
+     * Number of values stored in this map, unlike size() this does not include vacant or reserved ids
+     */
+    [[nodiscard]] size_type entry_count() const noexcept {
+        return backward_.size();
+    }
+
+    /**
+     * Number of ids below size() that are neither assigned nor reserved, i.e. holes left behind by erasure
+     */
+    [[nodiscard]] size_type vacant_count() const noexcept {
+        return forward_.size() - freelist_.occupied_count();
+    }
+
+    /**
+     * Load factor of the hash table of the value to id direction
+     */
+    [[nodiscard]] float load_factor() const noexcept {
+        return backward_.load_factor();
+    }
+
     /**
      * Requests the removal of unused capacity.
      */
@@ -141,7 +273,9 @@ public:
     }
 
     /**
-     * Look up the value corresponding to the given id
+     * Look up the value corresponding to the given id.
+     * If ForwardContainer is a StableChunkedVector, this does not need to be synchronized with insertions
+     * as long as no value is ever erased (see ForwardContainer).
      *
      * @param id id for value to look up
      * @return if a value was found: a view to that value, otherwise nullopt
@@ -174,6 +308,37 @@ public:
         return it->id;
     }
 
+    /**
+     * Look up the id corresponding the given (view to a) value, using a precalculated hash.
+     *
+     * @param view view of value of which to find the id
+     * @param hash hash of view, must be equal to hasher{}(view)
+     * @return id of the value if it was found, otherwise id_type{} if no id was found
+     */
+    [[nodiscard]] id_type lookup_id(view_type const &view, size_t const hash) const noexcept {
+        assert(hash == backward_.hash_function().hash(view));
+
+        auto it = backward_.find(view, hash);
+        if (it == backward_.end()) {
+            return id_type{};
+        }
+
+        return it->id;
+    }
+
+    /**
+     * Calls f(id, view) for every value in this map, in ascending order of id.
+     * f must not modify this map.
+     */
+    template<typename F>
+    void for_each(F &&f) const {
+        for (size_type ix = 0; ix < forward_.size(); ++ix) {
+            if (auto const &value = forward_[ix]; value.has_value()) {
+                f(to_id(ix), static_cast<view_type>(*value));
+            }
+        }
+    }
+
     /**
      * Reserve capacity such that min_id is the first id that
      * triggers an allocation if it is inserted.
@@ -189,6 +354,18 @@ public:
         freelist_.occupy_until(new_size);
     }
 
+    /**
+     * Makes all ids of at least min_id that do not have a value available for insert_assume_not_present again,
+     * e.g. after restoring values at their previous ids with reserve_until and insert_assume_not_present_at.
+     */
+    void vacate_unassigned(id_type const min_id) {
+        for (auto ix = to_index(min_id); ix < forward_.size(); ++ix) {
+            if (!forward_[ix].has_value()) {
+                freelist_.vacate(ix);
+            }
+        }
+    }
+
     /**
      * Insert a value at the first free id
      *
@@ -198,19 +375,33 @@ public:
      * @return id of newly constructed value
      */
     [[nodiscard]] id_type insert_assume_not_present(view_type const &view) {
+        return insert_assume_not_present(view, backward_.hash_function().hash(view));
+    }
+
+    /**
+     * Insert a value at the first free id, using a precalculated hash
+     *
+     * @precondition the value is not yet present in this map
+     *
+     * @param view view of the value to construct
+     * @param hash hash of view, must be equal to hasher{}(view)
+     * @return id of newly constructed value
+     */
+    [[nodiscard]] id_type insert_assume_not_present(view_type const &view, size_t const hash) {
         assert(lookup_id(view) == Id{});
+        assert(hash == backward_.hash_function().hash(view));
 
         auto const assigned_ix = freelist_.occupy_next_available();
         if (assigned_ix >= forward_.size()) {
             assert(assigned_ix == forward_.size());
-            forward_.emplace_back();
+            // the value is constructed before it is published, concurrent readers of a StableChunkedVector never see an empty slot
+            forward_.emplace_back(std::make_obj_using_allocator<mapped_type>(alloc_, view));
+        } else {
+            forward_[assigned_ix] = std::make_obj_using_allocator<mapped_type>(alloc_, view);
         }
 
-        forward_[assigned_ix] = std::make_obj_using_allocator<mapped_type>(alloc_, view);
-
         auto const assigned_id = to_id(assigned_ix);
-        auto const h = backward_.hash_function().hash(view);
-        backward_.emplace(h, assigned_id);
+        backward_.emplace(hash, assigned_id);
 
         return assigned_id;
     }
@@ -257,7 +448,12 @@ public:
         freelist_.vacate(ix);
     }
 
+    /**
+     * Removes all values. If the values are released together with their arena (see class documentation),
+     * this does not visit the values, but the arena must be cleared afterwards to actually free their memory.
+     */
     void clear() noexcept {
+        destroy_values_not_released_with_arena();
         forward_.clear();
         backward_.clear();
         freelist_.clear();
@@ -0,0 +1,116 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_BLOOMFILTER_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_BLOOMFILTER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * A Bloom filter over precalculated hashes.
+ * The k probe positions are derived from a single hash by double hashing.
+ *
+ * Thread-safety: insert and may_contain may be called concurrently, the bits are atomics.
+ * A may_contain that runs concurrently with the insert of the same hash may or may not see it.
+ */
+struct BloomFilter {
+    using word_type = uint64_t;
+
+private:
+    static constexpr size_t word_bits = sizeof(word_type) * 8;
+
+    size_t num_bits_;   //< number of bits, always a multiple of word_bits
+    size_t num_hashes_; //< number of probes per hash
+    std::unique_ptr<std::atomic<word_type>[]> words_;
+
+    /**
+     * Derives the second hash for double hashing from the first one, the result is always odd
+     */
+    static constexpr size_t second_hash(size_t const hash) noexcept {
+        // murmur3 finalizer
+        auto h = static_cast<uint64_t>(hash);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h) | 1;
+    }
+
+public:
+    /**
+     * Creates an empty filter sized such that it has the given false-positive rate once it contains expected_entries hashes.
+     *
+     * @param expected_entries number of hashes the filter is sized for, more entries increase the false-positive rate
+     * @param false_positive_rate the targeted false-positive rate, must be in (0, 1)
+     */
+    BloomFilter(size_t const expected_entries, double const false_positive_rate) {
+        assert(false_positive_rate > 0.0 && false_positive_rate < 1.0);
+
+        auto const n = static_cast<double>(std::max<size_t>(expected_entries, 1));
+        auto const ln2 = std::log(2.0);
+        auto const bits = std::ceil(-n * std::log(false_positive_rate) / (ln2 * ln2));
+
+        auto const num_words = std::max<size_t>(static_cast<size_t>(std::ceil(bits / word_bits)), 1);
+        num_bits_ = num_words * word_bits;
+        num_hashes_ = std::clamp<size_t>(static_cast<size_t>(std::round(static_cast<double>(num_bits_) / n * ln2)), 1, 32);
+        words_ = std::make_unique<std::atomic<word_type>[]>(num_words);
+    }
+
+    /**
+     * @return size of this filter in bits
+     */
+    [[nodiscard]] size_t num_bits() const noexcept {
+        return num_bits_;
+    }
+
+    /**
+     * @return number of bits set per inserted hash
+     */
+    [[nodiscard]] size_t num_hashes() const noexcept {
+        return num_hashes_;
+    }
+
+    /**
+     * Adds the given hash to the filter
+     */
+    void insert(size_t const hash) noexcept {
+        auto const step = second_hash(hash);
+        for (size_t ix = 0; ix < num_hashes_; ++ix) {
+            auto const bit = (hash + ix * step) % num_bits_;
+            words_[bit / word_bits].fetch_or(word_type{1} << (bit % word_bits), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @return false if hash was definitely never inserted, true if it might have been
+     */
+    [[nodiscard]] bool may_contain(size_t const hash) const noexcept {
+        auto const step = second_hash(hash);
+        for (size_t ix = 0; ix < num_hashes_; ++ix) {
+            auto const bit = (hash + ix * step) % num_bits_;
+            if ((words_[bit / word_bits].load(std::memory_order_relaxed) & (word_type{1} << (bit % word_bits))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Removes all hashes from the filter
+     */
+    void clear() noexcept {
+        for (size_t ix = 0; ix < num_bits_ / word_bits; ++ix) {
+            words_[ix].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_BLOOMFILTER_HPP
@@ -82,6 +82,10 @@ namespace rdf4cpp::storage::reference_node_storage::detail {
             }
         }
 
+        [[nodiscard]] allocator_type get_allocator() const noexcept {
+            return alloc_;
+        }
+
         [[nodiscard]] value_type const *data() const noexcept {
             return data_;
         }
@@ -0,0 +1,93 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_EPOCHTRACKER_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_EPOCHTRACKER_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * Global epoch and registry of active guards for epoch-based reclamation of nodes (see NodeStorageCollector).
+ *
+ * Every use of a node is stamped with the current epoch.
+ * A guard publishes the epoch at which it was entered, nodes that were stamped before the oldest active guard
+ * (and are not reachable from any root) can therefore not be in use anymore.
+ *
+ * All operations use sequentially consistent atomics, which is what makes the above reasoning sound.
+ */
+struct EpochTracker {
+    static constexpr size_t max_guards = 256;
+    static constexpr uint64_t free_slot = 0;
+
+private:
+    std::atomic<uint64_t> epoch_ = 1;
+    std::array<std::atomic<uint64_t>, max_guards> guards_{}; //< epoch at which the guard in that slot was entered or free_slot
+
+public:
+    /**
+     * @return the current epoch
+     */
+    [[nodiscard]] uint64_t current() const noexcept {
+        return epoch_.load();
+    }
+
+    /**
+     * Starts a new epoch
+     * @return the new epoch
+     */
+    uint64_t advance() noexcept {
+        return epoch_.fetch_add(1) + 1;
+    }
+
+    /**
+     * Enters a guard, i.e. publishes the current epoch.
+     * Waits if all max_guards slots are occupied.
+     *
+     * @return slot of the guard, to be passed to exit
+     */
+    [[nodiscard]] size_t enter() noexcept {
+        auto const hint = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        while (true) {
+            for (size_t attempt = 0; attempt < max_guards; ++attempt) {
+                auto const slot = (hint + attempt) % max_guards;
+
+                auto expected = free_slot;
+                if (guards_[slot].compare_exchange_strong(expected, current())) {
+                    return slot;
+                }
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * Exits the guard in the given slot
+     */
+    void exit(size_t const slot) noexcept {
+        guards_[slot].store(free_slot);
+    }
+
+    /**
+     * @param upper upper bound for the result, usually the epoch returned by the last call to advance
+     * @return the oldest epoch of any active guard or upper if it is older
+     */
+    [[nodiscard]] uint64_t safe_epoch(uint64_t const upper) const noexcept {
+        auto ret = upper;
+        for (auto const &guard : guards_) {
+            if (auto const epoch = guard.load(); epoch != free_slot) {
+                ret = std::min(ret, epoch);
+            }
+        }
+        return ret;
+    }
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_EPOCHTRACKER_HPP
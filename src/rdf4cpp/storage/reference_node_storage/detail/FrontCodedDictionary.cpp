@@ -0,0 +1,153 @@
+#include "FrontCodedDictionary.hpp"
+
+#include <rdf4cpp/util/Varint.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+using util::read_varint;
+using util::write_varint;
+
+FrontCodedDictionary::FrontCodedDictionary(std::vector<Entry> entries) {
+    if (entries.size() >= no_position) {
+        throw std::length_error{"too many entries for FrontCodedDictionary"};
+    }
+
+    std::ranges::sort(entries, {}, &Entry::key);
+
+    ids_.reserve(entries.size());
+    block_offsets_.reserve((entries.size() + block_size - 1) / block_size);
+
+    size_t max_index = 0;
+    for (auto const &entry : entries) {
+        max_index = std::max(max_index, entry.index);
+    }
+    positions_.assign(entries.empty() ? 0 : max_index + 1, no_position);
+
+    std::string_view prev;
+    for (size_t pos = 0; pos < entries.size(); ++pos) {
+        std::string_view const key = entries[pos].key;
+        assert(pos == 0 || prev < key);
+
+        if (pos % block_size == 0) {
+            block_offsets_.push_back(data_.size());
+            write_varint(data_, key.size());
+            data_.append(key);
+        } else {
+            auto const lcp = static_cast<size_t>(std::ranges::mismatch(prev, key).in1 - prev.begin());
+            write_varint(data_, lcp);
+            write_varint(data_, key.size() - lcp);
+            data_.append(key.substr(lcp));
+        }
+
+        ids_.push_back(entries[pos].id);
+        assert(positions_[entries[pos].index] == no_position);
+        positions_[entries[pos].index] = static_cast<uint32_t>(pos);
+        prev = key;
+    }
+
+    data_.shrink_to_fit();
+}
+
+std::string_view FrontCodedDictionary::block_head(size_t const block) const noexcept {
+    char const *p = data_.data() + block_offsets_[block];
+    auto const len = read_varint(p);
+    return std::string_view{p, len};
+}
+
+identifier::NodeBackendID FrontCodedDictionary::find_id(std::string_view const key) const noexcept {
+    // find the last block whose first string is <= key
+    size_t lo = 0;
+    size_t hi = block_offsets_.size();
+    while (lo < hi) {
+        auto const mid = lo + (hi - lo) / 2;
+        if (block_head(mid) <= key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return identifier::NodeBackendID{};
+    }
+
+    auto const block = lo - 1;
+    auto const block_begin = block * block_size;
+    auto const block_end = std::min(block_begin + block_size, ids_.size());
+
+    char const *p = data_.data() + block_offsets_[block];
+    auto const head_len = read_varint(p);
+    if (std::string_view{p, head_len} == key) {
+        return ids_[block_begin];
+    }
+
+    // the common prefix of the current string with key, strings in the block are ascending so it can only shrink
+    auto const head = std::string_view{p, head_len};
+    size_t matched = static_cast<size_t>(std::ranges::mismatch(head, key).in1 - head.begin());
+    p += head_len;
+
+    for (auto pos = block_begin + 1; pos < block_end; ++pos) {
+        auto const lcp = read_varint(p);
+        auto const suffix_len = read_varint(p);
+        std::string_view const suffix{p, suffix_len};
+        p += suffix_len;
+
+        if (lcp < matched) {
+            // the current string differs from key earlier than the previous one, which was already smaller than key
+            return identifier::NodeBackendID{};
+        }
+
+        if (lcp > matched) {
+            // shares more with the previous string than key does, i.e. still smaller than key
+            continue;
+        }
+
+        // lcp == matched, compare the remaining suffix
+        auto const rest = key.substr(matched);
+        auto const m = static_cast<size_t>(std::ranges::mismatch(suffix, rest).in1 - suffix.begin());
+        if (m == suffix.size() && m == rest.size()) {
+            return ids_[pos];
+        }
+
+        // bytes are compared as unsigned char, like the std::string ordering the entries were sorted with
+        if (m < suffix.size() && (m == rest.size() || std::char_traits<char>::lt(rest[m], suffix[m]))) {
+            // current string is greater than key
+            return identifier::NodeBackendID{};
+        }
+
+        matched += m;
+    }
+
+    return identifier::NodeBackendID{};
+}
+
+bool FrontCodedDictionary::find_key(size_t const index, std::string &out) const {
+    if (index >= positions_.size() || positions_[index] == no_position) {
+        return false;
+    }
+
+    auto const pos = positions_[index];
+    auto const block = pos / block_size;
+
+    char const *p = data_.data() + block_offsets_[block];
+    auto const head_len = read_varint(p);
+    out.assign(p, head_len);
+    p += head_len;
+
+    for (size_t k = 0; k < pos % block_size; ++k) {
+        auto const lcp = read_varint(p);
+        auto const suffix_len = read_varint(p);
+        out.resize(lcp);
+        out.append(p, suffix_len);
+        p += suffix_len;
+    }
+
+    return true;
+}
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
@@ -0,0 +1,86 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_FRONTCODEDDICTIONARY_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_FRONTCODEDDICTIONARY_HPP
+
+#include <rdf4cpp/storage/identifier/NodeBackendID.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * An immutable, compact, bidirectional dictionary between strings and NodeBackendIDs.
+ *
+ * The strings are sorted and stored front-coded in blocks of block_size strings:
+ * the first string of each block is stored in full, every following string only stores the length of the
+ * prefix it shares with its predecessor and the remaining suffix.
+ * Strings are found by binary search over the first strings of the blocks followed by a scan of a single block.
+ *
+ * Additionally, every entry has a caller-defined dense index (e.g. derived from its id),
+ * by which it can be found in constant time.
+ */
+struct FrontCodedDictionary {
+    static constexpr size_t block_size = 16;
+
+    struct Entry {
+        std::string key;             //< string of the entry
+        identifier::NodeBackendID id; //< id of the entry
+        size_t index;                //< dense index of the entry, must be unique
+    };
+
+private:
+    static constexpr uint32_t no_position = UINT32_MAX;
+
+    std::string data_;                           //< front-coded blocks
+    std::vector<size_t> block_offsets_;          //< block_offsets_[b] is the offset of block b into data_
+    std::vector<identifier::NodeBackendID> ids_; //< ids_[p] is the id of the p-th string (in sorted order)
+    std::vector<uint32_t> positions_;            //< positions_[index] is the position of the string with the given index or no_position
+
+    /**
+     * @return the first (i.e. fully stored) string of the given block
+     */
+    [[nodiscard]] std::string_view block_head(size_t block) const noexcept;
+
+public:
+    FrontCodedDictionary() noexcept = default;
+
+    /**
+     * Builds the dictionary.
+     * @param entries entries of the dictionary, keys and indices must be unique
+     * @throws std::length_error if there are too many entries
+     */
+    explicit FrontCodedDictionary(std::vector<Entry> entries);
+
+    /**
+     * @return number of entries
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return ids_.size();
+    }
+
+    /**
+     * @return number of bytes occupied by the front-coded strings
+     */
+    [[nodiscard]] size_t string_bytes() const noexcept {
+        return data_.size();
+    }
+
+    /**
+     * @return the id of the given string or the null id if it is not present
+     */
+    [[nodiscard]] identifier::NodeBackendID find_id(std::string_view key) const noexcept;
+
+    /**
+     * Decodes the string with the given index into out.
+     * @return true if there is a string with the given index, otherwise false and out is not modified
+     */
+    [[nodiscard]] bool find_key(size_t index, std::string &out) const;
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_FRONTCODEDDICTIONARY_HPP
@@ -0,0 +1,94 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_FROZENVALUETABLE_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_FROZENVALUETABLE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * Immutable bidirectional mapping between ids and the values of a (non-string) backend type, e.g. SpecializedLiteralBackend.
+ * The id to value direction is a flat array, the value to id direction is a binary search over the values sorted by hash.
+ *
+ * @tparam Backend backend type, must provide hasher and equal
+ */
+template<typename Backend>
+struct FrozenValueTable {
+    using backend_type = Backend;
+    using backend_view_type = typename Backend::view_type;
+    using backend_id_type = typename Backend::id_type;
+
+private:
+    struct HashEntry {
+        size_t hash;
+        backend_id_type id;
+    };
+
+    std::vector<std::optional<backend_type>> values_; //< values_[id - 1] is the value with id id
+    std::vector<HashEntry> by_hash_;                  //< all ids sorted by the hash of their value
+
+public:
+    /**
+     * Inserts a value with the given id.
+     * @precondition neither the id nor the value are present yet
+     * @postcondition seal must be called before any lookup
+     */
+    void insert(backend_id_type const id, backend_view_type const &view) {
+        auto const ix = static_cast<size_t>(id.to_underlying()) - 1;
+        if (ix >= values_.size()) {
+            values_.resize(ix + 1);
+        }
+
+        assert(!values_[ix].has_value());
+        values_[ix].emplace(view);
+        by_hash_.push_back(HashEntry{.hash = typename Backend::hasher{}(view), .id = id});
+    }
+
+    /**
+     * Prepares this table for lookups after all values were inserted.
+     */
+    void seal() {
+        std::ranges::sort(by_hash_, {}, &HashEntry::hash);
+        values_.shrink_to_fit();
+        by_hash_.shrink_to_fit();
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return by_hash_.size();
+    }
+
+    /**
+     * @return the id of the given value or the null id if it is not present
+     */
+    [[nodiscard]] backend_id_type find_id(backend_view_type const &view) const noexcept {
+        auto const hash = typename Backend::hasher{}(view);
+        auto const [first, last] = std::ranges::equal_range(by_hash_, hash, {}, &HashEntry::hash);
+
+        for (auto it = first; it != last; ++it) {
+            if (typename Backend::equal{}(view, *values_[static_cast<size_t>(it->id.to_underlying()) - 1])) {
+                return it->id;
+            }
+        }
+
+        return backend_id_type{};
+    }
+
+    /**
+     * @return a view of the value with the given id or nullopt if there is no such value
+     */
+    [[nodiscard]] std::optional<backend_view_type> find_value(backend_id_type const id) const noexcept {
+        auto const ix = static_cast<size_t>(id.to_underlying()) - 1;
+        if (id == backend_id_type{} || ix >= values_.size() || !values_[ix].has_value()) {
+            return std::nullopt;
+        }
+
+        return static_cast<backend_view_type>(*values_[ix]);
+    }
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_FROZENVALUETABLE_HPP
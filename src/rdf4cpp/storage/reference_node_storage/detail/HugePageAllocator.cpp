@@ -0,0 +1,132 @@
+#include "HugePageAllocator.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifdef RDF4CPP_NUMA_INTERLEAVE
+#include <array>
+#include <linux/mempolicy.h>
+#endif
+#endif
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+[[nodiscard]] static size_t round_to_huge_pages(size_t const size) noexcept {
+    return (size + HugePageMemory::huge_page_size - 1) & ~(HugePageMemory::huge_page_size - 1);
+}
+
+#if defined(__linux__)
+
+#ifdef RDF4CPP_NUMA_INTERLEAVE
+/**
+ * The NUMA nodes this process may allocate from, queried once
+ */
+struct AllowedNodes {
+    static constexpr size_t max_nodes = 1024;
+    static constexpr size_t bits_per_word = sizeof(unsigned long) * 8;
+
+    std::array<unsigned long, max_nodes / bits_per_word> mask{};
+    bool valid = false;
+};
+
+[[nodiscard]] static AllowedNodes const &allowed_nodes() noexcept {
+    static AllowedNodes const nodes = []() noexcept {
+        AllowedNodes ret;
+        ret.valid = ::syscall(SYS_get_mempolicy, nullptr, ret.mask.data(), AllowedNodes::max_nodes, nullptr, MPOL_F_MEMS_ALLOWED) == 0;
+        return ret;
+    }();
+
+    return nodes;
+}
+#endif
+
+/**
+ * Maps size bytes of anonymous memory aligned to huge_page_size.
+ * The memory is not touched, therefore the advice given afterwards applies to all of its pages.
+ *
+ * @pre size is a multiple of huge_page_size
+ */
+[[nodiscard]] static void *map_aligned(size_t const size) {
+    // over-allocate by one huge page and trim the unaligned head and the remaining tail
+    auto const mapped_size = size + HugePageMemory::huge_page_size;
+    void *const mapped = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED) {
+        throw std::bad_alloc{};
+    }
+
+    auto const begin = reinterpret_cast<uintptr_t>(mapped);
+    auto const aligned_begin = (begin + HugePageMemory::huge_page_size - 1) & ~(HugePageMemory::huge_page_size - 1);
+
+    if (auto const head = aligned_begin - begin; head != 0) {
+        ::munmap(mapped, head);
+    }
+
+    if (auto const tail = begin + mapped_size - (aligned_begin + size); tail != 0) {
+        ::munmap(reinterpret_cast<void *>(aligned_begin + size), tail);
+    }
+
+    return reinterpret_cast<void *>(aligned_begin);
+}
+
+void *HugePageMemory::allocate(size_t const size, size_t const alignment) {
+    assert(alignment <= huge_page_size);
+
+    if (size < huge_page_size) {
+        return ::operator new(size, std::align_val_t{alignment});
+    }
+
+    auto const rounded_size = round_to_huge_pages(size);
+    void *const ptr = map_aligned(rounded_size);
+
+#ifdef MADV_HUGEPAGE
+    ::madvise(ptr, rounded_size, MADV_HUGEPAGE);
+#endif
+
+#ifdef RDF4CPP_NUMA_INTERLEAVE
+    if (auto const &nodes = allowed_nodes(); nodes.valid) {
+        // the kernel ignores the last bit of the mask, hence the + 1
+        ::syscall(SYS_mbind, ptr, rounded_size, MPOL_INTERLEAVE, nodes.mask.data(), AllowedNodes::max_nodes + 1, 0);
+    }
+#endif
+
+    return ptr;
+}
+
+void HugePageMemory::deallocate(void *const ptr, size_t const size, size_t const alignment) noexcept {
+    if (size < huge_page_size) {
+        ::operator delete(ptr, size, std::align_val_t{alignment});
+        return;
+    }
+
+    ::munmap(ptr, round_to_huge_pages(size));
+}
+
+#else
+
+void *HugePageMemory::allocate(size_t const size, size_t const alignment) {
+    assert(alignment <= huge_page_size);
+
+    if (size < huge_page_size) {
+        return ::operator new(size, std::align_val_t{alignment});
+    }
+
+    return ::operator new(round_to_huge_pages(size), std::align_val_t{huge_page_size});
+}
+
+void HugePageMemory::deallocate(void *const ptr, size_t const size, size_t const alignment) noexcept {
+    if (size < huge_page_size) {
+        ::operator delete(ptr, size, std::align_val_t{alignment});
+        return;
+    }
+
+    ::operator delete(ptr, round_to_huge_pages(size), std::align_val_t{huge_page_size});
+}
+
+#endif
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
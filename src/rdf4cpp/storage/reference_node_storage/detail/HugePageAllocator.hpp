@@ -0,0 +1,77 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_HUGEPAGEALLOCATOR_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_HUGEPAGEALLOCATOR_HPP
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * The memory source of HugePageAllocator.
+ *
+ * Allocations of at least huge_page_size bytes are mapped directly from the operating system, aligned to huge_page_size,
+ * and advised to be backed by transparent huge pages (madvise(MADV_HUGEPAGE)), which reduces the TLB misses of random probes into large hash tables.
+ * If RDF4CPP_NUMA_INTERLEAVE is defined, their pages are additionally interleaved over all NUMA nodes the process may use (mbind(MPOL_INTERLEAVE)),
+ * such that threads on every socket see the same average latency instead of some of them always paying for remote memory.
+ * Both are only advice, they are silently skipped if the system does not support them (e.g. transparent huge pages are disabled).
+ *
+ * Smaller allocations are forwarded to the global operator new.
+ */
+struct HugePageMemory {
+    static constexpr size_t huge_page_size = size_t{1} << 21;
+
+    /**
+     * @param size number of bytes
+     * @param alignment alignment of the allocation, must be a power of two and at most huge_page_size
+     */
+    [[nodiscard]] static void *allocate(size_t size, size_t alignment);
+
+    /**
+     * @param ptr pointer returned by allocate
+     * @param size size that was passed to allocate
+     * @param alignment alignment that was passed to allocate
+     */
+    static void deallocate(void *ptr, size_t size, size_t alignment) noexcept;
+};
+
+/**
+ * A stateless allocator that serves large allocations from transparent huge pages, see HugePageMemory.
+ * Meant as the upstream allocator of the reference node storages (e.g. HugePageSyncReferenceNodeStorage),
+ * where it backs the forward and backward tables of the dictionaries.
+ *
+ * @tparam T value type
+ */
+template<typename T>
+struct HugePageAllocator {
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    constexpr HugePageAllocator() noexcept = default;
+
+    template<typename U>
+    constexpr HugePageAllocator(HugePageAllocator<U> const &) noexcept {
+    }
+
+    [[nodiscard]] T *allocate(size_t const n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]] {
+            throw std::bad_array_new_length{};
+        }
+
+        return static_cast<T *>(HugePageMemory::allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, size_t const n) noexcept {
+        HugePageMemory::deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    template<typename U>
+    bool operator==(HugePageAllocator<U> const &) const noexcept {
+        return true;
+    }
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_HUGEPAGEALLOCATOR_HPP
@@ -1,6 +1,7 @@
 #ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_INDEXFREELIST_HPP
 #define RDF4CPP_RDF_REFERENCENODESTORAGE_INDEXFREELIST_HPP
 
+#include <bit>
 #include <cstddef>
 #include <ranges>
 #include <vector>
@@ -143,8 +144,20 @@ public:
         }
     }
 
+    /**
+     * @return number of occupied indices
+     */
+    [[nodiscard]] size_type occupied_count() const noexcept {
+        size_type ret = 0;
+        for (auto const bitmap : occupied_bitmap_) {
+            ret += std::popcount(bitmap);
+        }
+        return ret;
+    }
+
     void clear() noexcept {
         occupied_bitmap_.clear();
+        next_free_ix_ = 0;
     }
 };
 
@@ -0,0 +1,267 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_NODESTORAGESNAPSHOT_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_NODESTORAGESNAPSHOT_HPP
+
+#include <rdf4cpp/datatypes/registry/DatatypeRegistry.hpp>
+#include <rdf4cpp/storage/view/BNodeBackendView.hpp>
+#include <rdf4cpp/storage/view/IRIBackendView.hpp>
+#include <rdf4cpp/storage/view/LiteralBackendView.hpp>
+#include <rdf4cpp/storage/view/VariableBackendView.hpp>
+#include <rdf4cpp/version.hpp>
+#include <rdf4cpp/writer/BufWriter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Binary snapshot format of the reference node storages.
+ *
+ * A snapshot consists of a header followed by one section per node type storage.
+ * All integers are written as uint64_t in native byte order, strings are written as their size followed by their bytes.
+ *
+ *      header:  magic (8 bytes) | pobr_version | number of sections
+ *      section: tag | id capacity | number of entries | entries
+ *      entry:   id | payload (depends on the backend view type, see write_payload)
+ *
+ * Literals with specialized storage are written in their canonical lexical form, the reverse index (value to id) is not written
+ * but rebuilt on restore.
+ * Changing the format requires bumping POBR_VERSION.
+ */
+namespace rdf4cpp::storage::reference_node_storage::detail::snapshot {
+
+inline constexpr std::array<char, 8> magic{'r', '4', 'c', 's', 'n', 'a', 'p', '\0'};
+
+/**
+ * Tags of the sections, shared by all storages that write snapshots
+ */
+namespace tags {
+    inline constexpr uint64_t bnode = 0;
+    inline constexpr uint64_t iri = 1;
+    inline constexpr uint64_t variable = 2;
+    inline constexpr uint64_t fallback_literal = 3;
+
+    template<typename Storage>
+    inline constexpr uint64_t specialized_literal = 4 + Storage::backend_type::datatype.to_underlying();
+} // namespace tags
+
+inline void write_u64(std::ostream &out, uint64_t const value) {
+    out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+inline void write_string(std::ostream &out, std::string_view const s) {
+    write_u64(out, s.size());
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+inline void check_stream(std::istream const &in) {
+    if (!in) {
+        throw std::runtime_error{"truncated or unreadable node storage snapshot"};
+    }
+}
+
+[[nodiscard]] inline uint64_t read_u64(std::istream &in) {
+    uint64_t value;
+    in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    check_stream(in);
+    return value;
+}
+
+/**
+ * Reads a string into buf, which must outlive the returned view.
+ * The string is read in chunks, so a corrupt size fails at the end of the stream instead of allocating all of it up front.
+ */
+[[nodiscard]] inline std::string_view read_string(std::istream &in, std::string &buf) {
+    static constexpr uint64_t chunk_size = 1 << 16;
+
+    auto const size = read_u64(in);
+    if (size > buf.max_size()) {
+        throw std::runtime_error{"invalid string size in node storage snapshot"};
+    }
+
+    buf.clear();
+    while (buf.size() < size) {
+        auto const offset = buf.size();
+        auto const len = std::min(size - offset, chunk_size);
+
+        buf.resize(offset + len);
+        in.read(buf.data() + offset, static_cast<std::streamsize>(len));
+        check_stream(in);
+    }
+
+    return buf;
+}
+
+inline void write_header(std::ostream &out, size_t const num_sections) {
+    out.write(magic.data(), magic.size());
+    write_u64(out, static_cast<uint64_t>(pobr_version));
+    write_u64(out, num_sections);
+}
+
+/**
+ * @throws std::runtime_error if the header does not belong to a snapshot with num_sections sections written with the current pobr_version
+ */
+inline void read_header(std::istream &in, size_t const num_sections) {
+    std::array<char, 8> actual_magic;
+    in.read(actual_magic.data(), actual_magic.size());
+    check_stream(in);
+
+    if (actual_magic != magic) {
+        throw std::runtime_error{"not a node storage snapshot"};
+    }
+
+    if (auto const version = read_u64(in); version != static_cast<uint64_t>(pobr_version)) {
+        throw std::runtime_error{"incompatible binary representation version (pobr_version " + std::to_string(version)
+                                 + ", expected " + std::to_string(pobr_version) + ") of node storage snapshot"};
+    }
+
+    if (read_u64(in) != num_sections) {
+        throw std::runtime_error{"incompatible node storage layout of node storage snapshot"};
+    }
+}
+
+/**
+ * Buffers that keep the strings of a view that was read alive
+ */
+struct ReadBuffers {
+    std::string first;
+    std::string second;
+};
+
+inline void write_payload(std::ostream &out, view::IRIBackendView const &view) {
+    write_string(out, view.identifier);
+}
+
+inline void read_payload(std::istream &in, ReadBuffers &bufs, view::IRIBackendView &view) {
+    view.identifier = read_string(in, bufs.first);
+}
+
+inline void write_payload(std::ostream &out, view::BNodeBackendView const &view) {
+    write_string(out, view.identifier);
+}
+
+inline void read_payload(std::istream &in, ReadBuffers &bufs, view::BNodeBackendView &view) {
+    view.identifier = read_string(in, bufs.first);
+}
+
+inline void write_payload(std::ostream &out, view::VariableBackendView const &view) {
+    write_string(out, view.name);
+    write_u64(out, view.is_anonymous);
+}
+
+inline void read_payload(std::istream &in, ReadBuffers &bufs, view::VariableBackendView &view) {
+    view.name = read_string(in, bufs.first);
+    view.is_anonymous = read_u64(in) != 0;
+}
+
+inline void write_payload(std::ostream &out, view::LexicalFormLiteralBackendView const &view) {
+    write_u64(out, view.datatype_id.to_underlying());
+    write_string(out, view.lexical_form);
+    write_string(out, view.language_tag);
+    write_u64(out, view.needs_escape);
+}
+
+inline void read_payload(std::istream &in, ReadBuffers &bufs, view::LexicalFormLiteralBackendView &view) {
+    view.datatype_id = identifier::NodeBackendID{read_u64(in)};
+    view.lexical_form = read_string(in, bufs.first);
+    view.language_tag = read_string(in, bufs.second);
+    view.needs_escape = read_u64(in) != 0;
+}
+
+inline void write_payload(std::ostream &out, view::ValueLiteralBackendView const &view) {
+    auto const serialize = datatypes::registry::DatatypeRegistry::get_serialize_canonical_string(datatypes::registry::DatatypeIDView{view.datatype});
+    assert(serialize != nullptr);
+
+    write_string(out, writer::StringWriter::oneshot([&](writer::StringWriter &w) noexcept {
+        return serialize(view.value, w);
+    }));
+}
+
+/**
+ * @pre view.datatype is already set
+ */
+inline void read_payload(std::istream &in, ReadBuffers &bufs, view::ValueLiteralBackendView &view) {
+    auto const factory = datatypes::registry::DatatypeRegistry::get_factory(datatypes::registry::DatatypeIDView{view.datatype});
+    assert(factory != nullptr);
+
+    view.value = factory(read_string(in, bufs.first));
+}
+
+/**
+ * Writes the section of a single node type storage
+ *
+ * @param tag identifies the storage, is checked on restore
+ */
+template<typename Storage>
+void write_section(std::ostream &out, uint64_t const tag, Storage const &storage) {
+    write_u64(out, tag);
+    write_u64(out, storage.mapping.size());
+    write_u64(out, storage.mapping.entry_count());
+
+    storage.mapping.for_each([&out](auto const id, auto const &view) {
+        write_u64(out, id.to_underlying());
+        write_payload(out, view);
+    });
+}
+
+/**
+ * Restores the section of a single node type storage written by write_section.
+ * All ids are preserved, ids below min_id that are not part of the snapshot stay reserved.
+ *
+ * Ids are reserved as the entries are read instead of reserving the written id capacity up front,
+ * such that a corrupt capacity cannot force a huge allocation. Therefore vacant ids behind the last entry are not restored,
+ * which does not change the ids of future inserts, because vacant ids are reused lowest first.
+ *
+ * @pre storage only contains nodes that are also in the snapshot, at the same ids
+ */
+template<typename Storage>
+void read_section(std::istream &in, uint64_t const tag, Storage &storage, typename Storage::backend_id_type const min_id) {
+    using backend_id_type = typename Storage::backend_id_type;
+
+    if (read_u64(in) != tag) {
+        throw std::runtime_error{"incompatible node storage layout of node storage snapshot"};
+    }
+
+    // capacity + 1 must still be a valid id
+    static constexpr uint64_t max_capacity = (uint64_t{1} << backend_id_type::width) - 2;
+
+    auto const capacity = read_u64(in);
+    auto const num_entries = read_u64(in);
+    if (capacity > max_capacity || num_entries > capacity) {
+        throw std::runtime_error{"invalid section size in node storage snapshot"};
+    }
+
+    ReadBuffers bufs;
+    auto view = Storage::get_default_view();
+    uint64_t prev_id = 0;
+
+    for (uint64_t ix = 0; ix < num_entries; ++ix) {
+        // write_section writes the entries in ascending order of their ids
+        auto const id = read_u64(in);
+        if (id <= prev_id || id > capacity) {
+            throw std::runtime_error{"invalid id in node storage snapshot"};
+        }
+        prev_id = id;
+
+        read_payload(in, bufs, view);
+        storage.mapping.reserve_until(backend_id_type{id + 1});
+
+        if (storage.mapping.lookup_value(backend_id_type{id}).has_value()) {
+            // e.g. the predefined IRIs, which are already present
+            continue;
+        }
+
+        storage.mapping.insert_assume_not_present_at(view, backend_id_type{id});
+    }
+
+    storage.mapping.vacate_unassigned(min_id);
+}
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail::snapshot
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_NODESTORAGESNAPSHOT_HPP
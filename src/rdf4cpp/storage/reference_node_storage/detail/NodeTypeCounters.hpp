@@ -0,0 +1,101 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_NODETYPECOUNTERS_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_NODETYPECOUNTERS_HPP
+
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+#ifdef RDF4CPP_NODE_STORAGE_STATS
+
+/**
+ * Runtime counters of a SyncNodeTypeStorage, see NodeTypeStats.
+ * All counters are relaxed atomics, they are only meant to be read for statistics.
+ */
+struct NodeTypeCounters {
+private:
+    std::atomic<uint64_t> lookup_hits_ = 0;
+    std::atomic<uint64_t> lookup_misses_ = 0;
+    std::atomic<uint64_t> inserts_ = 0;
+    std::atomic<uint64_t> shared_lock_wait_ns_ = 0;
+    std::atomic<uint64_t> unique_lock_wait_ns_ = 0;
+
+    template<typename Lock>
+    static Lock timed_lock(std::shared_mutex &mutex, std::atomic<uint64_t> &wait_ns) {
+        auto const start = std::chrono::steady_clock::now();
+        Lock lock{mutex};
+        auto const waited = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        wait_ns.fetch_add(static_cast<uint64_t>(waited.count()), std::memory_order_relaxed);
+        return lock;
+    }
+
+public:
+    void hit() noexcept {
+        lookup_hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void miss() noexcept {
+        lookup_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void insert() noexcept {
+        inserts_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::shared_lock<std::shared_mutex> lock_shared(std::shared_mutex &mutex) {
+        return timed_lock<std::shared_lock<std::shared_mutex>>(mutex, shared_lock_wait_ns_);
+    }
+
+    [[nodiscard]] std::unique_lock<std::shared_mutex> lock_unique(std::shared_mutex &mutex) {
+        return timed_lock<std::unique_lock<std::shared_mutex>>(mutex, unique_lock_wait_ns_);
+    }
+
+    /**
+     * Writes the counters into the corresponding fields of stats
+     */
+    void export_to(NodeTypeStats &stats) const noexcept {
+        stats.lookup_hits = lookup_hits_.load(std::memory_order_relaxed);
+        stats.lookup_misses = lookup_misses_.load(std::memory_order_relaxed);
+        stats.inserts = inserts_.load(std::memory_order_relaxed);
+        stats.shared_lock_wait_ns = shared_lock_wait_ns_.load(std::memory_order_relaxed);
+        stats.unique_lock_wait_ns = unique_lock_wait_ns_.load(std::memory_order_relaxed);
+    }
+};
+
+#else
+
+/**
+ * Disabled counters, everything compiles to nothing. Define RDF4CPP_NODE_STORAGE_STATS to enable them.
+ */
+struct NodeTypeCounters {
+    void hit() noexcept {
+    }
+
+    void miss() noexcept {
+    }
+
+    void insert() noexcept {
+    }
+
+    [[nodiscard]] std::shared_lock<std::shared_mutex> lock_shared(std::shared_mutex &mutex) {
+        return std::shared_lock{mutex};
+    }
+
+    [[nodiscard]] std::unique_lock<std::shared_mutex> lock_unique(std::shared_mutex &mutex) {
+        return std::unique_lock{mutex};
+    }
+
+    void export_to(NodeTypeStats &) const noexcept {
+    }
+};
+
+#endif
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_NODETYPECOUNTERS_HPP
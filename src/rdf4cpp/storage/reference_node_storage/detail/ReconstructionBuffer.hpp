@@ -0,0 +1,55 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_RECONSTRUCTIONBUFFER_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_RECONSTRUCTIONBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * Number of thread-local reconstruction buffers, see next_reconstruction_buffer
+ */
+inline constexpr size_t reconstruction_buffer_count = 16;
+
+/**
+ * Storages that do not keep their strings contiguously in memory (e.g. because they are compressed)
+ * reconstruct them into thread-local buffers to be able to hand out views.
+ * The buffers are reused round robin, i.e. a view into the returned buffer stays valid until
+ * the calling thread has requested reconstruction_buffer_count further buffers.
+ *
+ * @return the next reconstruction buffer of the calling thread
+ */
+[[nodiscard]] inline std::string &next_reconstruction_buffer() noexcept {
+    thread_local std::array<std::string, reconstruction_buffer_count> buffers;
+    thread_local size_t next_buffer = 0;
+
+    auto &buffer = buffers[next_buffer];
+    next_buffer = (next_buffer + 1) % reconstruction_buffer_count;
+    return buffer;
+}
+
+/**
+ * Size of the fixed-size thread-local reconstruction buffers, see next_fixed_reconstruction_buffer
+ */
+inline constexpr size_t fixed_reconstruction_buffer_size = 512;
+
+/**
+ * Like next_reconstruction_buffer, but the buffers have a fixed size and never allocate.
+ * For callers that must not throw and only reconstruct strings of at most fixed_reconstruction_buffer_size bytes.
+ * The buffers are reused round robin independently of the ones of next_reconstruction_buffer.
+ *
+ * @return the next fixed-size reconstruction buffer of the calling thread
+ */
+[[nodiscard]] inline std::array<char, fixed_reconstruction_buffer_size> &next_fixed_reconstruction_buffer() noexcept {
+    thread_local std::array<std::array<char, fixed_reconstruction_buffer_size>, reconstruction_buffer_count> buffers;
+    thread_local size_t next_buffer = 0;
+
+    auto &buffer = buffers[next_buffer];
+    next_buffer = (next_buffer + 1) % reconstruction_buffer_count;
+    return buffer;
+}
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_RECONSTRUCTIONBUFFER_HPP
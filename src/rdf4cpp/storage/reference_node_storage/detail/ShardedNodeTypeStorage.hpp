@@ -0,0 +1,171 @@
+#ifndef RDF4CPP_SHARDEDNODETYPESTORAGE_HPP
+#define RDF4CPP_SHARDEDNODETYPESTORAGE_HPP
+
+#include <rdf4cpp/storage/reference_node_storage/detail/SyncNodeTypeStorage.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace rdf4cpp::storage::reference_node_storage {
+
+/**
+ * Storage for one of the Node Backend types that is split into a fixed number of independently locked shards.
+ * A Node Backend is assigned to a shard by its hash, therefore threads interning different Node Backends
+ * rarely contend on the same mutex.
+ *
+ * Every shard hands out ids from its own sub-range of the id space: the ids are interleaved such that
+ * shard s owns exactly the ids min_id + k * shard_count + s for k >= 0.
+ * Therefore an id can be mapped back to its shard without any lookup.
+ *
+ * @tparam BackendType_t one of BNodeBackend, IRIBackend, FallbackLiteralBackend, SpecializedLiteralBackend and VariableBackend.
+ */
+template<typename BackendType_t>
+struct ShardedNodeTypeStorage {
+    using shard_type = SyncNodeTypeStorage<BackendType_t>;
+    using backend_type = typename shard_type::backend_type;
+    using backend_view_type = typename shard_type::backend_view_type;
+    using backend_id_type = typename shard_type::backend_id_type;
+    using backend_hasher = typename shard_type::backend_hasher;
+
+private:
+    // each shard gets its own cache lines, to avoid false sharing between the mutexes of neighbouring shards
+    struct alignas(64) AlignedShard {
+        shard_type shard;
+    };
+
+    std::unique_ptr<AlignedShard[]> shards_;
+    size_t shard_count_;
+    uint64_t min_id_;
+
+    /**
+     * @return true if the global id of local_id in shard shard_ix is representable with backend_id_type::width bits
+     */
+    [[nodiscard]] bool fits_id_width(size_t const shard_ix, backend_id_type const local_id) const noexcept {
+        static constexpr uint64_t max_id = (uint64_t{1} << backend_id_type::width) - 1;
+
+        // min_id_ + (local_id - 1) * shard_count_ + shard_ix <= max_id, rearranged to not overflow
+        auto const room = max_id - min_id_;
+        return shard_ix <= room && static_cast<uint64_t>(local_id) - 1 <= (room - shard_ix) / shard_count_;
+    }
+
+public:
+    /**
+     * @param shard_count number of shards, must be at least 1
+     * @param min_id smallest id handed out by this storage
+     */
+    ShardedNodeTypeStorage(size_t const shard_count, backend_id_type const min_id) : shards_{std::make_unique<AlignedShard[]>(shard_count)},
+                                                                                     shard_count_{shard_count},
+                                                                                     min_id_{static_cast<uint64_t>(min_id)} {
+        assert(shard_count_ > 0);
+    }
+
+    [[nodiscard]] size_t shard_count() const noexcept {
+        return shard_count_;
+    }
+
+    [[nodiscard]] shard_type &shard(size_t const shard_ix) noexcept {
+        return shards_[shard_ix].shard;
+    }
+
+    [[nodiscard]] shard_type const &shard(size_t const shard_ix) const noexcept {
+        return shards_[shard_ix].shard;
+    }
+
+    /**
+     * @return statistics of this storage, i.e. the statistics of all shards summed up (see NodeTypeStats)
+     */
+    [[nodiscard]] NodeTypeStats stats() const {
+        NodeTypeStats ret;
+        for (size_t shard_ix = 0; shard_ix < shard_count_; ++shard_ix) {
+            ret += shard(shard_ix).stats();
+        }
+        return ret;
+    }
+
+    /**
+     * Determines the shard responsible for the given view.
+     * Uses the upper half of the hash, because the hash tables inside of the shards use the lower bits to select buckets.
+     */
+    [[nodiscard]] size_t shard_index(backend_view_type const &view) const noexcept {
+        return shard_index_of_hash(backend_hasher{}(view));
+    }
+
+    /**
+     * Determines the shard responsible for a view with the given hash.
+     */
+    [[nodiscard]] size_t shard_index_of_hash(size_t const hash) const noexcept {
+        return static_cast<size_t>(((static_cast<uint64_t>(hash) >> 32) * shard_count_) >> 32);
+    }
+
+    /**
+     * Translates an id local to shard shard_ix into an id of this storage.
+     * local_id must have been handed out by insert_assume_not_present, which ensures that the result fits into backend_id_type.
+     */
+    [[nodiscard]] backend_id_type to_global_id(size_t const shard_ix, backend_id_type const local_id) const noexcept {
+        assert(local_id != backend_id_type{});
+        assert(fits_id_width(shard_ix, local_id));
+        return backend_id_type{min_id_ + (static_cast<uint64_t>(local_id) - 1) * shard_count_ + shard_ix};
+    }
+
+    /**
+     * Inserts view into shard shard_ix, the shard must be locked uniquely by the caller.
+     *
+     * @param hash the hash of view
+     * @return the id of view in this storage (not local to the shard)
+     * @throws std::length_error if the id of view would not fit into backend_id_type, view is not inserted in that case
+     */
+    [[nodiscard]] backend_id_type insert_assume_not_present(size_t const shard_ix, backend_view_type const &view, size_t const hash) {
+        auto &mapping = shard(shard_ix).mapping;
+        auto const local_id = mapping.insert_assume_not_present(view, hash);
+
+        if (!fits_id_width(shard_ix, local_id)) [[unlikely]] {
+            mapping.erase_assume_present(local_id);
+            throw std::length_error{"ShardedNodeTypeStorage: id space exhausted"};
+        }
+
+        return to_global_id(shard_ix, local_id);
+    }
+
+    /**
+     * Translates an id of this storage into the responsible shard and the id local to that shard.
+     * @return (shard index, local id), the local id is null if id is not in the range of this storage
+     */
+    [[nodiscard]] std::pair<size_t, backend_id_type> to_local_id(backend_id_type const id) const noexcept {
+        auto const raw = static_cast<uint64_t>(id);
+        if (raw < min_id_) [[unlikely]] {
+            return {0, backend_id_type{}};
+        }
+
+        auto const offset = raw - min_id_;
+        return {static_cast<size_t>(offset % shard_count_), backend_id_type{offset / shard_count_ + 1}};
+    }
+
+    /**
+     * Translates the given backend_id_type into a NodeID
+     */
+    static identifier::NodeBackendID from_storage_id(backend_id_type const id, backend_view_type const &view) noexcept {
+        return shard_type::from_storage_id(id, view);
+    }
+
+    /**
+     * Translates the given NodeID into a backend_id_type
+     */
+    static backend_id_type to_storage_id(identifier::NodeBackendID const id) noexcept {
+        return shard_type::to_storage_id(id);
+    }
+
+    /**
+     * Gets the default value for the view type of this backend
+     */
+    static backend_view_type get_default_view() noexcept {
+        return shard_type::get_default_view();
+    }
+};
+
+}  // namespace rdf4cpp::storage::reference_node_storage
+
+#endif  //RDF4CPP_SHARDEDNODETYPESTORAGE_HPP
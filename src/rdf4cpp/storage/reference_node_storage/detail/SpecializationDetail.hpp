@@ -1,7 +1,11 @@
 #ifndef RDF4CPP_REFERENCENODESTORAGE_COMMON_HPP
 #define RDF4CPP_REFERENCENODESTORAGE_COMMON_HPP
 
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <dice/template-library/tuple_algorithm.hpp>
 #include <rdf4cpp/datatypes/xsd.hpp>
@@ -9,6 +13,50 @@
 
 namespace rdf4cpp::storage::reference_node_storage::specialization_detail {
 
+/**
+ * The datatypes that have a specialized storage, i.e. whose literals are stored by value instead of by lexical form.
+ * This is the one list shared by all node storages (reference, sharded, frozen and persistent),
+ * their tuples of specialized storages are derived from it with specialized_storage_tuple.
+ */
+using specialized_datatypes = std::tuple<datatypes::xsd::Integer,
+                                         datatypes::xsd::NonNegativeInteger,
+                                         datatypes::xsd::PositiveInteger,
+                                         datatypes::xsd::NonPositiveInteger,
+                                         datatypes::xsd::NegativeInteger,
+                                         datatypes::xsd::Long,
+                                         datatypes::xsd::UnsignedLong,
+
+                                         datatypes::xsd::Decimal,
+                                         datatypes::xsd::Double,
+
+                                         datatypes::xsd::Base64Binary,
+                                         datatypes::xsd::HexBinary,
+
+                                         datatypes::xsd::Date,
+                                         datatypes::xsd::Time,
+                                         datatypes::xsd::DateTime,
+                                         datatypes::xsd::DateTimeStamp,
+                                         datatypes::xsd::GYearMonth,
+                                         datatypes::xsd::Duration,
+                                         datatypes::xsd::DayTimeDuration,
+                                         datatypes::xsd::YearMonthDuration>;
+
+template<typename Datatypes, template<typename> typename StorageOf>
+struct specialized_storage_tuple_impl;
+
+template<typename ...Datatypes, template<typename> typename StorageOf>
+struct specialized_storage_tuple_impl<std::tuple<Datatypes...>, StorageOf> {
+    using type = std::tuple<StorageOf<Datatypes>...>;
+};
+
+/**
+ * A tuple that contains StorageOf<Datatype> for every Datatype in specialized_datatypes, in the same order.
+ *
+ * @tparam StorageOf maps a datatype to the specialized storage for it, e.g. an alias for SyncNodeTypeStorage<SpecializedLiteralBackend<Datatype>>
+ */
+template<template<typename> typename StorageOf>
+using specialized_storage_tuple = typename specialized_storage_tuple_impl<specialized_datatypes, StorageOf>::type;
+
 /**
  * Generates a storage specialization lookup-table for the reference node storages.
  * The returned array is indexed with identifier::LiteralType and contains true
@@ -30,60 +78,57 @@ static consteval std::array<bool, 1 << identifier::LiteralType::width> make_stor
 }
 
 /**
- * Calls the given function f with the specialized object for the given datatype
+ * Finds the position of the specialized storage for Datatype in Tuple.
+ * Fails to compile if Tuple does not contain a specialized storage for Datatype.
  *
- * @param container any container for specialized things in the correct order (i.e. specialized_literal_storage_ or next_specialized_literal_ids_)
- * @param datatype the datatype of the specialized object
+ * @tparam Tuple a tuple of specialized storages, see make_storage_specialization_lut
+ * @tparam Datatype the datatype of the requested storage
+ * @return index of the storage for Datatype in Tuple
+ */
+template<typename Tuple, typename Datatype>
+static consteval size_t storage_index() noexcept {
+    size_t ret = std::tuple_size_v<Tuple>;
+    size_t ix = 0;
+
+    dice::template_library::tuple_type_for_each<Tuple>([&]<typename T>() {
+        if (T::backend_type::literal_type::fixed_id == Datatype::fixed_id) {
+            ret = ix;
+        }
+        ++ix;
+    });
+
+    return ret;
+}
+
+/**
+ * Calls the given function f with the specialized object for the given datatype.
+ * The dispatch is derived from the element types of the container (and therefore from specialized_datatypes),
+ * so that there is no second list of datatypes that could diverge from it.
+ *
+ * @param container a tuple of specialized storages in any order (i.e. specialized_literal_storage_)
+ * @param datatype the datatype of the specialized object, there must be a specialized object for it in container
  * @param f the function to call with the corresponding specialized object
  * @return whatever f returns
  */
 template<typename S, typename F>
 decltype(auto) visit_specialized(S &&container, identifier::LiteralType const datatype, F f) {
-    using namespace rdf4cpp::datatypes;
-
-    // manually translate runtime knowledge to compiletime
-    // can probably be done using metaprogramming, but this is faster
-    switch (datatype.to_underlying()) {
-        case xsd::Integer::fixed_id.to_underlying():
-            return f(std::get<0>(std::forward<S>(container)));
-        case xsd::NonNegativeInteger::fixed_id.to_underlying():
-            return f(std::get<1>(std::forward<S>(container)));
-        case xsd::PositiveInteger::fixed_id.to_underlying():
-            return f(std::get<2>(std::forward<S>(container)));
-        case xsd::NonPositiveInteger::fixed_id.to_underlying():
-            return f(std::get<3>(std::forward<S>(container)));
-        case xsd::NegativeInteger::fixed_id.to_underlying():
-            return f(std::get<4>(std::forward<S>(container)));
-        case xsd::Long::fixed_id.to_underlying():
-            return f(std::get<5>(std::forward<S>(container)));
-        case xsd::UnsignedLong::fixed_id.to_underlying():
-            return f(std::get<6>(std::forward<S>(container)));
-        case xsd::Decimal::fixed_id.to_underlying():
-            return f(std::get<7>(std::forward<S>(container)));
-        case xsd::Double::fixed_id.to_underlying():
-            return f(std::get<8>(std::forward<S>(container)));
-        case xsd::Base64Binary::fixed_id.to_underlying():
-            return f(std::get<9>(std::forward<S>(container)));
-        case xsd::HexBinary::fixed_id.to_underlying():
-            return f(std::get<10>(std::forward<S>(container)));
-        case xsd::Date::fixed_id.to_underlying():
-            return f(std::get<11>(std::forward<S>(container)));
-        case xsd::DateTime::fixed_id.to_underlying():
-            return f(std::get<12>(std::forward<S>(container)));
-        case xsd::DateTimeStamp::fixed_id.to_underlying():
-            return f(std::get<13>(std::forward<S>(container)));
-        case xsd::GYearMonth::fixed_id.to_underlying():
-            return f(std::get<14>(std::forward<S>(container)));
-        case xsd::Duration::fixed_id.to_underlying():
-            return f(std::get<15>(std::forward<S>(container)));
-        case xsd::DayTimeDuration::fixed_id.to_underlying():
-            return f(std::get<16>(std::forward<S>(container)));
-        case xsd::YearMonthDuration::fixed_id.to_underlying():
-            return f(std::get<17>(std::forward<S>(container)));
-        default:
-            assert(false);
-            __builtin_unreachable();
-    }
+    using container_type = std::remove_cvref_t<S>;
+    using result_type = decltype(f(std::get<0>(std::forward<S>(container))));
+    using dispatch_type = result_type (*)(S &&, F &);
+
+    // translate runtime knowledge to compiletime with a lookup table, which compiles to the same jump table as a switch would
+    static constexpr auto dispatch_lut = []<size_t... ixs>(std::index_sequence<ixs...>) {
+        std::array<dispatch_type, 1 << identifier::LiteralType::width> ret{};
+        ((ret[std::tuple_element_t<ixs, container_type>::backend_type::literal_type::fixed_id.to_underlying()] = [](S &&c, F &g) -> result_type {
+             return g(std::get<ixs>(std::forward<S>(c)));
+         }),
+         ...);
+        return ret;
+    }(std::make_index_sequence<std::tuple_size_v<container_type>>{});
+
+    auto const dispatch = dispatch_lut[datatype.to_underlying()];
+    assert(dispatch != nullptr);
+    return dispatch(std::forward<S>(container), f);
 }
 
 } // rdf4cpp::storage::reference_node_storage::specialization_detail
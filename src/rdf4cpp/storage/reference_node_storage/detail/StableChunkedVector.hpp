@@ -0,0 +1,166 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_STABLECHUNKEDVECTOR_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_STABLECHUNKEDVECTOR_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * An append-only vector that never relocates its elements.
+ * The elements are stored in chunks of geometrically growing size, chunk k holds first_chunk_size * 2^k elements.
+ * The chunks are found via a fixed-size directory, therefore growing the vector never touches memory that was already handed out.
+ *
+ * Thread-safety: size() and operator[] may be called concurrently with a single thread calling emplace_back or resize (growing),
+ * as long as the readers only access elements that were fully inserted before (i.e. the index was obtained after the insertion).
+ * Readers never perform an atomic read-modify-write, they only do acquire-loads.
+ * All other operations require exclusive access.
+ *
+ * @tparam T element type
+ * @tparam Allocator allocator for the chunks
+ */
+template<typename T, typename Allocator = std::allocator<T>>
+struct StableChunkedVector {
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+
+private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+    static_assert(std::is_pointer_v<typename alloc_traits::pointer>, "StableChunkedVector requires an allocator with raw pointers");
+
+    static constexpr size_type first_chunk_size_log2 = 6;
+    static constexpr size_type first_chunk_size = size_type{1} << first_chunk_size_log2;
+    static constexpr size_type max_chunks = sizeof(size_type) * 8 - first_chunk_size_log2;
+
+    std::array<std::atomic<value_type *>, max_chunks> chunks_{}; //< chunks_[k] stores chunk k or nullptr if it is not allocated yet
+    std::atomic<size_type> size_ = 0;
+    [[no_unique_address]] allocator_type alloc_;
+
+    [[nodiscard]] static constexpr size_type chunk_size(size_type const chunk_ix) noexcept {
+        return first_chunk_size << chunk_ix;
+    }
+
+    /**
+     * Translates an element index into (chunk index, offset into chunk)
+     */
+    [[nodiscard]] static constexpr std::pair<size_type, size_type> locate(size_type const ix) noexcept {
+        auto const chunk_ix = static_cast<size_type>(std::bit_width(ix / first_chunk_size + 1)) - 1;
+        auto const chunk_begin = first_chunk_size * ((size_type{1} << chunk_ix) - 1);
+        return {chunk_ix, ix - chunk_begin};
+    }
+
+    [[nodiscard]] value_type *slot(size_type const ix) const noexcept {
+        auto const [chunk_ix, offset] = locate(ix);
+        return chunks_[chunk_ix].load(std::memory_order_acquire) + offset;
+    }
+
+    void pop_back() noexcept {
+        auto const new_size = size_.load(std::memory_order_relaxed) - 1;
+        alloc_traits::destroy(alloc_, slot(new_size));
+        size_.store(new_size, std::memory_order_release);
+    }
+
+public:
+    StableChunkedVector() noexcept(noexcept(allocator_type{})) = default;
+
+    explicit StableChunkedVector(allocator_type const &alloc) noexcept : alloc_{alloc} {
+    }
+
+    // deleted because readers may hold references into the chunks
+    StableChunkedVector(StableChunkedVector const &) = delete;
+    StableChunkedVector(StableChunkedVector &&) = delete;
+    StableChunkedVector &operator=(StableChunkedVector const &) = delete;
+    StableChunkedVector &operator=(StableChunkedVector &&) = delete;
+
+    ~StableChunkedVector() {
+        clear();
+    }
+
+    [[nodiscard]] size_type size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    [[nodiscard]] reference operator[](size_type const ix) noexcept {
+        assert(ix < size());
+        return *slot(ix);
+    }
+
+    [[nodiscard]] const_reference operator[](size_type const ix) const noexcept {
+        assert(ix < size());
+        return *slot(ix);
+    }
+
+    /**
+     * Constructs a new element at the end. Never relocates existing elements.
+     */
+    template<typename ...Args>
+    reference emplace_back(Args &&...args) {
+        auto const ix = size_.load(std::memory_order_relaxed);
+        auto const [chunk_ix, offset] = locate(ix);
+        assert(chunk_ix < max_chunks);
+
+        auto *chunk = chunks_[chunk_ix].load(std::memory_order_relaxed);
+        if (chunk == nullptr) {
+            chunk = alloc_traits::allocate(alloc_, chunk_size(chunk_ix));
+            chunks_[chunk_ix].store(chunk, std::memory_order_release);
+        }
+
+        alloc_traits::construct(alloc_, chunk + offset, std::forward<Args>(args)...);
+
+        // publish the element
+        size_.store(ix + 1, std::memory_order_release);
+        return chunk[offset];
+    }
+
+    /**
+     * Resizes the vector to contain new_size elements, new elements are value-initialized.
+     */
+    void resize(size_type const new_size) {
+        while (size_.load(std::memory_order_relaxed) < new_size) {
+            emplace_back();
+        }
+
+        while (size_.load(std::memory_order_relaxed) > new_size) {
+            pop_back();
+        }
+    }
+
+    /**
+     * Releases all chunks that do not contain any elements.
+     */
+    void shrink_to_fit() noexcept {
+        auto const sz = size_.load(std::memory_order_relaxed);
+        auto const first_unused_chunk = sz == 0 ? 0 : locate(sz - 1).first + 1;
+
+        for (auto chunk_ix = first_unused_chunk; chunk_ix < max_chunks; ++chunk_ix) {
+            if (auto *chunk = chunks_[chunk_ix].exchange(nullptr, std::memory_order_relaxed); chunk != nullptr) {
+                alloc_traits::deallocate(alloc_, chunk, chunk_size(chunk_ix));
+            }
+        }
+    }
+
+    void clear() noexcept {
+        while (size_.load(std::memory_order_relaxed) > 0) {
+            pop_back();
+        }
+        shrink_to_fit();
+    }
+};
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_STABLECHUNKEDVECTOR_HPP
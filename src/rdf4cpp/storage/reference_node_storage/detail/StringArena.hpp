@@ -0,0 +1,405 @@
+#ifndef RDF4CPP_RDF_REFERENCENODESTORAGE_STRINGARENA_HPP
+#define RDF4CPP_RDF_REFERENCENODESTORAGE_STRINGARENA_HPP
+
+#include <rdf4cpp/storage/reference_node_storage/detail/ConstString.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rdf4cpp::storage::reference_node_storage::detail {
+
+/**
+ * An append-only arena for (small) strings.
+ * Strings are bump-allocated from large, chunk_size-aligned chunks, which avoids the per-allocation overhead
+ * and the fragmentation of allocating every string individually.
+ *
+ * Memory of deallocated strings is not reused individually, instead every chunk counts its live bytes
+ * and is released (or reused, if it is the chunk currently allocated from) as soon as it does not contain any live string anymore.
+ * Therefore erasing strings eventually gives memory back, without having to relocate the remaining strings.
+ *
+ * Strings larger than max_small_size are not stored in chunks, but allocated individually.
+ * The arena still keeps track of them, such that clear releases all memory of the arena, including them.
+ *
+ * Additionally, strings that are shared by many objects (e.g. IRI prefixes, see PrefixCompressedIRIBackend) can be interned in the arena.
+ * Interned strings are reference counted and released together with the arena.
+ *
+ * Not thread-safe.
+ */
+struct StringArena {
+    static constexpr size_t chunk_size = size_t{1} << 16;
+    static constexpr size_t max_small_size = chunk_size / 4;
+
+private:
+    struct ChunkHeader {
+        size_t live_bytes; //< number of bytes of live allocations in this chunk
+        size_t index;      //< index of this chunk in chunks_
+    };
+
+    static constexpr size_t chunk_data_begin = sizeof(ChunkHeader);
+
+    struct LargeHeader {
+        size_t size;  //< size of the allocation, excluding this header
+        size_t index; //< index of this allocation in large_
+    };
+
+    // keeps the allocations behind the header aligned
+    static constexpr size_t large_data_begin = (sizeof(LargeHeader) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+    std::vector<ChunkHeader *> chunks_; //< all chunks currently owned by this arena
+    std::vector<LargeHeader *> large_;  //< all allocations larger than max_small_size, they are not stored in chunks
+    ChunkHeader *current_ = nullptr;    //< chunk that is currently allocated from
+    size_t current_pos_ = chunk_size;   //< offset of the next allocation into current_
+    ChunkHeader *spare_ = nullptr;      //< a released chunk, kept to avoid allocation churn at chunk boundaries
+    size_t live_bytes_ = 0;             //< number of bytes of all live allocations, including the ones not stored in chunks
+
+    std::unordered_map<std::string_view, size_t> interned_; //< interned string (allocated from this arena) -> reference count, node based so keys are never relocated
+
+    [[nodiscard]] static ChunkHeader *chunk_of(void const *ptr) noexcept {
+        return reinterpret_cast<ChunkHeader *>(reinterpret_cast<uintptr_t>(ptr) & ~(chunk_size - 1));
+    }
+
+    [[nodiscard]] static std::byte *chunk_bytes(ChunkHeader *chunk) noexcept {
+        return reinterpret_cast<std::byte *>(chunk);
+    }
+
+    static void free_chunk(ChunkHeader *chunk) noexcept {
+        ::operator delete(chunk, chunk_size, std::align_val_t{chunk_size});
+    }
+
+    static void free_large(LargeHeader *large) noexcept {
+        ::operator delete(large, large_data_begin + large->size);
+    }
+
+    [[nodiscard]] void *allocate_large(size_t const size) {
+        large_.reserve(large_.size() + 1); // such that push_back cannot throw after allocating
+
+        auto *large = static_cast<LargeHeader *>(::operator new(large_data_begin + size));
+        *large = LargeHeader{.size = size, .index = large_.size()};
+        large_.push_back(large);
+
+        live_bytes_ += size;
+        return reinterpret_cast<std::byte *>(large) + large_data_begin;
+    }
+
+    void deallocate_large(void *ptr) noexcept {
+        auto *large = reinterpret_cast<LargeHeader *>(static_cast<std::byte *>(ptr) - large_data_begin);
+
+        // remove from large_ by swapping with the last element
+        auto *last = large_.back();
+        large_[large->index] = last;
+        last->index = large->index;
+        large_.pop_back();
+
+        live_bytes_ -= large->size;
+        free_large(large);
+    }
+
+    void new_chunk() {
+        ChunkHeader *chunk;
+        if (spare_ != nullptr) {
+            chunk = std::exchange(spare_, nullptr);
+        } else {
+            chunk = static_cast<ChunkHeader *>(::operator new(chunk_size, std::align_val_t{chunk_size}));
+        }
+
+        chunks_.push_back(chunk);
+        *chunk = ChunkHeader{.live_bytes = 0, .index = chunks_.size() - 1};
+
+        current_ = chunk;
+        current_pos_ = chunk_data_begin;
+    }
+
+    void release_chunk(ChunkHeader *chunk) noexcept {
+        assert(chunk->live_bytes == 0);
+
+        if (chunk == current_) {
+            // no need to release, just start over
+            current_pos_ = chunk_data_begin;
+            return;
+        }
+
+        // remove from chunks_ by swapping with the last element
+        auto *last = chunks_.back();
+        chunks_[chunk->index] = last;
+        last->index = chunk->index;
+        chunks_.pop_back();
+
+        if (spare_ == nullptr) {
+            spare_ = chunk;
+        } else {
+            free_chunk(chunk);
+        }
+    }
+
+public:
+    StringArena() noexcept = default;
+
+    // deleted because allocations point into the arena
+    StringArena(StringArena const &) = delete;
+    StringArena(StringArena &&) = delete;
+    StringArena &operator=(StringArena const &) = delete;
+    StringArena &operator=(StringArena &&) = delete;
+
+    ~StringArena() {
+        clear();
+    }
+
+    /**
+     * Allocates size bytes with the given alignment.
+     *
+     * @param size number of bytes
+     * @param alignment alignment of the allocation, must be a power of two and at most alignof(std::max_align_t)
+     * @return pointer to the allocated bytes
+     */
+    [[nodiscard]] void *allocate(size_t const size, size_t const alignment = 1) {
+        assert(alignment <= alignof(std::max_align_t));
+
+        if (size == 0) [[unlikely]] {
+            // must not point into a chunk, because it is not accounted for in live_bytes
+            alignas(std::max_align_t) static std::byte empty_allocation;
+            return &empty_allocation;
+        }
+
+        if (size > max_small_size) [[unlikely]] {
+            return allocate_large(size);
+        }
+
+        auto pos = (current_pos_ + alignment - 1) & ~(alignment - 1);
+        if (current_ == nullptr || pos + size > chunk_size) [[unlikely]] {
+            new_chunk();
+            pos = (current_pos_ + alignment - 1) & ~(alignment - 1);
+        }
+
+        current_pos_ = pos + size;
+        current_->live_bytes += size;
+        live_bytes_ += size;
+        return chunk_bytes(current_) + pos;
+    }
+
+    /**
+     * Deallocates a previous allocation of this arena.
+     * The memory is only given back once all allocations in the same chunk are deallocated.
+     *
+     * @param ptr pointer returned by allocate
+     * @param size size that was passed to allocate
+     */
+    void deallocate(void *ptr, size_t const size) noexcept {
+        if (size == 0) [[unlikely]] {
+            return;
+        }
+
+        if (size > max_small_size) [[unlikely]] {
+            deallocate_large(ptr);
+            return;
+        }
+
+        live_bytes_ -= size;
+
+        auto *chunk = chunk_of(ptr);
+        assert(chunk->live_bytes >= size);
+
+        chunk->live_bytes -= size;
+        if (chunk->live_bytes == 0) {
+            release_chunk(chunk);
+        }
+    }
+
+    /**
+     * Looks up the given string among the interned strings of this arena and interns a copy of it if it is not present yet.
+     * Every call must be paired with a call to release_interned, unless the arena is cleared before.
+     *
+     * @param str string to intern
+     * @return pointer to the interned string, stable until it is released
+     */
+    [[nodiscard]] std::string_view const *intern(std::string_view const str) {
+        if (auto it = interned_.find(str); it != interned_.end()) {
+            ++it->second;
+            return &it->first;
+        }
+
+        auto *data = static_cast<char *>(allocate(str.size()));
+        std::copy(str.begin(), str.end(), data);
+
+        try {
+            auto const it = interned_.emplace(std::string_view{data, str.size()}, 1).first;
+            return &it->first;
+        } catch (...) {
+            deallocate(data, str.size());
+            throw;
+        }
+    }
+
+    /**
+     * Releases a reference to an interned string, the string is deallocated once the last reference is released.
+     *
+     * @param interned pointer returned by intern
+     */
+    void release_interned(std::string_view const *interned) noexcept {
+        auto it = interned_.find(*interned);
+        assert(it != interned_.end() && &it->first == interned);
+
+        if (--it->second == 0) {
+            auto const str = it->first;
+            interned_.erase(it);
+            deallocate(const_cast<char *>(str.data()), str.size());
+        }
+    }
+
+    /**
+     * @return number of distinct interned strings of this arena
+     */
+    [[nodiscard]] size_t interned_count() const noexcept {
+        return interned_.size();
+    }
+
+    /**
+     * @return number of chunks owned by this arena
+     */
+    [[nodiscard]] size_t chunk_count() const noexcept {
+        return chunks_.size();
+    }
+
+    /**
+     * @return number of bytes of all live allocations of this arena
+     */
+    [[nodiscard]] size_t live_bytes() const noexcept {
+        return live_bytes_;
+    }
+
+    /**
+     * Frees the chunk that was kept around for reuse, if there is one.
+     */
+    void shrink_to_fit() noexcept {
+        if (spare_ != nullptr) {
+            free_chunk(std::exchange(spare_, nullptr));
+        }
+    }
+
+    /**
+     * Releases all memory of this arena at once, including the memory of allocations that were never deallocated.
+     * Objects that only own memory of this arena therefore do not need to be destroyed individually before (see ArenaAllocated).
+     * @precondition no allocation of this arena that is still live will be deallocated afterwards
+     */
+    void clear() noexcept {
+        interned_.clear();
+
+        for (auto *chunk : chunks_) {
+            free_chunk(chunk);
+        }
+        chunks_.clear();
+        shrink_to_fit();
+
+        for (auto *large : large_) {
+            free_large(large);
+        }
+        large_.clear();
+
+        current_ = nullptr;
+        current_pos_ = chunk_size;
+        live_bytes_ = 0;
+    }
+};
+
+/**
+ * An allocator that serves string payloads (i.e. allocations of char) from a StringArena.
+ * All other allocations, as well as all allocations of a default-constructed StringArenaAllocator, are forwarded to UpstreamAllocator.
+ * This allows to pass a single StringArenaAllocator to a container of objects that hold strings (see BiDirFlatMap),
+ * only the strings inside of the objects end up in the arena.
+ *
+ * @tparam T value type
+ * @tparam UpstreamAllocator stateless allocator template for everything that is not served from the arena (e.g. the hash tables of BiDirFlatMap)
+ */
+template<typename T, template<typename> typename UpstreamAllocator = std::allocator>
+struct StringArenaAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = StringArenaAllocator<U, UpstreamAllocator>;
+    };
+
+private:
+    template<typename, template<typename> typename>
+    friend struct StringArenaAllocator;
+
+    StringArena *arena_ = nullptr;
+
+    static constexpr bool serve_from_arena = std::is_same_v<T, char>;
+
+public:
+    constexpr StringArenaAllocator() noexcept = default;
+
+    explicit constexpr StringArenaAllocator(StringArena &arena) noexcept : arena_{&arena} {
+    }
+
+    /**
+     * Converts between value types and upstream allocators, the latter is required because
+     * the backends always store their strings with a StringArenaAllocator<char> (which never uses its upstream allocator while it has an arena).
+     */
+    template<typename U, template<typename> typename OtherUpstreamAllocator>
+    constexpr StringArenaAllocator(StringArenaAllocator<U, OtherUpstreamAllocator> const &other) noexcept : arena_{other.arena_} {
+    }
+
+    [[nodiscard]] StringArena *arena() const noexcept {
+        return arena_;
+    }
+
+    [[nodiscard]] T *allocate(size_t const n) {
+        if constexpr (serve_from_arena) {
+            if (arena_ != nullptr) {
+                return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+            }
+        }
+
+        return UpstreamAllocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T *ptr, size_t const n) noexcept {
+        if constexpr (serve_from_arena) {
+            if (arena_ != nullptr) {
+                arena_->deallocate(ptr, n * sizeof(T));
+                return;
+            }
+        }
+
+        UpstreamAllocator<T>{}.deallocate(ptr, n);
+    }
+
+    template<typename U>
+    bool operator==(StringArenaAllocator<U, UpstreamAllocator> const &other) const noexcept {
+        return arena_ == other.arena_;
+    }
+};
+
+/**
+ * Types that declare that all memory they own is allocated with the StringArenaAllocator they were constructed with,
+ * by defining `static constexpr bool arena_allocated = true;`.
+ * If such an object was constructed with an arena, destroying it only gives memory back to that arena. Containers of such objects
+ * can therefore skip destroying them one by one, if the arena is released as a whole afterwards (see StringArena::clear).
+ */
+template<typename T>
+concept ArenaAllocated = requires {
+    requires T::arena_allocated;
+};
+
+/**
+ * A ConstString that can allocate its payload from a StringArena
+ */
+using ArenaConstString = BasicConstString<char, std::char_traits<char>, StringArenaAllocator<char>>;
+
+} // namespace rdf4cpp::storage::reference_node_storage::detail
+
+#endif // RDF4CPP_RDF_REFERENCENODESTORAGE_STRINGARENA_HPP
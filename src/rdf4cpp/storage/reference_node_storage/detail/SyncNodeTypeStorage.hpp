@@ -1,22 +1,175 @@
 #ifndef RDF4CPP_SYNCNODETYPESTORAGE_HPP
 #define RDF4CPP_SYNCNODETYPESTORAGE_HPP
 
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/BloomFilter.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/NodeTypeCounters.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StableChunkedVector.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/UnsyncNodeTypeStorage.hpp>
+#include <atomic>
+#include <cstdint>
+#include <optional>
 #include <shared_mutex>
+#include <vector>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
+namespace detail {
+
+/**
+ * Container for the NodeID to Backend direction of the mapping of a SyncNodeTypeStorage
+ */
+template<bool LockFreeReads>
+struct SyncForwardContainer {
+    template<typename T, typename Allocator>
+    using type = std::vector<T, Allocator>;
+};
+
+template<>
+struct SyncForwardContainer<true> {
+    template<typename T, typename Allocator>
+    using type = StableChunkedVector<T, Allocator>;
+};
+
+}  // namespace detail
+
 /**
  * Storage for one of the Node Backend types. Includes a shared mutex to synchronize access and bidirectional mappings between the Backend type and identifier::NodeID.
+ * Every access to mapping must hold the mutex, use lookup_value to look up a Node Backend by its id.
  * @tparam BackendType_t one of BNodeBackend, IRIBackend, FallbackLiteralBackend, SpecializedLiteralBackend and VariableBackend.
+ * @tparam UpstreamAllocator stateless allocator template for the mapping (see UnsyncNodeTypeStorage)
+ * @tparam LockFreeReads if true, the NodeID to Backend direction of the mapping is a detail::StableChunkedVector that never relocates its entries
+ *      and lookup_value does not take the mutex. Because readers may then access any entry at any time, entries must never be erased.
  */
-template<typename BackendType_t>
-struct SyncNodeTypeStorage : UnsyncNodeTypeStorage<BackendType_t> {
-    using base_type = UnsyncNodeTypeStorage<BackendType_t>;
+template<typename BackendType_t, template<typename> typename UpstreamAllocator = std::allocator, bool LockFreeReads = false>
+struct SyncNodeTypeStorage : UnsyncNodeTypeStorage<BackendType_t, detail::SyncForwardContainer<LockFreeReads>::template type, UpstreamAllocator> {
+    using base_type = UnsyncNodeTypeStorage<BackendType_t, detail::SyncForwardContainer<LockFreeReads>::template type, UpstreamAllocator>;
     using backend_type = typename base_type::backend_type;
     using backend_view_type = typename base_type::backend_view_type;
+    using backend_id_type = typename base_type::backend_id_type;
+
+    static constexpr bool lock_free_reads = LockFreeReads;
 
     std::shared_mutex mutable mutex;
+
+    [[no_unique_address]] detail::NodeTypeCounters mutable counters; //< empty unless RDF4CPP_NODE_STORAGE_STATS is defined
+
+    /**
+     * Locks mutex shared, records the wait time in counters
+     */
+    [[nodiscard]] std::shared_lock<std::shared_mutex> lock_shared() const {
+        return counters.lock_shared(mutex);
+    }
+
+    /**
+     * Locks mutex uniquely, records the wait time in counters
+     */
+    [[nodiscard]] std::unique_lock<std::shared_mutex> lock_unique() const {
+        return counters.lock_unique(mutex);
+    }
+
+    /**
+     * Looks up the Node Backend with the given id, see detail::BiDirFlatMap::lookup_value.
+     * Takes a shared lock on mutex, unless lock_free_reads.
+     */
+    [[nodiscard]] std::optional<backend_view_type> lookup_value(backend_id_type const id) const noexcept {
+        if constexpr (lock_free_reads) {
+            return this->mapping.lookup_value(id);
+        } else {
+            auto lock = lock_shared();
+            return this->mapping.lookup_value(id);
+        }
+    }
+
+    /**
+     * @return statistics of this storage, see NodeTypeStats
+     */
+    [[nodiscard]] NodeTypeStats stats() const {
+        NodeTypeStats ret;
+
+        {
+            std::shared_lock lock{mutex};
+            ret.entries = this->mapping.entry_count();
+            ret.string_bytes = this->arena.live_bytes();
+            ret.load_factor = this->mapping.load_factor();
+            ret.id_capacity = this->mapping.size();
+            ret.vacant_ids = this->mapping.vacant_count();
+        }
+
+        counters.export_to(ret);
+        return ret;
+    }
+
+    /**
+     * If present, contains the hashes of all nodes that were ever inserted into mapping.
+     * Consulted before mapping to answer most lookups of absent nodes without taking the mutex.
+     * Erased nodes are not removed from the filter, they only increase its false-positive rate.
+     */
+    std::optional<detail::BloomFilter> negative_lookup_filter;
+
+    /**
+     * @param hash hash of a view, as calculated by backend_hasher
+     * @return false if no node with the given hash is present, true if one might be present
+     */
+    [[nodiscard]] bool may_contain(size_t const hash) const noexcept {
+        return !negative_lookup_filter.has_value() || negative_lookup_filter->may_contain(hash);
+    }
+
+    /**
+     * Same as mapping.insert_assume_not_present but also records the hash in negative_lookup_filter.
+     * Requires a unique lock on mutex.
+     */
+    [[nodiscard]] backend_id_type insert_assume_not_present(backend_view_type const &view, size_t const hash) {
+        if (negative_lookup_filter.has_value()) {
+            negative_lookup_filter->insert(hash);
+        }
+
+        return this->mapping.insert_assume_not_present(view, hash);
+    }
+
+    /**
+     * last_used[id - 1] is the epoch in which the node with id id was last used (see detail::EpochTracker).
+     * Only maintained while the owning storage tracks epochs, may be shorter than mapping.
+     * Never relocates, therefore it can be updated while only holding a shared lock on mutex (or no lock at all).
+     */
+    detail::StableChunkedVector<std::atomic<uint64_t>> mutable last_used;
+
+    /**
+     * Raises stamp to epoch, never lowers it.
+     * Concurrent callers may pass different epochs, therefore a plain check-then-store could overwrite a newer epoch with an older one.
+     */
+    static void raise_stamp(std::atomic<uint64_t> &stamp, uint64_t const epoch) noexcept {
+        auto cur = stamp.load(std::memory_order_relaxed);
+        while (cur < epoch && !stamp.compare_exchange_weak(cur, epoch, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Records that the node with the given id was used in the given epoch.
+     * Does not require a lock, does nothing if last_used is too short.
+     */
+    void mark_used(backend_id_type const id, uint64_t const epoch) const noexcept {
+        auto const ix = static_cast<size_t>(id.to_underlying()) - 1;
+        if (ix >= last_used.size()) {
+            return;
+        }
+
+        raise_stamp(last_used[ix], epoch);
+    }
+
+    /**
+     * Same as mark_used but grows last_used if it is too short.
+     * Requires a unique lock on mutex.
+     */
+    void mark_used_growing(backend_id_type const id, uint64_t const epoch) {
+        auto const ix = static_cast<size_t>(id.to_underlying()) - 1;
+        while (last_used.size() <= ix) {
+            last_used.emplace_back(epoch);
+        }
+
+        // readers might be marking it with mark_used at the same time
+        raise_stamp(last_used[ix], epoch);
+    }
 };
 
 }  // namespace rdf4cpp::storage::reference_node_storage
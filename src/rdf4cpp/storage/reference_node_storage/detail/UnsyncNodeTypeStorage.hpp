@@ -4,18 +4,24 @@
 #include <dice/hash.hpp>
 #include <dice/sparse-map/sparse_map.hpp>
 #include <rdf4cpp/storage/identifier/NodeID.hpp>
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageStats.hpp>
 #include <rdf4cpp/storage/reference_node_storage/detail/BiDirFlatMap.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/StringArena.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace rdf4cpp::storage::reference_node_storage {
 
 /**
  * Storage for one of the Node Backend types. Includes bidirectional mappings between the Backend type and identifier::NodeID,
  * the mappings are not synchronized and are not intended to be thread-safe.
+ * The string payloads of the stored backends are allocated from a per-storage detail::StringArena.
  * @tparam BackendType_t one of BNodeBackend, IRIBackend, FallbackLiteralBackend, SpecializedLiteralBackend and VariableBackend.
+ * @tparam ForwardContainer container for the NodeID to Backend direction of the mapping (see detail::BiDirFlatMap)
+ * @tparam UpstreamAllocator stateless allocator template for the mapping itself (see detail::StringArenaAllocator), e.g. detail::HugePageAllocator
  */
-template<typename BackendType_t>
+template<typename BackendType_t, template<typename, typename> typename ForwardContainer = std::vector, template<typename> typename UpstreamAllocator = std::allocator>
 struct UnsyncNodeTypeStorage {
     using backend_type = BackendType_t;
     using backend_view_type = typename backend_type::view_type;
@@ -91,7 +97,38 @@ public:
         }
     }
 
-    detail::BiDirFlatMap<backend_id_type, backend_type, backend_view_type, backend_hasher, backend_equal> mapping;
+    using allocator_type = detail::StringArenaAllocator<backend_type, UpstreamAllocator>;
+
+    detail::StringArena arena; //< must outlive mapping
+    detail::BiDirFlatMap<backend_id_type, backend_type, backend_view_type, backend_hasher, backend_equal, allocator_type, ForwardContainer> mapping{allocator_type{arena}};
+
+    /**
+     * @return statistics of this storage, see NodeTypeStats. The counters are always zero, because they are not collected without synchronization.
+     */
+    [[nodiscard]] NodeTypeStats stats() const noexcept {
+        return NodeTypeStats{.entries = mapping.entry_count(),
+                             .string_bytes = arena.live_bytes(),
+                             .load_factor = mapping.load_factor(),
+                             .id_capacity = mapping.size(),
+                             .vacant_ids = mapping.vacant_count()};
+    }
+
+    /**
+     * Requests the removal of unused capacity.
+     */
+    void shrink_to_fit() {
+        mapping.shrink_to_fit();
+        arena.shrink_to_fit();
+    }
+
+    /**
+     * Removes all entries and releases the memory of all strings at once.
+     * Backends that only own arena memory (see detail::ArenaAllocated) are not destroyed one by one, the arena is released as a whole.
+     */
+    void clear() noexcept {
+        mapping.clear();
+        arena.clear();
+    }
 };
 
 }  // namespace rdf4cpp::storage::reference_node_storage
@@ -0,0 +1,79 @@
+#ifndef RDF4CPP_HYPERLOGLOG_HPP
+#define RDF4CPP_HYPERLOGLOG_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace rdf4cpp::util {
+
+/**
+ * HyperLogLog sketch (Flajolet et al. 2007) that estimates the number of distinct values added to it in constant space.
+ * The values are added as (well mixed) 64-bit hashes.
+ *
+ * @tparam Precision log2 of the number of registers, the standard error of the estimate is about 1.04 / sqrt(2^Precision)
+ */
+template<size_t Precision>
+struct HyperLogLog {
+    static_assert(Precision >= 4 && Precision <= 16);
+
+    static constexpr size_t register_count = size_t{1} << Precision;
+
+private:
+    std::array<uint8_t, register_count> registers_{};
+
+public:
+    /**
+     * @param hash hash of the value to add
+     */
+    constexpr void add(uint64_t const hash) noexcept {
+        auto const ix = static_cast<size_t>(hash >> (64 - Precision));
+        auto const rest = hash << Precision;
+
+        // position of the first set bit of the remaining bits, starting at 1
+        auto const rank = static_cast<uint8_t>(rest == 0 ? 64 - Precision + 1 : std::countl_zero(rest) + 1);
+        registers_[ix] = std::max(registers_[ix], rank);
+    }
+
+    /**
+     * Adds all values of other to this sketch
+     */
+    constexpr void merge(HyperLogLog const &other) noexcept {
+        for (size_t ix = 0; ix < register_count; ++ix) {
+            registers_[ix] = std::max(registers_[ix], other.registers_[ix]);
+        }
+    }
+
+    /**
+     * @return the estimated number of distinct values that were added
+     */
+    [[nodiscard]] double estimate() const noexcept {
+        constexpr auto m = static_cast<double>(register_count);
+        constexpr double alpha = register_count == 16   ? 0.673
+                                 : register_count == 32 ? 0.697
+                                 : register_count == 64 ? 0.709
+                                                        : 0.7213 / (1.0 + 1.079 / m);
+
+        double sum = 0.0;
+        size_t zeros = 0;
+        for (auto const reg : registers_) {
+            sum += std::ldexp(1.0, -static_cast<int>(reg));
+            zeros += reg == 0;
+        }
+
+        auto const raw = alpha * m * m / sum;
+        if (raw <= 2.5 * m && zeros != 0) {
+            // few values, linear counting is more accurate
+            return m * std::log(m / static_cast<double>(zeros));
+        }
+
+        return raw;
+    }
+};
+
+}  // namespace rdf4cpp::util
+
+#endif  //RDF4CPP_HYPERLOGLOG_HPP
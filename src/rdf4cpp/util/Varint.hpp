@@ -0,0 +1,50 @@
+#ifndef RDF4CPP_VARINT_HPP
+#define RDF4CPP_VARINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rdf4cpp::util {
+
+/**
+ * Appends value to out as LEB128 varint, i.e. 7 bits per byte, least significant group first,
+ * with the highest bit of every byte except the last one set.
+ */
+inline void write_varint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * Reads a varint written by write_varint and advances p past it
+ */
+inline uint64_t read_varint(char const *&p) noexcept {
+    uint64_t value = 0;
+    for (size_t shift = 0;; shift += 7) {
+        auto const byte = static_cast<unsigned char>(*p++);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+/**
+ * Maps a signed difference to an unsigned integer with a small magnitude, such that it can be stored as short varint
+ * (0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...)
+ */
+constexpr uint64_t zigzag_encode(int64_t const value) noexcept {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t zigzag_decode(uint64_t const value) noexcept {
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+}  // namespace rdf4cpp::util
+
+#endif  //RDF4CPP_VARINT_HPP
@@ -0,0 +1,52 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+
+#include <format>
+#include <iostream>
+
+using namespace rdf4cpp;
+
+static constexpr size_t num_triples = 1 << 20;
+
+/**
+ * Scans all solutions of pattern
+ */
+template<typename G>
+void run_match(ankerl::nanobench::Bench &bench, char const *name, G const &g, query::TriplePattern const &pattern) {
+    bench.run(name, [&]() {
+        size_t count = 0;
+        for (auto const &solution : g.match(pattern)) {
+            ankerl::nanobench::doNotOptimizeAway(solution);
+            ++count;
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    });
+}
+
+int main() {
+    Graph g;
+    for (size_t ix = 0; ix < num_triples; ++ix) {
+        g.add(Statement{IRI{std::format("http://example.com/s{}", ix / 16)},
+                        IRI{std::format("http://example.com/p{}", ix % 16)},
+                        IRI{std::format("http://example.com/o{}", ix % 4096)}});
+    }
+
+    FrozenGraph const frozen{g};
+    std::cout << "FrozenGraph: " << frozen.memory_bytes() << " bytes for " << frozen.size() << " triples ("
+              << static_cast<double>(frozen.memory_bytes()) / static_cast<double>(frozen.size()) << " bytes per triple)\n";
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::TriplePattern const by_subject{IRI{"http://example.com/s1000"}, x, y};
+    query::TriplePattern const by_predicate{x, IRI{"http://example.com/p3"}, y};
+
+    ankerl::nanobench::Bench bench;
+    bench.title("match").unit("match").performanceCounters(true);
+
+    run_match(bench, "Graph, bound subject", g, by_subject);
+    run_match(bench, "FrozenGraph, bound subject", frozen, by_subject);
+    run_match(bench, "Graph, bound predicate", g, by_predicate);
+    run_match(bench, "FrozenGraph, bound predicate", frozen, by_predicate);
+}
@@ -0,0 +1,42 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+
+#include <format>
+
+using namespace rdf4cpp;
+
+static constexpr size_t num_triples = 1 << 20;
+
+static Statement make_statement(size_t const ix) {
+    return Statement{IRI{std::format("http://example.com/s{}", ix / 16)},
+                     IRI{std::format("http://example.com/p{}", ix % 16)},
+                     IRI{std::format("http://example.com/o{}", ix)}};
+}
+
+int main() {
+    ConcurrentGraph g;
+    for (size_t ix = 0; ix < num_triples; ++ix) {
+        g.add(make_statement(ix));
+    }
+
+    auto const update = make_statement(num_triples);
+
+    ankerl::nanobench::Bench bench;
+    bench.title("snapshot, then one update").unit("snapshot").minEpochIterations(10);
+
+    bench.run("copy-on-write snapshot", [&]() {
+        auto const snapshot = g.snapshot();
+        g.add(update);
+        g.remove(update);
+        ankerl::nanobench::doNotOptimizeAway(snapshot.size());
+    });
+
+    bench.run("full copy", [&]() {
+        auto const copy = g.snapshot().to_graph();
+        g.add(update);
+        g.remove(update);
+        ankerl::nanobench::doNotOptimizeAway(copy.size());
+    });
+}
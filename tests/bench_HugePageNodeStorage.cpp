@@ -0,0 +1,64 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage::reference_node_storage;
+
+static constexpr size_t num_iris = 1 << 22;
+static constexpr size_t num_probes = 1 << 20;
+
+/**
+ * Random hash probes (find_id) and id lookups (find_iri_backend) into a large dictionary,
+ * the working set is far larger than what the TLB covers with 4KiB pages.
+ */
+template<typename NodeStorage>
+void bench_probes(ankerl::nanobench::Bench &bench, char const *name, std::vector<std::string> const &iris, std::vector<size_t> const &probes) {
+    NodeStorage ns;
+
+    std::vector<storage::identifier::NodeBackendID> ids;
+    ids.reserve(iris.size());
+    for (auto const &iri : iris) {
+        ids.push_back(ns.find_or_make_id(storage::view::IRIBackendView{.identifier = iri}));
+    }
+
+    bench.run(std::format("{} find_id", name), [&]() {
+        for (auto const ix : probes) {
+            ankerl::nanobench::doNotOptimizeAway(ns.find_id(storage::view::IRIBackendView{.identifier = iris[ix]}));
+        }
+    });
+
+    bench.run(std::format("{} find_iri_backend", name), [&]() {
+        for (auto const ix : probes) {
+            ankerl::nanobench::doNotOptimizeAway(ns.find_iri_backend(ids[ix]).identifier.size());
+        }
+    });
+}
+
+int main() {
+    std::vector<std::string> iris;
+    iris.reserve(num_iris);
+    for (size_t ix = 0; ix < num_iris; ++ix) {
+        iris.push_back(std::format("http://example.com/{}", ix));
+    }
+
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<size_t> dist{0, num_iris - 1};
+    std::vector<size_t> probes(num_probes);
+    for (auto &ix : probes) {
+        ix = dist(rng);
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("random dictionary probes").unit("probe").batch(num_probes).performanceCounters(true);
+
+    bench_probes<SyncReferenceNodeStorage>(bench, "std::allocator", iris, probes);
+    bench_probes<HugePageSyncReferenceNodeStorage>(bench, "HugePageAllocator", iris, probes);
+}
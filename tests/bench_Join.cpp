@@ -0,0 +1,64 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+
+#include <format>
+#include <random>
+#include <vector>
+
+using namespace rdf4cpp;
+
+static constexpr size_t num_nodes = 2000;
+static constexpr size_t num_edges = 40000;
+
+int main() {
+    std::vector<IRI> nodes;
+    nodes.reserve(num_nodes);
+    for (size_t ix = 0; ix < num_nodes; ++ix) {
+        nodes.emplace_back(std::format("http://example.com/n{}", ix));
+    }
+
+    IRI const knows{"http://example.com/knows"};
+
+    // a few hubs with many edges make the intermediate results of pairwise joins large
+    std::mt19937_64 rng{42};
+    std::vector<double> weights(num_nodes);
+    for (size_t ix = 0; ix < num_nodes; ++ix) {
+        weights[ix] = 1.0 / static_cast<double>(ix + 1);
+    }
+    std::discrete_distribution<size_t> skewed{weights.begin(), weights.end()};
+
+    Graph g;
+    for (size_t ix = 0; ix < num_edges; ++ix) {
+        g.add(Statement{nodes[skewed(rng)], knows, nodes[skewed(rng)]});
+    }
+    g.build_indexes();
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+
+    ankerl::nanobench::Bench bench;
+    bench.title("triangle query").unit("query").performanceCounters(true);
+
+    bench.run("nested loops over match", [&]() {
+        size_t count = 0;
+        for (auto const &xy : g.match({x, knows, y})) {
+            for (auto const &yz : g.match({xy[1], knows, z})) {
+                count += g.contains(Statement{yz[0], knows, xy[0]});
+            }
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    });
+
+    std::vector<query::TriplePattern> const triangle{{x, knows, y}, {y, knows, z}, {z, knows, x}};
+    bench.run("join", [&]() {
+        size_t count = 0;
+        for (auto const &solution : g.join(triangle)) {
+            ankerl::nanobench::doNotOptimizeAway(solution);
+            ++count;
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    });
+}
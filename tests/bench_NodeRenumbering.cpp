@@ -0,0 +1,77 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <dice/sparse-map/sparse_map.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::UnsyncReferenceNodeStorage;
+
+static constexpr size_t num_iris = 1 << 20;
+static constexpr size_t trace_size = 1 << 22;
+
+/**
+ * Lookups of find_iri_backend with a skewed (Zipf-like) access pattern,
+ * where the hot IRIs are scattered over the whole id space before renumbering.
+ */
+void run_trace(ankerl::nanobench::Bench &bench, char const *name, UnsyncReferenceNodeStorage &ns, std::vector<identifier::NodeBackendID> const &trace) {
+    bench.run(name, [&]() {
+        for (auto const id : trace) {
+            ankerl::nanobench::doNotOptimizeAway(ns.find_iri_backend(id).identifier.size());
+        }
+    });
+}
+
+int main() {
+    UnsyncReferenceNodeStorage ns;
+
+    std::vector<identifier::NodeBackendID> ids;
+    ids.reserve(num_iris);
+    for (size_t ix = 0; ix < num_iris; ++ix) {
+        ids.push_back(ns.find_or_make_id(view::IRIBackendView{.identifier = std::format("http://example.com/ns{}/{}", ix % 64, ix)}));
+    }
+
+    // rank r is accessed with probability proportional to 1/r, ranks are assigned to random ids
+    std::mt19937_64 rng{42};
+    std::shuffle(ids.begin(), ids.end(), rng);
+
+    std::vector<double> weights(num_iris);
+    for (size_t r = 0; r < num_iris; ++r) {
+        weights[r] = 1.0 / static_cast<double>(r + 1);
+    }
+    std::discrete_distribution<size_t> zipf{weights.begin(), weights.end()};
+
+    std::vector<identifier::NodeBackendID> trace;
+    trace.reserve(trace_size);
+    dice::sparse_map::sparse_map<identifier::NodeBackendID, size_t> frequencies;
+    for (size_t ix = 0; ix < trace_size; ++ix) {
+        auto const id = ids[zipf(rng)];
+        trace.push_back(id);
+        ++frequencies[id];
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("find_iri_backend with skewed access").unit("lookup").batch(trace.size()).performanceCounters(true);
+
+    run_trace(bench, "original ids", ns, trace);
+
+    auto const remapping = ns.renumber([&frequencies](identifier::NodeBackendID const id) noexcept -> size_t {
+        auto const it = frequencies.find(id);
+        return it == frequencies.end() ? 0 : it->second;
+    });
+
+    for (auto &id : trace) {
+        id = remapping[id];
+    }
+
+    run_trace(bench, "renumbered by frequency", ns, trace);
+}
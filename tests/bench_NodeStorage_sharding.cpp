@@ -0,0 +1,63 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/ShardedReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+
+#include <format>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage::reference_node_storage;
+
+static constexpr size_t max_threads = 64;
+static constexpr size_t iris_per_thread = 1 << 14;
+
+template<typename NodeStorage>
+void intern_concurrently(NodeStorage &ns, std::vector<std::vector<std::string>> const &iris, size_t const n_threads) {
+    std::vector<std::jthread> threads;
+    threads.reserve(n_threads);
+
+    for (size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&ns, &thread_iris = iris[t]]() {
+            for (auto const &iri : thread_iris) {
+                ankerl::nanobench::doNotOptimizeAway(ns.find_or_make_id(storage::view::IRIBackendView{.identifier = iri}));
+            }
+        });
+    }
+}
+
+int main() {
+    // every thread interns its own iris, half of them are shared between all threads
+    std::vector<std::vector<std::string>> iris(max_threads);
+    for (size_t t = 0; t < max_threads; ++t) {
+        iris[t].reserve(iris_per_thread);
+        for (size_t ix = 0; ix < iris_per_thread; ++ix) {
+            if (ix % 2 == 0) {
+                iris[t].push_back(std::format("http://example.com/shared/{}", ix));
+            } else {
+                iris[t].push_back(std::format("http://example.com/thread{}/{}", t, ix));
+            }
+        }
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("concurrent IRI interning").unit("IRI");
+
+    for (size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+        bench.batch(n_threads * iris_per_thread);
+
+        bench.run(std::format("SyncReferenceNodeStorage {} threads", n_threads), [&iris, n_threads]() {
+            SyncReferenceNodeStorage ns;
+            intern_concurrently(ns, iris, n_threads);
+        });
+
+        bench.run(std::format("ShardedReferenceNodeStorage {} threads", n_threads), [&iris, n_threads]() {
+            ShardedReferenceNodeStorage ns;
+            intern_concurrently(ns, iris, n_threads);
+        });
+    }
+}
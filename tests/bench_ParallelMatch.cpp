@@ -0,0 +1,44 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+
+#include <format>
+#include <thread>
+
+using namespace rdf4cpp;
+
+static constexpr size_t num_graphs = 4096;
+static constexpr size_t triples_per_graph = 256;
+
+int main() {
+    Dataset ds;
+    for (size_t gx = 0; gx < num_graphs; ++gx) {
+        auto &g = ds.graph(IRI{std::format("http://example.com/g{}", gx)});
+        for (size_t ix = 0; ix < triples_per_graph; ++ix) {
+            g.add(Statement{IRI{std::format("http://example.com/s{}", ix % 64)},
+                            IRI{std::format("http://example.com/p{}", ix % 8)},
+                            IRI{std::format("http://example.com/o{}", gx * triples_per_graph + ix)}});
+        }
+    }
+
+    query::QuadPattern const pattern{query::Variable{"g"}, query::Variable{"x"}, IRI{"http://example.com/p3"}, query::Variable{"z"}};
+
+    ankerl::nanobench::Bench bench;
+    bench.title("variable graph pattern over many graphs").unit("query").performanceCounters(true);
+
+    bench.run("match", [&]() {
+        size_t count = 0;
+        for (auto const &solution : ds.match(pattern)) {
+            ankerl::nanobench::doNotOptimizeAway(solution);
+            ++count;
+        }
+        ankerl::nanobench::doNotOptimizeAway(count);
+    });
+
+    for (size_t threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2) {
+        bench.run(std::format("parallel_match, {} threads", threads), [&]() {
+            ankerl::nanobench::doNotOptimizeAway(ds.parallel_match(pattern, threads).size());
+        });
+    }
+}
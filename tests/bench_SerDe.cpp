@@ -39,6 +39,42 @@ void deserialize(std::filesystem::path const &in_path, Dataset &ds, storage::Dyn
     fclose(in_file);
 }
 
+/**
+ * Like deserialize, but adds the quads in batches with Dataset::bulk_add
+ */
+void deserialize_bulk(std::filesystem::path const &in_path, Dataset &ds, storage::DynNodeStoragePtr node_storage) {
+    static constexpr size_t batch_size = 1 << 16;
+
+    FILE *in_file = parser::fopen_fastseq(in_path.c_str(), "r");
+    if (in_file == nullptr) {
+        throw std::system_error{std::error_code{errno, std::system_category()}};
+    }
+    setbuf(in_file, nullptr);
+
+    parser::IStreamQuadIterator::state_type state{.node_storage = node_storage};
+    parser::IStreamQuadIterator qit{in_file,
+                                    reinterpret_cast<parser::ReadFunc>(&fread),
+                                    reinterpret_cast<parser::ErrorFunc>(&ferror),
+                                    parser::ParsingFlags::none(),
+                                    &state};
+
+    std::vector<Quad> batch;
+    batch.reserve(batch_size);
+
+    for (; qit != std::default_sentinel; ++qit) {
+        if (qit->has_value()) {
+            batch.push_back(**qit);
+            if (batch.size() == batch_size) {
+                ds.bulk_add(batch);
+                batch.clear();
+            }
+        }
+    }
+    ds.bulk_add(batch);
+
+    fclose(in_file);
+}
+
 void serialize(std::filesystem::path const &out_path, Dataset const &ds) {
     FILE *out_file = parser::fopen_fastseq(out_path.c_str(), "w");
     if (out_file == nullptr) {
@@ -73,6 +109,11 @@ int main() {
                 Dataset ds{ns};
                 deserialize(in_path, ds, ns);
             })
+            .run("deserialization with bulk_add", [&in_path]() {
+                auto ns = storage::reference_node_storage::UnsyncReferenceNodeStorage{};
+                Dataset ds{ns};
+                deserialize_bulk(in_path, ds, ns);
+            })
             .run("serialization", [&out_path, &ser_ds]() {
                 serialize(out_path, ser_ds);
             });
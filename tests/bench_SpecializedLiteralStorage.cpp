@@ -0,0 +1,55 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include <nanobench.h>
+
+#include <rdf4cpp.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace rdf4cpp;
+
+static constexpr size_t n_literals = 1 << 12;
+
+int main() {
+    // fractional seconds cannot be inlined, these literals are stored in the node storage
+    std::vector<std::string> lexical_forms;
+    std::vector<Literal> literals;
+    lexical_forms.reserve(n_literals);
+    literals.reserve(n_literals);
+
+    for (size_t ix = 0; ix < n_literals; ++ix) {
+        auto const ms = std::chrono::milliseconds{static_cast<int64_t>(ix * 7919 % (24 * 60 * 60 * 1000))} + std::chrono::milliseconds{1};
+        auto lit = Literal::make_typed_from_value<datatypes::xsd::Time>(std::make_pair(ms, OptionalTimezone{}));
+        lexical_forms.emplace_back(lit.lexical_form());
+        literals.push_back(lit);
+    }
+
+    ankerl::nanobench::Bench bench;
+    bench.title("uninlineable xsd:time").unit("literal").batch(n_literals);
+
+    // what every value() call had to do while xsd:time was stored by its lexical form
+    bench.run("parse lexical form", [&lexical_forms]() {
+        for (auto const &lex : lexical_forms) {
+            ankerl::nanobench::doNotOptimizeAway(datatypes::xsd::Time::from_string(lex));
+        }
+    });
+
+    bench.run("value", [&literals]() {
+        for (auto const &lit : literals) {
+            ankerl::nanobench::doNotOptimizeAway(lit.value<datatypes::xsd::Time>());
+        }
+    });
+
+    bench.run("compare", [&literals]() {
+        for (size_t ix = 1; ix < literals.size(); ++ix) {
+            ankerl::nanobench::doNotOptimizeAway(literals[ix - 1].compare(literals[ix]));
+        }
+    });
+
+    bench.run("subtract", [&literals]() {
+        for (size_t ix = 1; ix < literals.size(); ++ix) {
+            ankerl::nanobench::doNotOptimizeAway(literals[ix - 1] - literals[ix]);
+        }
+    });
+}
@@ -2,6 +2,14 @@
 #include <doctest/doctest.h>
 
 #include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace rdf4cpp;
 
@@ -46,3 +54,757 @@ TEST_CASE("base functions") {
         CHECK(i == 2);
     }
 }
+
+/**
+ * @return the solutions, each rendered as a string, sorted
+ */
+template<typename Solutions>
+static std::vector<std::string> solution_strings(Solutions const &solutions) {
+    std::vector<std::string> ret;
+    for (auto const &solution : solutions) {
+        std::string s;
+        for (auto const &[variable, node] : solution) {
+            s += std::string{variable} + "=" + std::string{node} + " ";
+        }
+        ret.push_back(std::move(s));
+    }
+
+    std::ranges::sort(ret);
+    return ret;
+}
+
+/**
+ * @return the solutions of pattern in g, each rendered as a string, sorted
+ */
+template<typename G>
+static std::vector<std::string> match_strings(G const &g, query::TriplePattern const &pattern) {
+    return solution_strings(g.match(pattern));
+}
+
+TEST_CASE("graph indexes") {
+    auto const s = [](size_t ix) { return IRI{"http://example.com/s" + std::to_string(ix)}; };
+    auto const p = [](size_t ix) { return IRI{"http://example.com/p" + std::to_string(ix)}; };
+    auto const o = [](size_t ix) -> Node {
+        if (ix % 3 == 0) {
+            return Literal::make_typed_from_value<datatypes::xsd::Int>(static_cast<int32_t>(ix));
+        }
+        return IRI{"http://example.com/o" + std::to_string(ix)};
+    };
+
+    Graph scan;
+    Graph indexed;
+
+    for (size_t ix = 0; ix < 200; ++ix) {
+        Statement const stmt{s(ix % 10), p(ix % 4), o(ix % 17)};
+        scan.add(stmt);
+        indexed.add(stmt);
+
+        if (ix == 100) {
+            // half of the triples are indexed when building, the rest is indexed by add
+            indexed.build_indexes();
+        }
+    }
+
+    indexed.add(Statement{s(1), p(1), o(1)}); // already present
+    CHECK(indexed.has_indexes());
+    CHECK(!scan.has_indexes());
+    CHECK(indexed.size() == scan.size());
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+
+    std::vector<query::TriplePattern> patterns{
+            {x, y, z},
+            {s(3), y, z},
+            {x, p(2), z},
+            {x, y, o(5)},
+            {s(3), p(3), z},
+            {x, p(1), o(9)},
+            {s(2), y, o(12)},
+            {s(3), p(3), o(3)},
+            {s(3), p(3), o(5)},                        // not in the graph
+            {IRI{"http://example.com/absent"}, y, z}, // not in the node storage
+    };
+
+    for (auto const &pattern : patterns) {
+        CAPTURE(pattern);
+        CHECK(match_strings(indexed, pattern) == match_strings(scan, pattern));
+    }
+
+    CHECK(match_strings(indexed, {s(3), p(3), o(3)}).size() == 1);
+    CHECK(match_strings(indexed, {x, p(2), z}).size() == 50);
+
+    storage::reference_node_storage::UnsyncReferenceNodeStorage dst;
+    auto const copy = indexed.to_node_storage(dst);
+    CHECK(copy.has_indexes());
+    CHECK(match_strings(copy, {s(2), y, o(12)}) == match_strings(scan, {s(2), y, o(12)}));
+}
+
+TEST_CASE("frozen graph") {
+    auto const s = [](size_t ix) { return IRI{"http://example.com/s" + std::to_string(ix)}; };
+    auto const p = [](size_t ix) { return IRI{"http://example.com/p" + std::to_string(ix)}; };
+    auto const o = [](size_t ix) -> Node {
+        if (ix % 3 == 0) {
+            return Literal::make_typed_from_value<datatypes::xsd::Int>(static_cast<int32_t>(ix));
+        }
+        return IRI{"http://example.com/o" + std::to_string(ix)};
+    };
+
+    CHECK(FrozenGraph{}.size() == 0);
+    CHECK(FrozenGraph{Graph{}}.begin() == FrozenGraph::sentinel{});
+
+    Graph g;
+    // enough triples for several blocks in every permutation
+    for (size_t ix = 0; ix < 2000; ++ix) {
+        g.add(Statement{s(ix % 50), p(ix % 7), o(ix % 113)});
+    }
+
+    FrozenGraph const frozen{g};
+    CHECK(frozen.size() == g.size());
+
+    size_t count = 0;
+    for (auto const &stmt : frozen) {
+        CHECK(g.contains(stmt));
+        ++count;
+    }
+    CHECK(count == g.size());
+
+    for (auto const &stmt : g) {
+        CHECK(frozen.contains(stmt));
+    }
+    CHECK(!frozen.contains(Statement{s(1), p(1), o(2)}));
+    CHECK(!frozen.contains(Statement{IRI{"http://example.com/absent"}, p(1), o(1)}));
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+
+    std::vector<query::TriplePattern> patterns{
+            {x, y, z},
+            {s(3), y, z},
+            {x, p(2), z},
+            {x, y, o(5)},
+            {s(3), p(3), z},
+            {x, p(1), o(9)},
+            {s(2), y, o(2)},
+            {s(49), p(0), o(112)},
+            {s(3), p(3), o(5)},                        // not in the graph
+            {IRI{"http://example.com/absent"}, y, z}, // not in the node storage
+    };
+
+    for (auto const &pattern : patterns) {
+        CAPTURE(pattern);
+        CHECK(match_strings(frozen, pattern) == match_strings(g, pattern));
+    }
+
+    // three permutations of 3 ids each take 72 bytes per triple in uncompressed form
+    CHECK(frozen.memory_bytes() < 24 * frozen.size());
+
+    auto const thawed = frozen.thaw();
+    CHECK(thawed.size() == g.size());
+    for (auto const &stmt : g) {
+        CHECK(thawed.contains(stmt));
+    }
+}
+
+TEST_CASE("join") {
+    auto const n = [](size_t ix) { return IRI{"http://example.com/n" + std::to_string(ix)}; };
+    IRI const knows{"http://example.com/knows"};
+    IRI const likes{"http://example.com/likes"};
+
+    Graph g;
+    for (size_t ix = 0; ix < 300; ++ix) {
+        g.add(Statement{n(ix % 23), knows, n((ix * 7) % 19)});
+        g.add(Statement{n(ix % 11), likes, n((ix * 5) % 13)});
+    }
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+
+    // triangles, computed by nested loops over match
+    std::vector<std::string> triangles;
+    for (auto const &xy : g.match({x, knows, y})) {
+        for (auto const &yz : g.match({xy[1], knows, z})) {
+            if (g.contains(Statement{yz[0], knows, xy[0]})) {
+                triangles.push_back("?x=" + std::string{xy[0]} + " ?y=" + std::string{xy[1]} + " ?z=" + std::string{yz[0]} + " ");
+            }
+        }
+    }
+    std::ranges::sort(triangles);
+    REQUIRE(!triangles.empty());
+
+    std::vector<query::TriplePattern> const triangle{{x, knows, y}, {y, knows, z}, {z, knows, x}};
+    CHECK(solution_strings(g.join(triangle)) == triangles);
+
+    g.build_indexes();
+    auto const solutions = g.join(triangle);
+    CHECK(solution_strings(solutions) == triangles);
+    CHECK(solution_strings(solutions) == triangles); // begin starts over
+
+    // constants, a repeated variable and another predicate
+    std::vector<query::TriplePattern> const mixed{{x, knows, x}, {x, likes, y}, {n(3), likes, y}};
+    std::vector<std::string> expected;
+    for (auto const &edge : g.match({x, knows, y})) {
+        if (edge[0] != edge[1]) {
+            continue;
+        }
+
+        for (auto const &liked : g.match({edge[0], likes, y})) {
+            if (g.contains(Statement{n(3), likes, liked[0]})) {
+                expected.push_back("?x=" + std::string{edge[0]} + " ?y=" + std::string{liked[0]} + " ");
+            }
+        }
+    }
+    std::ranges::sort(expected);
+    REQUIRE(!expected.empty());
+    CHECK(solution_strings(g.join(mixed)) == expected);
+
+    CHECK(solution_strings(g.join(std::vector<query::TriplePattern>{{x, knows, n(0)}, {IRI{"http://example.com/nobody"}, knows, x}})).empty());
+    CHECK(solution_strings(g.join(std::vector<query::TriplePattern>{{n(0), knows, n(0)}})).size() == 1); // no variables, one empty solution
+
+    Dataset ds;
+    ds.graph(n(100)) = g;
+    ds.graph().add(Statement{n(1), knows, n(2)});
+    ds.graph().add(Statement{n(2), knows, n(1)});
+
+    query::Variable const graph_name{"g"};
+    std::vector<query::QuadPattern> const mutual{{graph_name, x, knows, y}, {graph_name, y, knows, x}};
+
+    std::vector<std::string> expected_mutual;
+    for (auto const &q : ds.match({graph_name, x, knows, y})) {
+        if (ds.contains(Quad{q[0], q[2], knows, q[1]})) {
+            expected_mutual.push_back("?g=" + std::string{q[0]} + " ?x=" + std::string{q[1]} + " ?y=" + std::string{q[2]} + " ");
+        }
+    }
+    std::ranges::sort(expected_mutual);
+    CHECK(solution_strings(ds.join(mutual)) == expected_mutual);
+
+    std::vector<query::QuadPattern> const in_default{{IRI::default_graph(), x, knows, y}, {IRI::default_graph(), y, knows, x}};
+    CHECK(solution_strings(ds.join(in_default)).size() == 2);
+}
+
+TEST_CASE("estimate") {
+    auto const s = [](size_t ix) { return IRI{"http://example.com/s" + std::to_string(ix)}; };
+    auto const o = [](size_t ix) { return IRI{"http://example.com/o" + std::to_string(ix)}; };
+    IRI const p1{"http://example.com/p1"};
+    IRI const p2{"http://example.com/p2"};
+
+    Graph g;
+    CHECK(g.estimate({query::Variable{"x"}, query::Variable{"y"}, query::Variable{"z"}}) == 0.0);
+
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        g.add(Statement{s(ix % 100), p1, o(ix / 100)});
+    }
+    for (size_t ix = 0; ix < 10; ++ix) {
+        g.add(Statement{s(ix), p2, s(ix + 1)});
+    }
+    g.add(Statement{s(0), p1, o(0)}); // already present
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+
+    CHECK(g.statistics().size() == g.size());
+    CHECK(g.statistics().predicate_count() == 2);
+    CHECK(g.estimate({x, y, query::Variable{"z"}}) == 1010.0);
+    CHECK(g.estimate({x, p1, y}) == 1000.0);
+    CHECK(g.estimate({x, p2, y}) == 10.0);
+    CHECK(g.estimate({s(7), p1, y}) == doctest::Approx(10.0).epsilon(0.2));
+    CHECK(g.estimate({x, p1, o(3)}) == doctest::Approx(100.0).epsilon(0.2));
+    CHECK(g.estimate({s(7), p1, o(3)}) == doctest::Approx(1.0).epsilon(0.5));
+    CHECK(g.estimate({x, IRI{"http://example.com/p3"}, y}) == 0.0);
+
+    storage::reference_node_storage::UnsyncReferenceNodeStorage dst;
+    auto const copy = g.to_node_storage(dst);
+    CHECK(copy.statistics().size() == g.size());
+    CHECK(copy.statistics().predicate_count() == 2);
+
+    Dataset ds;
+    ds.graph(IRI{"http://example.com/g1"}) = g;
+    ds.graph(IRI{"http://example.com/g2"}).add(Statement{s(1), p2, s(2)});
+
+    query::Variable const graph_name{"g"};
+    CHECK(ds.estimate({graph_name, x, p2, y}) == 11.0);
+    CHECK(ds.estimate({IRI{"http://example.com/g2"}, x, p2, y}) == 1.0);
+    CHECK(ds.estimate({IRI{"http://example.com/g3"}, x, p2, y}) == 0.0);
+}
+
+TEST_CASE("parallel match") {
+    auto const s = [](size_t ix) { return IRI{"http://example.com/s" + std::to_string(ix)}; };
+    auto const p = [](size_t ix) { return IRI{"http://example.com/p" + std::to_string(ix)}; };
+    auto const o = [](size_t ix) { return IRI{"http://example.com/o" + std::to_string(ix)}; };
+    auto const graph_name = [](size_t ix) { return IRI{"http://example.com/g" + std::to_string(ix)}; };
+
+    Dataset ds;
+    for (size_t gx = 0; gx < 40; ++gx) {
+        for (size_t ix = 0; ix < 20; ++ix) {
+            ds.add(Quad{graph_name(gx), s(ix % 7), p(ix % 3), o(gx + ix)});
+        }
+    }
+
+    // large enough to be split into several partitions
+    auto &big = ds.graph(graph_name(100));
+    for (size_t ix = 0; ix < 3 * Dataset::parallel_match_partition_size; ++ix) {
+        big.add(Statement{s(ix % 101), p(ix % 5), o(ix)});
+    }
+
+    ds.graph(graph_name(3)).build_indexes();
+
+    query::Variable const g{"g"};
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+
+    std::vector<query::QuadPattern> const patterns{
+            {g, x, y, z},
+            {g, x, p(1), z},
+            {g, s(1), y, z},
+            {graph_name(100), x, y, o(3)},
+            {graph_name(3), s(2), y, z},
+            {g, x, p(7), z},                             // not in the dataset
+            {g, IRI{"http://example.com/nobody"}, y, z}, // not in the dataset either
+    };
+
+    for (auto const &pattern : patterns) {
+        CAPTURE(pattern);
+        auto const expected = solution_strings(ds.match(pattern));
+
+        for (size_t const threads : {1, 4}) {
+            CHECK(solution_strings(ds.parallel_match(pattern, threads)) == expected);
+        }
+    }
+}
+
+TEST_CASE("bulk_add") {
+    auto const iri = [](std::string_view kind, size_t ix) { return IRI{"http://example.com/" + std::string{kind} + std::to_string(ix)}; };
+
+    std::vector<Quad> quads;
+    for (size_t ix = 0; ix < 5000; ++ix) {
+        // runs of the same graph, with duplicates
+        auto const g = (ix / 50) % 21;
+        auto const s = iri("s", ix % 300);
+        auto const p = iri("p", ix % 4);
+        auto const o = iri("o", ix % 1000);
+        quads.push_back(g == 20 ? Quad{s, p, o} : Quad{iri("g", g), s, p, o});
+    }
+
+    Dataset expected;
+    for (auto const &quad : quads) {
+        expected.add(quad);
+    }
+
+    for (size_t const threads : {1, 4}) {
+        CAPTURE(threads);
+
+        Dataset ds;
+        ds.add(quads.front());
+        ds.bulk_add(std::span{quads}.subspan(0, 2500), threads);
+        ds.bulk_add(std::span{quads}.subspan(2500), threads);
+
+        CHECK(ds.size() == expected.size());
+        for (auto const &quad : expected) {
+            CHECK(ds.contains(quad));
+        }
+        CHECK(ds.size(IRI::default_graph()) == expected.size(IRI::default_graph()));
+        CHECK(ds.find_graph()->statistics().size() == ds.find_graph()->size());
+    }
+
+    // into another node storage
+    storage::reference_node_storage::UnsyncReferenceNodeStorage ns;
+    Graph g{ns};
+    std::vector<Statement> statements;
+    for (auto const &quad : quads) {
+        statements.push_back(quad.without_graph());
+    }
+    g.bulk_add(statements);
+
+    size_t count = 0;
+    for (auto const &stmt : *expected.find_graph(iri("g", 1))) {
+        CHECK(g.contains(stmt));
+        ++count;
+    }
+    CHECK(count > 0);
+    CHECK(g.size() <= statements.size());
+}
+
+TEST_CASE("concurrent graph") {
+    auto const iri = [](std::string_view kind, size_t ix) { return IRI{"http://example.com/" + std::string{kind} + std::to_string(ix)}; };
+    auto const p = iri("p", 0);
+
+    constexpr size_t writer_count = 4;
+    constexpr size_t per_writer = 2000;
+
+    SUBCASE("graph") {
+        ConcurrentGraph g{storage::default_node_storage, 8};
+
+        {
+            std::vector<std::jthread> writers;
+            for (size_t w = 0; w < writer_count; ++w) {
+                writers.emplace_back([&, w]() {
+                    for (size_t ix = 0; ix < per_writer; ++ix) {
+                        CHECK(g.add(Statement{iri("s", w), p, iri("o", ix)}));
+                    }
+                });
+            }
+
+            // every writer adds its objects in order, so a consistent snapshot contains a prefix of them for each writer
+            for (size_t round = 0; round < 20; ++round) {
+                auto const snapshot = g.snapshot();
+                for (size_t w = 0; w < writer_count; ++w) {
+                    size_t prefix = 0;
+                    while (prefix < per_writer && snapshot.contains(Statement{iri("s", w), p, iri("o", prefix)})) {
+                        ++prefix;
+                    }
+
+                    size_t count = 0;
+                    for (auto const &solution : snapshot.match(query::TriplePattern{iri("s", w), p, query::Variable{"o"}})) {
+                        (void) solution;
+                        ++count;
+                    }
+                    CHECK(count == prefix);
+                }
+            }
+        }
+
+        CHECK(g.size() == writer_count * per_writer);
+        CHECK(!g.add(Statement{iri("s", 0), p, iri("o", 0)}));
+
+        {
+            std::vector<std::jthread> removers;
+            for (size_t w = 0; w < writer_count; ++w) {
+                removers.emplace_back([&, w]() {
+                    for (size_t ix = 0; ix < per_writer; ix += 2) {
+                        CHECK(g.remove(Statement{iri("s", w), p, iri("o", ix)}));
+                    }
+                });
+            }
+        }
+
+        CHECK(g.size() == writer_count * per_writer / 2);
+        CHECK(!g.remove(Statement{iri("s", 0), p, iri("o", 0)}));
+        CHECK(!g.contains(Statement{iri("s", 1), p, iri("o", 2)}));
+        CHECK(g.contains(Statement{iri("s", 1), p, iri("o", 3)}));
+        CHECK(!g.contains(Statement{iri("nobody", 0), p, iri("o", 3)}));
+
+        auto const solutions = g.match(query::TriplePattern{iri("s", 2), query::Variable{"p"}, query::Variable{"o"}});
+        CHECK(solutions.size() == per_writer / 2);
+        for (auto const &solution : solutions) {
+            CHECK(solution[query::Variable{"p"}] == p);
+        }
+
+        auto const snapshot = g.snapshot();
+        CHECK(snapshot.size() == g.size());
+        CHECK(ConcurrentGraph{snapshot.to_graph()}.size() == g.size());
+    }
+
+    SUBCASE("dataset") {
+        ConcurrentDataset ds{storage::default_node_storage, 4};
+
+        {
+            std::vector<std::jthread> writers;
+            for (size_t w = 0; w < writer_count; ++w) {
+                writers.emplace_back([&, w]() {
+                    for (size_t ix = 0; ix < per_writer; ++ix) {
+                        // the same statements in two graphs, the default one and the one of the writer
+                        CHECK(ds.add(Quad{iri("s", ix), p, iri("o", w)}));
+                        CHECK(ds.add(Quad{iri("g", w), iri("s", ix), p, iri("o", w)}));
+                    }
+                });
+            }
+
+            for (size_t round = 0; round < 20; ++round) {
+                auto const snapshot = ds.snapshot();
+                for (size_t w = 0; w < writer_count; ++w) {
+                    // every statement is added to the default graph first, so it is ahead of the graph of the writer by at most one statement
+                    size_t in_default = 0;
+                    if (auto const *default_graph = snapshot.find_graph(); default_graph != nullptr) {
+                        for (auto const &solution : default_graph->match(query::TriplePattern{query::Variable{"s"}, p, iri("o", w)})) {
+                            (void) solution;
+                            ++in_default;
+                        }
+                    }
+
+                    auto const own = snapshot.size(iri("g", w));
+                    CHECK((in_default == own || in_default == own + 1));
+                }
+            }
+        }
+
+        CHECK(ds.size() == 2 * writer_count * per_writer);
+        CHECK(ds.contains(Quad{iri("s", 5), p, iri("o", 1)}));
+        CHECK(ds.contains(Quad{iri("g", 1), iri("s", 5), p, iri("o", 1)}));
+        CHECK(!ds.contains(Quad{iri("g", 2), iri("s", 5), p, iri("o", 1)}));
+
+        CHECK(ds.remove(Quad{iri("g", 1), iri("s", 5), p, iri("o", 1)}));
+        CHECK(!ds.remove(Quad{iri("g", 1), iri("s", 5), p, iri("o", 1)}));
+        CHECK(!ds.remove(Quad{iri("nowhere", 0), iri("s", 5), p, iri("o", 1)}));
+        CHECK(ds.size() == 2 * writer_count * per_writer - 1);
+
+        auto const snapshot = ds.snapshot();
+        CHECK(snapshot.size() == ds.size());
+        CHECK(snapshot.size(iri("g", 1)) == per_writer - 1);
+        CHECK(ds.graph(iri("g", 3)).size() == per_writer);
+    }
+}
+
+TEST_CASE("graph snapshot") {
+    auto const iri = [](std::string_view kind, size_t ix) { return IRI{"http://example.com/" + std::string{kind} + std::to_string(ix)}; };
+    auto const stmt = [&](size_t ix) { return Statement{iri("s", ix % 10), iri("p", ix % 3), iri("o", ix)}; };
+
+    ConcurrentGraph g{storage::default_node_storage, 16};
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        g.add(stmt(ix));
+    }
+
+    auto const first = g.snapshot();
+    CHECK(first.size() == 1000);
+    CHECK(g.chunk_count() == 16 * ConcurrentGraph::chunks_per_shard);
+    CHECK(first.shared_chunk_count(g.snapshot()) == g.chunk_count());
+
+    // changes copy only the chunk they touch, not the whole shard
+    g.add(stmt(1000));
+    g.remove(stmt(0));
+
+    auto const second = g.snapshot();
+    CHECK(second.size() == 1000);
+    CHECK(first.shared_chunk_count(second) >= g.chunk_count() - 2);
+    CHECK(first.shared_chunk_count(second) < g.chunk_count());
+
+    CHECK(first.contains(stmt(0)));
+    CHECK(!first.contains(stmt(1000)));
+    CHECK(!second.contains(stmt(0)));
+    CHECK(second.contains(stmt(1000)));
+
+    size_t count = 0;
+    for (auto const &statement : first) {
+        CHECK(statement != stmt(1000));
+        ++count;
+    }
+    CHECK(count == first.size());
+
+    count = 0;
+    for (auto const &solution : second.match(query::TriplePattern{iri("s", 3), query::Variable{"p"}, query::Variable{"o"}})) {
+        CHECK(solution[query::Variable{"p"}].is_iri());
+        ++count;
+    }
+    CHECK(count == 100);
+
+    auto const graph = first.to_graph();
+    CHECK(graph.size() == first.size());
+    CHECK(graph.contains(stmt(0)));
+
+    GraphSnapshot const empty;
+    CHECK(empty.size() == 0);
+    CHECK((empty.begin() == empty.end()));
+    CHECK(!empty.contains(stmt(0)));
+}
+
+TEST_CASE("remove and set algebra") {
+    auto const s = [](size_t ix) { return IRI{"http://example.com/s" + std::to_string(ix)}; };
+    auto const p = [](size_t ix) { return IRI{"http://example.com/p" + std::to_string(ix)}; };
+    auto const o = [](size_t ix) { return IRI{"http://example.com/o" + std::to_string(ix)}; };
+    auto const stmt = [&](size_t ix) { return Statement{s(ix % 10), p(ix % 4), o(ix % 17)}; };
+
+    query::Variable const x{"x"};
+    query::Variable const y{"y"};
+    query::Variable const z{"z"};
+    query::TriplePattern const all{x, y, z};
+
+    std::vector<query::TriplePattern> const patterns{all, {s(3), y, z}, {x, p(2), z}, {x, y, o(5)}, {s(3), p(3), z}};
+
+    // graph with the statements stmt(ix) for ix in [begin, end)
+    auto const make_graph = [&](size_t begin, size_t end, bool indexed) {
+        Graph g;
+        if (indexed) {
+            g.build_indexes();
+        }
+        for (size_t ix = begin; ix < end; ++ix) {
+            g.add(stmt(ix));
+        }
+        return g;
+    };
+
+    SUBCASE("remove and erase") {
+        for (bool const indexed : {false, true}) {
+            CAPTURE(indexed);
+
+            auto g = make_graph(0, 200, indexed);
+            auto const full_size = g.size();
+
+            CHECK(g.remove(stmt(5)));
+            CHECK(!g.remove(stmt(5)));
+            CHECK(!g.remove(Statement{IRI{"http://example.com/absent"}, p(0), o(0)}));
+            CHECK(!g.contains(stmt(5)));
+            CHECK(g.size() == full_size - 1);
+
+            CHECK(g.erase({s(3), y, z}) == 20);
+            CHECK(g.erase({s(3), y, z}) == 0);
+            CHECK(g.erase({IRI{"http://example.com/absent"}, y, z}) == 0);
+            CHECK(g.size() == full_size - 21);
+            CHECK(g.statistics().size() == g.size());
+
+            // the indexes are still in sync with the triples
+            Graph scan;
+            for (auto const &statement : g) {
+                scan.add(statement);
+            }
+            for (auto const &pattern : patterns) {
+                CAPTURE(pattern);
+                CHECK(match_strings(g, pattern) == match_strings(scan, pattern));
+            }
+
+            auto const remaining = g.size();
+            CHECK(g.erase(all) == remaining);
+            CHECK(g.size() == 0);
+            CHECK(g.statistics().size() == 0);
+            CHECK(g.statistics().predicate_count() == 0);
+        }
+    }
+
+    SUBCASE("graph set algebra") {
+        for (bool const indexed : {false, true}) {
+            CAPTURE(indexed);
+
+            auto const lhs = make_graph(0, 120, indexed);
+            auto const rhs = make_graph(100, 160, !indexed);
+            auto const both = make_graph(100, 120, false);
+            auto const only_lhs = make_graph(0, 100, false);
+            auto const either = make_graph(0, 160, false);
+
+            for (auto const &pattern : patterns) {
+                CAPTURE(pattern);
+                CHECK(match_strings(lhs + rhs, pattern) == match_strings(either, pattern));
+                CHECK(match_strings(lhs - rhs, pattern) == match_strings(lhs - both, pattern));
+                CHECK(match_strings(lhs & rhs, pattern) == match_strings(both, pattern));
+                CHECK(match_strings(rhs & lhs, pattern) == match_strings(both, pattern));
+                CHECK(match_strings(rhs - lhs, pattern) == match_strings(make_graph(120, 160, false) - lhs, pattern));
+            }
+
+            CHECK((lhs - rhs).size() == (lhs - both).size());
+            CHECK((lhs - only_lhs).size() == both.size());
+            CHECK((lhs & rhs).has_indexes() == indexed);
+
+            auto g = lhs;
+            g -= g;
+            CHECK(g.size() == 0);
+            g += lhs;
+            g &= g;
+            CHECK(g.size() == lhs.size());
+            CHECK(g.statistics().size() == g.size());
+        }
+
+        // the other graph is translated into the node storage first
+        storage::reference_node_storage::UnsyncReferenceNodeStorage other_storage;
+        Graph foreign{other_storage};
+        for (size_t ix = 100; ix < 160; ++ix) {
+            foreign.add(stmt(ix));
+        }
+
+        auto const lhs = make_graph(0, 120, false);
+        CHECK(match_strings(lhs + foreign, all) == match_strings(make_graph(0, 160, false), all));
+        CHECK(match_strings(lhs & foreign, all) == match_strings(make_graph(100, 120, false), all));
+        CHECK((lhs - foreign).size() == (lhs - make_graph(100, 120, false)).size());
+    }
+
+    SUBCASE("dataset") {
+        auto const g1 = IRI{"http://example.com/g1"};
+        auto const g2 = IRI{"http://example.com/g2"};
+
+        Dataset lhs;
+        Dataset rhs;
+        for (size_t ix = 0; ix < 100; ++ix) {
+            lhs.add(Quad{g1, s(ix % 10), p(ix % 4), o(ix)});
+            lhs.add(Quad{s(ix % 10), p(ix % 4), o(ix)});
+            rhs.add(Quad{g1, s((ix + 50) % 10), p((ix + 50) % 4), o(ix + 50)});
+            rhs.add(Quad{g2, s(ix % 10), p(ix % 4), o(ix)});
+        }
+
+        CHECK((lhs + rhs).size() == 350);
+        CHECK((lhs + rhs).size(g2) == 100);
+        CHECK((lhs - rhs).size() == 150);
+        CHECK((lhs - rhs).size(g1) == 50);
+        CHECK((lhs & rhs).size() == 50);
+        CHECK((lhs & rhs).size(g1) == 50);
+        CHECK((lhs & rhs).contains(Quad{g1, s(9), p(3), o(99)}));
+        CHECK(!(lhs & rhs).contains(Quad{g1, s(7), p(3), o(7)}));
+
+        auto ds = lhs;
+        CHECK(ds.remove(Quad{g1, s(7), p(3), o(7)}));
+        CHECK(!ds.remove(Quad{g1, s(7), p(3), o(7)}));
+        CHECK(ds.remove(Quad{s(7), p(3), o(7)}));
+        CHECK(!ds.remove(Quad{g2, s(7), p(3), o(7)}));
+        CHECK(ds.size() == 198);
+
+        CHECK(ds.erase(query::QuadPattern{x, s(1), y, z}) == 20);
+        CHECK(ds.erase(query::QuadPattern{g1, s(2), y, z}) == 10);
+        CHECK(ds.erase(query::QuadPattern{g2, x, y, z}) == 0);
+        CHECK(ds.size() == 168);
+        CHECK(!ds.contains(Quad{g1, s(2), p(2), o(2)}));
+        CHECK(ds.contains(Quad{s(2), p(2), o(2)}));
+    }
+}
+
+TEST_CASE("to_node_storage") {
+    storage::reference_node_storage::SyncReferenceNodeStorage src;
+    storage::reference_node_storage::UnsyncReferenceNodeStorage dst;
+
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+
+    std::vector<Node> objects{IRI{"https://www.example.com/obj", src},
+                              BlankNode{"b1", src},
+                              Literal::make_simple("some string", src),
+                              Literal::make_lang_tagged("abc", "en", src),
+                              Literal::make_lang_tagged("a much longer string that is not inlined", "en-us", src),
+                              Literal::make_typed("custom", IRI{"https://www.example.com/datatype", src}, src),
+                              Literal::make_typed_from_value<datatypes::xsd::Int>(42, src),
+                              Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, src),
+                              Literal::make_typed("12:34:56.789", IRI{datatypes::xsd::Time::identifier, src}, src)};
+
+    for (size_t ix = 0; ix < 2000; ++ix) {
+        objects.push_back(IRI{"https://www.example.com/obj/" + std::to_string(ix), src});
+    }
+
+    auto const sub = IRI{"https://www.example.com/sub", src};
+    auto const pred = IRI{"https://www.example.com/pred", src};
+    auto const graph_name = IRI{"https://www.example.com/graph", src};
+
+    SUBCASE("graph") {
+        Graph g{src};
+        for (auto const &obj : objects) {
+            g.add(Statement{sub, pred, obj});
+        }
+
+        auto const moved = g.to_node_storage(dst);
+        CHECK(moved.size() == g.size());
+
+        for (auto const &stmt : moved) {
+            CHECK(stmt.subject().backend_handle().storage() == storage::DynNodeStoragePtr{dst});
+            CHECK(stmt.object().backend_handle().storage() == storage::DynNodeStoragePtr{dst});
+        }
+
+        for (auto const &obj : objects) {
+            CHECK(moved.contains(Statement{sub, pred, obj}));
+        }
+
+        auto const same = g.to_node_storage(src);
+        CHECK(same.size() == g.size());
+    }
+
+    SUBCASE("dataset") {
+        Dataset ds{src};
+        for (auto const &obj : objects) {
+            ds.add(Quad{sub, pred, obj});
+            ds.add(Quad{graph_name, sub, pred, obj});
+        }
+
+        auto const moved = ds.to_node_storage(dst);
+        CHECK(moved.size() == ds.size());
+        CHECK(moved.size(IRI{"https://www.example.com/graph", dst}) == objects.size());
+
+        for (auto const &obj : objects) {
+            CHECK(moved.contains(Quad{sub, pred, obj}));
+            CHECK(moved.contains(Quad{graph_name, sub, pred, obj}));
+        }
+    }
+}
@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/CachingNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::SyncReferenceNodeStorage;
+using reference_node_storage::UnsyncReferenceNodeStorage;
+
+static_assert(NodeStorage<CachingNodeStorage<SyncReferenceNodeStorage>>);
+static_assert(NodeStorageWithBatchFindOrMakeId<CachingNodeStorage<SyncReferenceNodeStorage>, view::IRIBackendView>);
+
+TEST_CASE("CachingNodeStorage") {
+    SyncReferenceNodeStorage inner;
+    CachingNodeStorage ns{inner};
+
+    auto const iri = IRI{"http://example.com/a", ns};
+    CHECK(iri.identifier() == "http://example.com/a");
+    CHECK(IRI{"http://example.com/a", ns} == iri);
+    CHECK(IRI::find("http://example.com/a", ns) == iri);
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}) == inner.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}));
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/b"}).null());
+
+    // not cached, longer than max_iri_size
+    std::string const long_iri = "http://example.com/" + std::string(200, 'x');
+    CHECK(IRI{long_iri, ns}.identifier() == long_iri);
+    CHECK(IRI{long_iri, ns} == IRI{long_iri, ns});
+
+    auto const lit = Literal::make_typed("abc", IRI{"http://example.com/dt", ns}, ns);
+    CHECK(lit.datatype().identifier() == "http://example.com/dt");
+
+    SUBCASE("erase through the wrapper invalidates") {
+        CHECK(ns.erase_iri(iri.backend_handle().id()));
+        CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}).null());
+        CHECK(IRI::find("http://example.com/a", ns).null());
+    }
+
+    SUBCASE("erase of the wrapped storage needs invalidate") {
+        CHECK(inner.erase_iri(iri.backend_handle().id()));
+        ns.invalidate();
+        CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}).null());
+    }
+}
+
+TEST_CASE("CachingNodeStorage clear") {
+    UnsyncReferenceNodeStorage inner;
+    CachingNodeStorage ns{inner};
+
+    auto const id = ns.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/a"});
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}) == id);
+
+    ns.clear();
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}).null());
+}
+
+TEST_CASE("CachingNodeStorage separate wrappers do not share entries") {
+    SyncReferenceNodeStorage inner1;
+    SyncReferenceNodeStorage inner2;
+    CachingNodeStorage ns1{inner1};
+    CachingNodeStorage ns2{inner2};
+
+    (void) ns2.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/other"});
+    auto const id1 = ns1.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/a"});
+    auto const id2 = ns2.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/a"});
+
+    CHECK(id1 == inner1.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}));
+    CHECK(id2 == inner2.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}));
+    CHECK(id1 != id2);
+}
+
+TEST_CASE("CachingNodeStorage concurrent interning") {
+    static constexpr size_t n_threads = 8;
+    static constexpr size_t n_iris = 1000;
+
+    SyncReferenceNodeStorage inner;
+    CachingNodeStorage ns{inner};
+
+    std::vector<std::vector<identifier::NodeBackendID>> ids(n_threads, std::vector<identifier::NodeBackendID>(n_iris));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&ns, &thread_ids = ids[t]]() {
+                for (size_t round = 0; round < 3; ++round) {
+                    for (size_t ix = 0; ix < n_iris; ++ix) {
+                        thread_ids[ix] = ns.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix % 50)});
+                    }
+                }
+            });
+        }
+    }
+
+    for (size_t ix = 0; ix < n_iris; ++ix) {
+        auto const id = inner.find_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix % 50)});
+        for (size_t t = 0; t < n_threads; ++t) {
+            CHECK(ids[t][ix] == id);
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/FrozenNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/ShardedReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::FrozenNodeStorage;
+
+TEST_CASE("FrontCodedDictionary") {
+    using reference_node_storage::detail::FrontCodedDictionary;
+
+    std::vector<std::string> keys{"", "a", "ab", "abc", "abd", "b", "http://example.com/", "http://example.com/a", "http://example.org/"};
+    for (size_t ix = 0; ix < 100; ++ix) {
+        keys.push_back("http://example.com/" + std::to_string(ix));
+    }
+
+    // bytes >= 0x80 (UTF-8, raw ids) must be ordered as unsigned char
+    for (auto const *key : {"http://example.com/Zagreb", "http://example.com/Zurich", "http://example.com/Z\u00fcrich", "http://example.com/Z\u00fcrich2",
+                            "a\x7f", "a\x80", "a\xff", "a\xff\x01", "\x80\x01", "\xff"}) {
+        keys.emplace_back(key);
+    }
+
+    std::vector<FrontCodedDictionary::Entry> entries;
+    for (size_t ix = 0; ix < keys.size(); ++ix) {
+        // reverse insertion order, dictionary must sort
+        auto const index = keys.size() - ix;
+        entries.push_back(FrontCodedDictionary::Entry{.key = keys[ix], .id = identifier::NodeBackendID{identifier::NodeID{index}, identifier::RDFNodeType::IRI}, .index = index});
+    }
+
+    FrontCodedDictionary const dict{entries};
+    CHECK_EQ(dict.size(), keys.size());
+
+    std::string buf;
+    for (size_t ix = 0; ix < keys.size(); ++ix) {
+        auto const index = keys.size() - ix;
+        CHECK_EQ(dict.find_id(keys[ix]).node_id().to_underlying(), index);
+        CHECK(dict.find_key(index, buf));
+        CHECK_EQ(buf, keys[ix]);
+    }
+
+    for (auto const *missing : {"aa", "abcd", "c", "http://example.com/100", "http://example.com/1a", "http://example.co", "zzz",
+                                "http://example.com/Z\u00fcric", "http://example.com/Z\u00f6rich", "a\x81", "\xfe"}) {
+        CHECK(dict.find_id(missing).null());
+    }
+
+    CHECK(!dict.find_key(0, buf));
+    CHECK(!dict.find_key(keys.size() + 1, buf));
+}
+
+TEST_CASE_TEMPLATE("FrozenNodeStorage", NS, reference_node_storage::SyncReferenceNodeStorage,
+                   reference_node_storage::UnsyncReferenceNodeStorage, reference_node_storage::ShardedReferenceNodeStorage) {
+    NS source;
+
+    std::vector<IRI> iris;
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        iris.emplace_back("http://example.com/" + std::to_string(ix), source);
+    }
+
+    auto const bnode = BlankNode{"b1", source};
+    auto const var = query::Variable{"x", false, source};
+    auto const anon_var = query::Variable{"x", true, source};
+    auto const lang = Literal::make_lang_tagged("hallo", "de", source);
+    auto const escaped = Literal::make_simple("line\nbreak", source);
+    auto const typed = Literal::make_typed("abc", IRI{"http://example.com/dt", source}, source);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, source);
+    REQUIRE(!value.backend_handle().is_inlined());
+
+    size_t node_count = 0;
+    source.for_each_node([&node_count](identifier::NodeBackendID, auto const &) {
+        ++node_count;
+    });
+
+    FrozenNodeStorage frozen{source};
+    CHECK_EQ(frozen.size(), node_count);
+
+    // ids stay the same
+    for (size_t ix = 0; ix < iris.size(); ++ix) {
+        CHECK_EQ(frozen.find_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)}), iris[ix].backend_handle().id());
+        CHECK_EQ(frozen.find_iri_backend(iris[ix].backend_handle().id()).identifier, "http://example.com/" + std::to_string(ix));
+    }
+
+    CHECK_EQ(frozen.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}), identifier::NodeBackendID::xsd_string_iri.first);
+    CHECK_EQ(frozen.find_id(view::BNodeBackendView{.identifier = "b1"}), bnode.backend_handle().id());
+    CHECK_EQ(frozen.find_id(view::VariableBackendView{.name = "x", .is_anonymous = false}), var.backend_handle().id());
+    CHECK_EQ(frozen.find_id(view::VariableBackendView{.name = "x", .is_anonymous = true}), anon_var.backend_handle().id());
+
+    for (auto const &lit : {lang, escaped, typed, value}) {
+        auto const view = source.find_literal_backend(lit.backend_handle().id());
+        CHECK_EQ(frozen.find_id(view), source.find_id(view));
+    }
+
+    // nodes are readable through the frozen storage
+    DynNodeStoragePtr ns{frozen};
+    auto const frozen_node = [&ns](Node const &node) {
+        return Node{identifier::NodeBackendHandle{node.backend_handle().id(), ns}};
+    };
+
+    CHECK_EQ(frozen_node(iris[42]).as_iri().identifier(), "http://example.com/42");
+    CHECK_EQ(frozen_node(bnode).as_blank_node().identifier(), "b1");
+    CHECK_EQ(frozen_node(var).as_variable().name(), "x");
+    CHECK(frozen_node(anon_var).as_variable().is_anonymous());
+
+    auto const frozen_lang = frozen_node(lang).as_literal();
+    CHECK_EQ(frozen_lang.lexical_form(), "hallo");
+    CHECK_EQ(frozen_lang.language_tag(), "de");
+    CHECK_EQ(frozen_node(escaped).as_literal().lexical_form(), "line\nbreak");
+    CHECK_EQ(frozen_node(typed).as_literal().datatype().identifier(), "http://example.com/dt");
+    CHECK_EQ(frozen_node(value).as_literal().template value<datatypes::xsd::Integer>(), big_int);
+
+    // existing nodes can be "made", new ones can not
+    CHECK_EQ(IRI("http://example.com/5", ns), frozen_node(iris[5]).as_iri());
+    CHECK_THROWS_AS(IRI("http://example.com/new", ns), std::runtime_error);
+    CHECK_THROWS_AS(Literal::make_simple("new", ns), std::runtime_error);
+    CHECK(!frozen.erase_iri(iris[5].backend_handle().id()));
+    CHECK_EQ(frozen.size(), node_count);
+}
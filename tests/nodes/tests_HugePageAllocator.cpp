@@ -0,0 +1,55 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/HugePageAllocator.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using namespace rdf4cpp::storage::reference_node_storage;
+
+TEST_CASE("HugePageAllocator") {
+    SUBCASE("small allocations") {
+        std::vector<int, detail::HugePageAllocator<int>> v{1, 2, 3};
+        CHECK(v[2] == 3);
+    }
+
+    SUBCASE("large allocations are huge page aligned") {
+        std::vector<uint64_t, detail::HugePageAllocator<uint64_t>> v(detail::HugePageMemory::huge_page_size, 42);
+        CHECK(reinterpret_cast<uintptr_t>(v.data()) % detail::HugePageMemory::huge_page_size == 0);
+        CHECK(v.front() == 42);
+        CHECK(v.back() == 42);
+
+        v.resize(v.size() * 2 + 1, 7);
+        CHECK(v[v.size() / 2 - 1] == 42);
+        CHECK(v.back() == 7);
+    }
+}
+
+TEST_CASE_TEMPLATE("huge page reference node storages", NS, HugePageUnsyncReferenceNodeStorage, HugePageSyncReferenceNodeStorage) {
+    NS ns;
+
+    std::vector<IRI> iris;
+    for (size_t ix = 0; ix < (1 << 16); ++ix) {
+        iris.emplace_back("http://example.com/" + std::to_string(ix), ns);
+    }
+
+    auto const lit = Literal::make_typed_from_value<datatypes::xsd::Integer>(1234, ns);
+    auto const simple = Literal::make_simple("abc", ns);
+
+    for (size_t ix = 0; ix < iris.size(); ++ix) {
+        CHECK(ns.find_iri_backend(iris[ix].backend_handle().id()).identifier == "http://example.com/" + std::to_string(ix));
+    }
+
+    CHECK(IRI::find("http://example.com/42", ns) == iris[42]);
+    CHECK(Literal::find_simple("abc", ns) == simple);
+    CHECK(lit.value<datatypes::xsd::Integer>() == 1234);
+
+    CHECK(ns.erase_iri(iris[42].backend_handle().id()));
+    CHECK(IRI::find("http://example.com/42", ns).null());
+}
@@ -0,0 +1,111 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/detail/BloomFilter.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::NegativeLookupFilterOptions;
+using reference_node_storage::SyncReferenceNodeStorage;
+using reference_node_storage::detail::BloomFilter;
+
+TEST_CASE("BloomFilter") {
+    static constexpr size_t n = 10000;
+
+    BloomFilter filter{n, 0.01};
+    CHECK(filter.num_bits() >= n * 9);
+    CHECK(filter.num_hashes() == 7);
+
+    std::hash<std::string> hasher;
+    for (size_t ix = 0; ix < n; ++ix) {
+        filter.insert(hasher("present" + std::to_string(ix)));
+    }
+
+    for (size_t ix = 0; ix < n; ++ix) {
+        CHECK(filter.may_contain(hasher("present" + std::to_string(ix))));
+    }
+
+    size_t false_positives = 0;
+    for (size_t ix = 0; ix < n; ++ix) {
+        false_positives += filter.may_contain(hasher("absent" + std::to_string(ix)));
+    }
+    CHECK(false_positives < n / 50);
+
+    filter.clear();
+    CHECK(!filter.may_contain(hasher("present0")));
+}
+
+TEST_CASE("SyncReferenceNodeStorage with negative lookup filter") {
+    SyncReferenceNodeStorage ns{NegativeLookupFilterOptions{.expected_nodes = 1000, .false_positive_rate = 0.01}};
+
+    // predefined IRIs are in the filter
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}) == identifier::NodeBackendID::xsd_string_iri.first);
+
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}).null());
+    CHECK(Literal::find_simple("abc", ns).null());
+
+    auto const iri = IRI{"http://example.com/a", ns};
+    auto const bnode = BlankNode{"b1", ns};
+    auto const simple = Literal::make_simple("abc", ns);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns);
+
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}) == iri.backend_handle().id());
+    CHECK(ns.find_id(view::BNodeBackendView{.identifier = "b1"}) == bnode.backend_handle().id());
+    CHECK(Literal::find_simple("abc", ns) == simple);
+    CHECK(Literal::find_typed_from_value<datatypes::xsd::Integer>(big_int, ns) == value);
+    CHECK(IRI::find("http://example.com/a", ns) == iri);
+
+    // erased nodes stay in the filter, but are not found
+    CHECK(ns.erase_iri(iri.backend_handle().id()));
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}).null());
+
+    std::vector<view::IRIBackendView> views;
+    std::vector<std::string> iris;
+    for (size_t ix = 0; ix < 100; ++ix) {
+        iris.push_back("http://example.com/batch/" + std::to_string(ix));
+    }
+    for (auto const &s : iris) {
+        views.push_back(view::IRIBackendView{.identifier = s});
+    }
+
+    std::vector<identifier::NodeBackendID> ids(views.size());
+    ns.find_or_make_ids(views, ids);
+    for (size_t ix = 0; ix < views.size(); ++ix) {
+        CHECK(ns.find_id(views[ix]) == ids[ix]);
+    }
+}
+
+TEST_CASE("SyncReferenceNodeStorage with negative lookup filter concurrent interning") {
+    static constexpr size_t n_threads = 8;
+    static constexpr size_t n_iris = 2000;
+
+    // deliberately undersized, the filter must never cause a miss
+    SyncReferenceNodeStorage ns{NegativeLookupFilterOptions{.expected_nodes = 100, .false_positive_rate = 0.1}};
+
+    std::vector<std::vector<identifier::NodeBackendID>> ids(n_threads, std::vector<identifier::NodeBackendID>(n_iris));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&ns, &thread_ids = ids[t], t]() {
+                for (size_t ix = 0; ix < n_iris; ++ix) {
+                    auto const iri_ix = (ix + t * 251) % n_iris;
+                    thread_ids[iri_ix] = ns.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(iri_ix)});
+                }
+            });
+        }
+    }
+
+    for (size_t ix = 0; ix < n_iris; ++ix) {
+        auto const id = ns.find_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)});
+        CHECK(!id.null());
+        for (size_t t = 0; t < n_threads; ++t) {
+            CHECK(ids[t][ix] == id);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/NodeStorageCollector.hpp>
+
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::NodeStorageCollector;
+using reference_node_storage::SyncReferenceNodeStorage;
+
+TEST_CASE("NodeStorageCollector") {
+    SyncReferenceNodeStorage ns;
+    NodeStorageCollector collector{ns};
+
+    std::vector<Node> kept;
+    auto const root = collector.add_root([&kept](auto const &mark) {
+        for (auto const &node : kept) {
+            mark(node.backend_handle().id());
+        }
+    });
+
+    identifier::NodeBackendID dropped_id;
+
+    {
+        auto guard = collector.pin();
+
+        kept.push_back(IRI{"http://example.com/kept", ns});
+        kept.push_back(BlankNode{"kept", ns});
+        kept.push_back(Literal::make_typed("kept", IRI{"http://example.com/kept_type", ns}, ns));
+
+        dropped_id = IRI{"http://example.com/dropped", ns}.backend_handle().id();
+        (void) BlankNode{"dropped", ns};
+        (void) query::Variable{"dropped", false, ns};
+        (void) Literal::make_typed("dropped", IRI{"http://example.com/dropped_type", ns}, ns);
+        (void) Literal::make_typed_from_value<datatypes::xsd::Integer>(static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000, ns);
+
+        // protected by the guard
+        CHECK_EQ(collector.collect(), 0);
+    }
+
+    CHECK_EQ(collector.collect(), 6);
+    CHECK_EQ(collector.collected(), 6);
+
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/dropped"}).null());
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/dropped_type"}).null());
+    CHECK(ns.find_id(view::BNodeBackendView{.identifier = "dropped"}).null());
+    CHECK(ns.find_id(view::VariableBackendView{.name = "dropped", .is_anonymous = false}).null());
+
+    // rooted nodes, the datatypes of their literals and predefined IRIs survive
+    CHECK_EQ(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/kept"}), kept[0].backend_handle().id());
+    CHECK_EQ(ns.find_id(view::BNodeBackendView{.identifier = "kept"}), kept[1].backend_handle().id());
+    CHECK_EQ(kept[2].as_literal().lexical_form(), "kept");
+    CHECK_EQ(kept[2].as_literal().datatype().identifier(), "http://example.com/kept_type");
+    CHECK_EQ(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}), identifier::NodeBackendID::xsd_string_iri.first);
+
+    // ids are recycled
+    {
+        auto guard = collector.pin();
+        CHECK_EQ(IRI("http://example.com/new", ns).backend_handle().id().node_id(), dropped_id.node_id());
+    }
+
+    collector.remove_root(root);
+    CHECK_EQ(collector.collect(), 5);
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/kept"}).null());
+    CHECK_EQ(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}), identifier::NodeBackendID::xsd_string_iri.first);
+}
+
+TEST_CASE("NodeStorageCollector background collection") {
+    SyncReferenceNodeStorage ns;
+    NodeStorageCollector collector{ns, std::chrono::milliseconds{1}};
+
+    std::mutex kept_mutex;
+    std::vector<Node> kept;
+    collector.add_root([&](auto const &mark) {
+        std::lock_guard lock{kept_mutex};
+        for (auto const &node : kept) {
+            mark(node.backend_handle().id());
+        }
+    });
+
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        auto guard = collector.pin();
+
+        auto const iri = IRI{"http://example.com/" + std::to_string(ix), ns};
+        if (ix % 2 == 0) {
+            std::lock_guard lock{kept_mutex};
+            kept.push_back(iri);
+        }
+    }
+
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (collector.collected() < 500 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    CHECK_EQ(collector.collected(), 500);
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        auto const id = ns.find_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)});
+        CHECK_EQ(id.null(), ix % 2 != 0);
+    }
+}
@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <dice/sparse-map/sparse_map.hpp>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::PrefixCompressedUnsyncReferenceNodeStorage;
+using reference_node_storage::UnsyncReferenceNodeStorage;
+
+TEST_CASE_TEMPLATE("UnsyncReferenceNodeStorage renumber", NS, UnsyncReferenceNodeStorage, PrefixCompressedUnsyncReferenceNodeStorage) {
+    NS ns;
+
+    std::vector<IRI> iris;
+    for (size_t ix = 0; ix < 100; ++ix) {
+        iris.emplace_back("http://example.com/" + std::to_string(ix % 2 == 0 ? "even" : "odd") + "/" + std::to_string(ix), ns);
+    }
+
+    auto const datatype = IRI{"http://example.com/datatype", ns};
+
+    // leaves a hole at the end of the IRI ids, no further IRIs are created before renumbering
+    auto const erased = IRI{"http://example.com/erased", ns};
+    CHECK(ns.erase_iri(erased.backend_handle().id()));
+
+    auto const custom = Literal::make_typed("custom", datatype, ns);
+    auto const simple = Literal::make_simple("abc", ns);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns);
+    auto const small = Literal::make_typed_from_value<datatypes::xsd::Int>(42, ns);
+    auto const bnode = BlankNode{"b1", ns};
+
+    // the last IRI is the most frequent one
+    auto const hot = iris.back();
+
+    Graph g{ns};
+    for (auto const &iri : iris) {
+        g.add(Statement{bnode, hot, iri});
+    }
+    g.add(Statement{bnode, hot, custom});
+    g.add(Statement{bnode, hot, simple});
+    g.add(Statement{bnode, hot, value});
+    g.add(Statement{bnode, hot, small});
+
+    dice::sparse_map::sparse_map<identifier::NodeBackendID, size_t> frequencies;
+    for (auto const &stmt : g) {
+        for (auto const &node : stmt) {
+            ++frequencies[node.backend_handle().id()];
+        }
+    }
+
+    auto const old_size = ns.size();
+    auto const remapping = ns.renumber([&frequencies](identifier::NodeBackendID const id) noexcept -> size_t {
+        auto const it = frequencies.find(id);
+        return it == frequencies.end() ? 0 : it->second;
+    });
+
+    CHECK(ns.size() == old_size - 1);
+    CHECK(remapping[hot.backend_handle().id()].node_id() == identifier::NodeID::min_iri_id);
+    CHECK(remapping[bnode.backend_handle().id()] == bnode.backend_handle().id());
+    CHECK(remapping[small.backend_handle().id()] == small.backend_handle().id()); // inlined
+
+    // predefined IRIs keep their ids
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}) == identifier::NodeBackendID::xsd_string_iri.first);
+
+    for (auto const &iri : iris) {
+        auto const new_id = remapping[iri.backend_handle().id()];
+        CHECK(ns.find_iri_backend(new_id).identifier == iri.identifier());
+        CHECK(ns.find_id(view::IRIBackendView{.identifier = iri.identifier()}) == new_id);
+    }
+
+    // among equally frequent IRIs, the ones of the same namespace are adjacent
+    auto const even_0 = remapping[iris[0].backend_handle().id()].node_id().to_underlying();
+    auto const even_2 = remapping[iris[2].backend_handle().id()].node_id().to_underlying();
+    auto const odd_1 = remapping[iris[1].backend_handle().id()].node_id().to_underlying();
+    CHECK(even_0 < odd_1);
+    CHECK(even_2 < odd_1);
+
+    // literals with a renumbered datatype IRI refer to the new id of it
+    auto const custom_view = ns.find_literal_backend(remapping[custom.backend_handle().id()]).get_lexical();
+    CHECK(custom_view.lexical_form == "custom");
+    CHECK(custom_view.datatype_id == remapping[datatype.backend_handle().id()]);
+
+    g.remap_node_ids(remapping);
+    CHECK(g.size() == iris.size() + 4);
+
+    auto const new_hot = IRI{hot.identifier(), ns};
+    auto const new_bnode = BlankNode{"b1", ns};
+    for (auto const &iri : iris) {
+        CHECK(g.contains(Statement{new_bnode, new_hot, IRI{iri.identifier(), ns}}));
+    }
+    CHECK(g.contains(Statement{new_bnode, new_hot, Literal::make_typed("custom", IRI{"http://example.com/datatype", ns}, ns)}));
+    CHECK(g.contains(Statement{new_bnode, new_hot, Literal::make_simple("abc", ns)}));
+    CHECK(g.contains(Statement{new_bnode, new_hot, Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns)}));
+    CHECK(g.contains(Statement{new_bnode, new_hot, small}));
+
+    // the storage stays usable
+    auto const fresh = IRI{"http://example.com/fresh", ns};
+    CHECK(IRI::find("http://example.com/fresh", ns) == fresh);
+}
@@ -0,0 +1,183 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::PrefixCompressedUnsyncReferenceNodeStorage;
+using reference_node_storage::SyncReferenceNodeStorage;
+using reference_node_storage::UnsyncReferenceNodeStorage;
+
+TEST_CASE_TEMPLATE("UnsyncReferenceNodeStorage snapshot", NS, UnsyncReferenceNodeStorage, PrefixCompressedUnsyncReferenceNodeStorage) {
+    NS src;
+
+    auto const iri = IRI{"http://example.com/a", src};
+    auto const erased_iri = IRI{"http://example.com/erased", src};
+    auto const iri2 = IRI{"http://example.com/b", src};
+    auto const bnode = BlankNode{"b1", src};
+    auto const variable = src.find_or_make_id(view::VariableBackendView{.name = "x", .is_anonymous = true});
+    auto const simple = Literal::make_simple("abc", src);
+    auto const lang = Literal::make_lang_tagged("abc", "en", src);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, src);
+    auto const time = Literal::make_typed("12:34:56.789", IRI{datatypes::xsd::Time::identifier}, src);
+
+    CHECK(src.erase_iri(erased_iri.backend_handle().id()));
+
+    std::stringstream buf;
+    src.dump(buf);
+
+    NS dst;
+    dst.restore(buf);
+
+    CHECK(dst.size() == src.size());
+
+    CHECK(dst.find_iri_backend(iri.backend_handle().id()).identifier == "http://example.com/a");
+    CHECK(dst.find_iri_backend(iri2.backend_handle().id()).identifier == "http://example.com/b");
+    CHECK(dst.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}) == iri.backend_handle().id());
+    CHECK(dst.find_id(view::IRIBackendView{.identifier = "http://example.com/erased"}).null());
+    CHECK(dst.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}) == identifier::NodeBackendID::xsd_string_iri.first);
+
+    CHECK(dst.find_bnode_backend(bnode.backend_handle().id()).identifier == "b1");
+    CHECK(dst.find_id(view::BNodeBackendView{.identifier = "b1"}) == bnode.backend_handle().id());
+
+    CHECK(dst.find_variable_backend(variable).name == "x");
+    CHECK(dst.find_variable_backend(variable).is_anonymous);
+    CHECK(dst.find_id(view::VariableBackendView{.name = "x", .is_anonymous = true}) == variable);
+
+    CHECK(Literal::find_simple("abc", dst).backend_handle().id() == simple.backend_handle().id());
+    CHECK(Literal::find_lang_tagged("abc", "en", dst).backend_handle().id() == lang.backend_handle().id());
+    CHECK(Literal::find_typed_from_value<datatypes::xsd::Integer>(big_int, dst).backend_handle().id() == value.backend_handle().id());
+
+    auto const restored_time = Literal{identifier::NodeBackendHandle{time.backend_handle().id(), dst}};
+    CHECK(restored_time.value<datatypes::xsd::Time>() == time.value<datatypes::xsd::Time>());
+
+    // the id of the erased node is reused the same way by both storages
+    auto const new_src = src.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/new"});
+    auto const new_dst = dst.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/new"});
+    CHECK(new_src == new_dst);
+    CHECK(new_dst == erased_iri.backend_handle().id());
+}
+
+TEST_CASE("UnsyncReferenceNodeStorage snapshot errors") {
+    UnsyncReferenceNodeStorage src;
+    std::ignore = IRI{"http://example.com/a", src};
+    std::ignore = BlankNode{"b1", src};
+
+    std::stringstream buf;
+    src.dump(buf);
+    auto const snapshot = buf.str();
+
+    // the bnode section comes first: tag at 24, capacity at 32, number of entries at 40, id of the first entry at 48, size of its identifier at 56
+    auto const with_u64_at = [&](size_t const offset, uint64_t const value) {
+        auto corrupted = snapshot;
+        std::memcpy(corrupted.data() + offset, &value, sizeof(value));
+        return corrupted;
+    };
+
+    SUBCASE("truncated") {
+        UnsyncReferenceNodeStorage dst;
+        std::ignore = IRI{"http://example.com/existing", dst};
+
+        std::istringstream in{snapshot.substr(0, snapshot.size() - 4)};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+
+        // cleared on failure
+        CHECK(dst.find_id(view::IRIBackendView{.identifier = "http://example.com/existing"}).null());
+        CHECK(dst.size() == UnsyncReferenceNodeStorage{}.size());
+    }
+
+    SUBCASE("wrong magic") {
+        auto corrupted = snapshot;
+        corrupted[0] = 'x';
+
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{corrupted};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+    }
+
+    SUBCASE("wrong version") {
+        auto corrupted = snapshot;
+        corrupted[8] ^= 0x7f; // first byte of pobr_version
+
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{corrupted};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+    }
+
+    SUBCASE("capacity too large") {
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{with_u64_at(32, uint64_t{1} << identifier::NodeID::width)};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+    }
+
+    SUBCASE("capacity is not allocated up front") {
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{with_u64_at(32, (uint64_t{1} << identifier::NodeID::width) - 2)};
+        dst.restore(in);
+
+        CHECK(dst.find_id(view::BNodeBackendView{.identifier = "b1"}) == src.find_id(view::BNodeBackendView{.identifier = "b1"}));
+        CHECK(dst.size() == src.size());
+    }
+
+    SUBCASE("invalid id") {
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{with_u64_at(48, 0)};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+    }
+
+    SUBCASE("more entries than capacity") {
+        UnsyncReferenceNodeStorage dst;
+        std::istringstream in{with_u64_at(40, std::numeric_limits<uint64_t>::max())};
+        CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+    }
+
+    SUBCASE("string too large") {
+        for (auto const size : {uint64_t{1} << 40, std::numeric_limits<uint64_t>::max()}) {
+            UnsyncReferenceNodeStorage dst;
+            std::istringstream in{with_u64_at(56, size)};
+            CHECK_THROWS_AS(dst.restore(in), std::runtime_error);
+        }
+    }
+}
+
+TEST_CASE("SyncReferenceNodeStorage snapshot") {
+    SyncReferenceNodeStorage src;
+
+    auto const iri = IRI{"http://example.com/a", src};
+    auto const erased_iri = IRI{"http://example.com/erased", src};
+    auto const iri2 = IRI{"http://example.com/b", src};
+    auto const typed = Literal::make_typed("abc", IRI{"http://example.com/dt", src}, src);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, src);
+
+    CHECK(src.erase_iri(erased_iri.backend_handle().id()));
+
+    std::stringstream buf;
+    src.dump(buf);
+
+    UnsyncReferenceNodeStorage dst;
+    dst.restore(buf);
+
+    CHECK(dst.size() == src.size());
+    CHECK(dst.find_iri_backend(iri.backend_handle().id()).identifier == "http://example.com/a");
+    CHECK(dst.find_iri_backend(iri2.backend_handle().id()).identifier == "http://example.com/b");
+    CHECK(dst.find_id(view::IRIBackendView{.identifier = "http://example.com/erased"}).null());
+
+    auto const restored_typed = Literal{identifier::NodeBackendHandle{typed.backend_handle().id(), dst}};
+    CHECK(restored_typed.lexical_form() == "abc");
+    CHECK(restored_typed.datatype().identifier() == "http://example.com/dt");
+    CHECK(Literal::find_typed_from_value<datatypes::xsd::Integer>(big_int, dst).backend_handle().id() == value.backend_handle().id());
+
+    // the id of the erased node is reused the same way by both storages
+    CHECK(src.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/new"}) == dst.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/new"}));
+}
@@ -0,0 +1,114 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/ShardedReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::NodeStorageStats;
+using reference_node_storage::SyncReferenceNodeStorage;
+
+TEST_CASE("SyncReferenceNodeStorage stats") {
+    SyncReferenceNodeStorage ns;
+
+    auto const initial = ns.stats();
+    CHECK(initial.iris.entries > 0); // predefined datatype IRIs
+    CHECK(initial.bnodes.entries == 0);
+    CHECK(initial.variables.entries == 0);
+    CHECK(initial.lexical_literals.entries == 0);
+    CHECK(initial.specialized_literals.entries == 0);
+
+    static constexpr std::string_view iri_str = "http://example.com/some/iri";
+    auto const iri = IRI{iri_str, ns};
+    auto const bnode = BlankNode{"b1", ns};
+    auto const simple = Literal::make_simple("abc", ns);
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+    auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns);
+
+    auto const after_insert = ns.stats();
+    CHECK(after_insert.iris.entries == initial.iris.entries + 1);
+    CHECK(after_insert.iris.string_bytes >= initial.iris.string_bytes + iri_str.size());
+    CHECK(after_insert.iris.id_capacity >= after_insert.iris.entries);
+    CHECK(after_insert.iris.load_factor > 0.0);
+    CHECK(after_insert.bnodes.entries == 1);
+    CHECK(after_insert.lexical_literals.entries == 1);
+    CHECK(after_insert.specialized_literals.entries == 1);
+
+    // lookups of existing nodes
+    CHECK(IRI::find(iri_str, ns) == iri);
+    CHECK(Literal::find_simple("abc", ns) == simple);
+
+    CHECK(ns.erase_iri(iri.backend_handle().id()));
+    CHECK(ns.erase_bnode(bnode.backend_handle().id()));
+
+    auto const after_erase = ns.stats();
+    CHECK(after_erase.iris.entries == initial.iris.entries);
+    CHECK(after_erase.iris.vacant_ids == initial.iris.vacant_ids + 1);
+    CHECK(after_erase.iris.id_capacity == after_insert.iris.id_capacity);
+    CHECK(after_erase.bnodes.entries == 0);
+    CHECK(after_erase.bnodes.vacant_ids == 1);
+    CHECK(after_erase.bnodes.string_bytes == 0);
+
+    // reinsertion reuses the vacant id
+    auto const iri2 = IRI{iri_str, ns};
+    CHECK(ns.stats().iris.vacant_ids == initial.iris.vacant_ids);
+
+    if constexpr (NodeStorageStats::counters_enabled) {
+        CHECK(after_erase.iris.inserts >= 1);
+        CHECK(after_erase.iris.lookup_hits >= 1);
+        CHECK(after_erase.iris.lookup_misses >= after_erase.iris.inserts);
+        CHECK(after_erase.lexical_literals.inserts == 1);
+        CHECK(after_erase.lexical_literals.lookup_hits >= 1);
+    } else {
+        CHECK(after_erase.iris.inserts == 0);
+        CHECK(after_erase.iris.lookup_hits == 0);
+        CHECK(after_erase.iris.lookup_misses == 0);
+        CHECK(after_erase.iris.shared_lock_wait_ns == 0);
+        CHECK(after_erase.iris.unique_lock_wait_ns == 0);
+    }
+}
+
+TEST_CASE_TEMPLATE("stats of the other reference node storages", NS, reference_node_storage::UnsyncReferenceNodeStorage, reference_node_storage::ShardedReferenceNodeStorage) {
+    NS ns;
+
+    auto const initial = ns.stats();
+    CHECK(initial.iris.entries > 0); // predefined datatype IRIs
+    CHECK(initial.bnodes.entries == 0);
+    CHECK(initial.lexical_literals.entries == 0);
+    CHECK(initial.specialized_literals.entries == 0);
+
+    std::vector<identifier::NodeBackendID> bnodes;
+    for (size_t ix = 0; ix < 100; ++ix) {
+        bnodes.push_back(ns.find_or_make_id(view::BNodeBackendView{.identifier = "b" + std::to_string(ix)}));
+    }
+    auto const iri = IRI{"http://example.com/some/iri", ns};
+    auto const simple = Literal::make_simple("abc", ns);
+
+    auto const after_insert = ns.stats();
+    CHECK(after_insert.iris.entries == initial.iris.entries + 1);
+    CHECK(after_insert.bnodes.entries == 100); // summed over all shards of ShardedReferenceNodeStorage
+    CHECK(after_insert.bnodes.string_bytes >= 100 * 2);
+    CHECK(after_insert.bnodes.id_capacity >= 100);
+    CHECK(after_insert.bnodes.load_factor > 0.0);
+    CHECK(after_insert.lexical_literals.entries == 1);
+
+    CHECK(ns.erase_bnode(bnodes[0]));
+    auto const after_erase = ns.stats();
+    CHECK(after_erase.bnodes.entries == 99);
+    CHECK(after_erase.bnodes.vacant_ids == initial.bnodes.vacant_ids + 1);
+
+    if constexpr (!NodeStorageStats::counters_enabled || std::is_same_v<NS, reference_node_storage::UnsyncReferenceNodeStorage>) {
+        CHECK(after_erase.bnodes.inserts == 0);
+        CHECK(after_erase.bnodes.lookup_misses == 0);
+    } else {
+        CHECK(after_erase.bnodes.inserts == 100);
+    }
+}
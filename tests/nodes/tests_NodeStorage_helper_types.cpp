@@ -2,7 +2,14 @@
 
 #include <doctest/doctest.h>
 #include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/ShardedReferenceNodeStorage.hpp>
 #include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <atomic>
+#include <limits>
+#include <string>
+#include <thread>
 
 TEST_SUITE("NodeStorage helper types") {
     using namespace rdf4cpp::storage::reference_node_storage::detail;
@@ -58,6 +65,160 @@ TEST_SUITE("NodeStorage helper types") {
         CHECK_EQ(freelist.occupy_next_available(), 71);
     }
 
+    TEST_CASE("StableChunkedVector") {
+        StableChunkedVector<size_t> vec;
+        CHECK(vec.empty());
+
+        vec.emplace_back(0);
+        auto const *first = &vec[0];
+
+        for (size_t ix = 1; ix < 10000; ++ix) {
+            vec.emplace_back(ix);
+        }
+
+        CHECK_EQ(vec.size(), 10000);
+        CHECK_EQ(&vec[0], first); // never relocated
+
+        for (size_t ix = 0; ix < vec.size(); ++ix) {
+            CHECK_EQ(vec[ix], ix);
+        }
+
+        vec.resize(100);
+        CHECK_EQ(vec.size(), 100);
+        vec.shrink_to_fit();
+        CHECK_EQ(&vec[0], first);
+        CHECK_EQ(vec[99], 99);
+
+        vec.resize(200);
+        CHECK_EQ(vec[99], 99);
+        CHECK_EQ(vec[199], 0);
+
+        vec.clear();
+        CHECK(vec.empty());
+    }
+
+    TEST_CASE("StableChunkedVector concurrent reads") {
+        StableChunkedVector<size_t> vec;
+        std::atomic<size_t> published = 0;
+
+        std::jthread writer{[&]() {
+            for (size_t ix = 0; ix < 100000; ++ix) {
+                vec.emplace_back(ix);
+                published.store(ix + 1, std::memory_order_release);
+            }
+        }};
+
+        bool all_match = true;
+        for (size_t n = 0; n < 100000; n = published.load(std::memory_order_acquire)) {
+            for (size_t ix = n > 64 ? n - 64 : 0; ix < n; ++ix) {
+                all_match &= vec[ix] == ix;
+            }
+        }
+
+        CHECK(all_match);
+    }
+
+    TEST_CASE("LockFreeReadSyncReferenceNodeStorage") {
+        using namespace rdf4cpp::storage;
+
+        reference_node_storage::LockFreeReadSyncReferenceNodeStorage ns;
+        static constexpr size_t n = 100000;
+
+        std::vector<identifier::NodeBackendID> ids(n);
+        std::atomic<size_t> published = 0;
+
+        std::jthread writer{[&]() {
+            for (size_t ix = 0; ix < n; ++ix) {
+                ids[ix] = ns.find_or_make_id(view::BNodeBackendView{.identifier = std::to_string(ix)});
+                published.store(ix + 1, std::memory_order_release);
+            }
+        }};
+
+        bool all_match = true;
+        for (size_t p = 0; p < n; p = published.load(std::memory_order_acquire)) {
+            for (size_t ix = p > 64 ? p - 64 : 0; ix < p; ++ix) {
+                all_match &= ns.find_bnode_backend(ids[ix]).identifier == std::to_string(ix);
+            }
+        }
+        writer.join();
+
+        CHECK(all_match);
+
+        // nodes are never erased
+        CHECK_FALSE(ns.erase_bnode(ids[0]));
+        CHECK_EQ(ns.find_bnode_backend(ids[0]).identifier, "0");
+        CHECK_EQ(ns.sweep(std::numeric_limits<uint64_t>::max()), 0);
+        CHECK_EQ(ns.find_id(view::BNodeBackendView{.identifier = "1"}), ids[1]);
+    }
+
+    TEST_CASE("StringArena") {
+        StringArena arena;
+        CHECK_EQ(arena.chunk_count(), 0);
+
+        {
+            std::vector<ArenaConstString> strings;
+            for (size_t ix = 0; ix < 10000; ++ix) {
+                strings.emplace_back("http://example.com/" + std::to_string(ix), StringArenaAllocator<char>{arena});
+            }
+            strings.emplace_back(std::string(StringArena::max_small_size + 1, 'x'), StringArenaAllocator<char>{arena}); // not stored in a chunk
+
+            CHECK_GT(arena.chunk_count(), 1);
+            for (size_t ix = 0; ix < 10000; ++ix) {
+                CHECK_EQ(strings[ix], "http://example.com/" + std::to_string(ix));
+            }
+            CHECK_EQ(std::string_view{strings.back()}.size(), StringArena::max_small_size + 1);
+
+            // erasing a prefix of the strings gives back the chunks they were in
+            auto const chunks_before = arena.chunk_count();
+            strings.erase(strings.begin(), strings.begin() + 5000);
+            CHECK_LT(arena.chunk_count(), chunks_before);
+            CHECK_EQ(strings.front(), "http://example.com/5000");
+        }
+
+        // the current chunk stays allocated
+        CHECK_EQ(arena.chunk_count(), 1);
+
+        ArenaConstString str{"abc", StringArenaAllocator<char>{arena}};
+        CHECK_EQ(str, "abc");
+    }
+
+    TEST_CASE("StringArena in node storage") {
+        using namespace rdf4cpp::storage;
+
+        reference_node_storage::UnsyncNodeTypeStorage<reference_node_storage::IRIBackend> storage;
+
+        std::vector<reference_node_storage::IRIBackend::id_type> ids;
+        for (size_t ix = 0; ix < 10000; ++ix) {
+            ids.push_back(storage.mapping.insert_assume_not_present(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)}));
+        }
+
+        CHECK_GT(storage.arena.chunk_count(), 1);
+        CHECK_EQ(storage.mapping.lookup_value(ids[42])->identifier, "http://example.com/42");
+
+        for (auto const id : ids) {
+            storage.mapping.erase_assume_present(id);
+        }
+        CHECK_EQ(storage.arena.chunk_count(), 1);
+
+        storage.clear();
+        CHECK_EQ(storage.arena.chunk_count(), 0);
+
+        // clear releases the arena as a whole instead of destroying the backends, including strings that are not stored in chunks
+        for (size_t ix = 0; ix < 1000; ++ix) {
+            (void) storage.mapping.insert_assume_not_present(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)});
+        }
+        auto const large_id = storage.mapping.insert_assume_not_present(view::IRIBackendView{.identifier = std::string(StringArena::max_small_size + 1, 'x')});
+        CHECK_EQ(storage.mapping.lookup_value(large_id)->identifier.size(), StringArena::max_small_size + 1);
+
+        storage.clear();
+        CHECK_EQ(storage.mapping.entry_count(), 0);
+        CHECK_EQ(storage.arena.chunk_count(), 0);
+        CHECK_EQ(storage.arena.live_bytes(), 0);
+
+        auto const id = storage.mapping.insert_assume_not_present(view::IRIBackendView{.identifier = "http://example.com/a"});
+        CHECK_EQ(storage.mapping.lookup_value(id)->identifier, "http://example.com/a");
+    }
+
     TEST_CASE("integration test") {
         using namespace rdf4cpp;
         using namespace rdf4cpp::storage;
@@ -95,4 +256,54 @@ TEST_SUITE("NodeStorage helper types") {
         auto l6 = Literal::make_typed_from_value<datatypes::xsd::Long>(std::numeric_limits<datatypes::xsd::Long::cpp_type>::max(), ns); // different storage
         CHECK_EQ(l6.backend_handle().node_id().literal_id().to_underlying(), 1);
     }
+
+    TEST_CASE_TEMPLATE("batch find_or_make_ids", NS, rdf4cpp::storage::reference_node_storage::SyncReferenceNodeStorage,
+                       rdf4cpp::storage::reference_node_storage::UnsyncReferenceNodeStorage,
+                       rdf4cpp::storage::reference_node_storage::ShardedReferenceNodeStorage) {
+        using namespace rdf4cpp;
+        using namespace rdf4cpp::storage;
+
+        NS backend;
+        DynNodeStoragePtr ns{backend};
+
+        std::vector<std::string> strings;
+        for (size_t ix = 0; ix < 1000; ++ix) {
+            strings.push_back("http://example.com/" + std::to_string(ix % 700)); // contains duplicates
+        }
+        strings.emplace_back(datatypes::xsd::String::identifier); // reserved
+
+        auto const prev = IRI{"http://example.com/5", ns}; // some are already present
+
+        std::vector<view::IRIBackendView> views;
+        for (auto const &str : strings) {
+            views.push_back(view::IRIBackendView{.identifier = str});
+        }
+
+        std::vector<identifier::NodeBackendID> ids(views.size());
+        ns.find_or_make_ids(std::span<view::IRIBackendView const>{views}, std::span{ids});
+
+        for (size_t ix = 0; ix < views.size(); ++ix) {
+            CHECK_EQ(ids[ix], ns.find_id(views[ix]));
+            CHECK_EQ(ns.find_iri_backend(ids[ix]).identifier, strings[ix]);
+        }
+
+        CHECK_EQ(ids[5], prev.backend_handle().id());
+        CHECK_EQ(ids[705], ids[5]);
+        CHECK_EQ(ids.back(), identifier::NodeBackendID::xsd_string_iri.first);
+
+        std::vector<view::BNodeBackendView> bnode_views{view::BNodeBackendView{.identifier = "b1"}, view::BNodeBackendView{.identifier = "b2"}, view::BNodeBackendView{.identifier = "b1"}};
+        std::vector<identifier::NodeBackendID> bnode_ids(bnode_views.size());
+        ns.find_or_make_ids(std::span<view::BNodeBackendView const>{bnode_views}, std::span{bnode_ids});
+        CHECK_EQ(bnode_ids[0], bnode_ids[2]);
+        CHECK_NE(bnode_ids[0], bnode_ids[1]);
+        CHECK_EQ(ns.find_bnode_backend(bnode_ids[1]).identifier, "b2");
+
+        std::vector<view::LiteralBackendView> literal_views{view::LexicalFormLiteralBackendView{.datatype_id = identifier::NodeBackendID::xsd_string_iri.first,
+                                                                                               .lexical_form = "abc",
+                                                                                               .language_tag = "",
+                                                                                               .needs_escape = false}};
+        std::vector<identifier::NodeBackendID> literal_ids(literal_views.size());
+        ns.find_or_make_ids(std::span<view::LiteralBackendView const>{literal_views}, std::span{literal_ids});
+        CHECK_EQ(literal_ids[0], ns.find_id(literal_views[0]));
+    }
 }
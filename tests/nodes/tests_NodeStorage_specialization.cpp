@@ -131,6 +131,15 @@ TEST_CASE_TEMPLATE("NodeStorage specialization big negative numbers", T,
     check_specialized_storage_usage<T>(unsyncns, test_values);
 }
 
+TEST_CASE("NodeStorage specialization uninlineable xsd:time") {
+    std::array<xsd::Time::cpp_type, 2> const test_values{
+            std::make_pair(std::chrono::hours{12} + std::chrono::minutes{34} + std::chrono::seconds{56} + std::chrono::milliseconds{789}, OptionalTimezone{}),
+            std::make_pair(std::chrono::minutes{50} + std::chrono::milliseconds{100}, OptionalTimezone{Timezone{std::chrono::hours{1}}})};
+
+    check_specialized_storage_usage<xsd::Time>(syncns, test_values);
+    check_specialized_storage_usage<xsd::Time>(unsyncns, test_values);
+}
+
 TEST_CASE("NodeStorage specialization xsd:hexBinary") {
     std::array<xsd::HexBinary::cpp_type, 2> const test_values{
             xsd::HexBinary::cpp_type{{std::byte{0x12}, std::byte{0x34}, std::byte{0x56}}},
@@ -0,0 +1,161 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/persistent_node_storage/PersistentNodeStorage.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using persistent_node_storage::PersistentNodeStorage;
+
+static std::filesystem::path fresh_directory(std::string_view const name) {
+    auto const dir = std::filesystem::temp_directory_path() / "rdf4cpp_tests_PersistentNodeStorage" / name;
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+TEST_CASE("PersistentNodeStorage reopen keeps ids") {
+    auto const dir = fresh_directory("reopen");
+
+    auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+
+    identifier::NodeBackendID iri_id, bnode_id, var_id, lang_id, typed_id, value_id;
+
+    {
+        PersistentNodeStorage ns{dir};
+
+        iri_id = IRI{"http://example.com/a", ns}.backend_handle().id();
+        bnode_id = BlankNode{"b1", ns}.backend_handle().id();
+        var_id = query::Variable{"x", false, ns}.backend_handle().id();
+        lang_id = Literal::make_lang_tagged("hallo", "de", ns).backend_handle().id();
+        typed_id = Literal::make_typed("abc", IRI{"http://example.com/dt", ns}, ns).backend_handle().id();
+        value_id = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns).backend_handle().id();
+
+        CHECK(!value_id.is_inlined());
+        CHECK(ns.size() >= 6);
+        ns.sync();
+    }
+
+    PersistentNodeStorage ns{dir};
+
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://example.com/a"}) == iri_id);
+    CHECK(ns.find_id(view::BNodeBackendView{.identifier = "b1"}) == bnode_id);
+    CHECK(ns.find_id(view::VariableBackendView{.name = "x", .is_anonymous = false}) == var_id);
+
+    CHECK(IRI{"http://example.com/a", ns}.backend_handle().id() == iri_id);
+    CHECK(BlankNode{"b1", ns}.backend_handle().id() == bnode_id);
+    CHECK(query::Variable{"x", false, ns}.backend_handle().id() == var_id);
+    CHECK(Literal::make_lang_tagged("hallo", "de", ns).backend_handle().id() == lang_id);
+    CHECK(Literal::make_typed("abc", IRI{"http://example.com/dt", ns}, ns).backend_handle().id() == typed_id);
+    CHECK(Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns).backend_handle().id() == value_id);
+
+    auto const lang = Node{identifier::NodeBackendHandle{lang_id, ns}}.as_literal();
+    CHECK(lang.lexical_form() == "hallo");
+    CHECK(lang.language_tag() == "de");
+
+    auto const typed = Node{identifier::NodeBackendHandle{typed_id, ns}}.as_literal();
+    CHECK(typed.lexical_form() == "abc");
+    CHECK(typed.datatype() == IRI{"http://example.com/dt", ns});
+
+    auto const value = Node{identifier::NodeBackendHandle{value_id, ns}}.as_literal();
+    CHECK(value.value<datatypes::xsd::Integer>() == big_int);
+
+    CHECK(IRI{identifier::NodeBackendHandle{iri_id, ns}}.identifier() == "http://example.com/a");
+}
+
+TEST_CASE("PersistentNodeStorage reserved datatype iris") {
+    auto const dir = fresh_directory("reserved");
+    PersistentNodeStorage ns{dir};
+
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}) == identifier::NodeBackendID::xsd_string_iri.first);
+    CHECK(ns.find_iri_backend(identifier::NodeBackendID::rdf_langstring_iri.first).identifier == datatypes::rdf::LangString::identifier);
+    CHECK(!ns.erase_iri(identifier::NodeBackendID::xsd_string_iri.first));
+}
+
+TEST_CASE("PersistentNodeStorage specialized datatypes") {
+    CHECK(PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::Integer::fixed_id));
+    CHECK(PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::Date::fixed_id));
+    CHECK(PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::Time::fixed_id));
+    CHECK(PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::DateTime::fixed_id));
+    CHECK(PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::YearMonthDuration::fixed_id));
+    CHECK(!PersistentNodeStorage::has_specialized_storage_for(datatypes::xsd::String::fixed_id));
+
+    auto const dir = fresh_directory("specialized");
+    identifier::NodeBackendID time_id;
+
+    {
+        PersistentNodeStorage ns{dir};
+        time_id = Literal::make_typed("13:20:00.123456789+14:00", IRI{datatypes::xsd::Time::identifier, ns}, ns).backend_handle().id();
+        ns.sync();
+    }
+
+    PersistentNodeStorage ns{dir};
+    CHECK(Literal::make_typed("13:20:00.123456789+14:00", IRI{datatypes::xsd::Time::identifier, ns}, ns).backend_handle().id() == time_id);
+}
+
+TEST_CASE("PersistentNodeStorage many nodes") {
+    auto const dir = fresh_directory("many");
+    static constexpr size_t n = 20000;
+
+    std::vector<identifier::NodeBackendID> ids;
+    {
+        PersistentNodeStorage ns{dir};
+        for (size_t ix = 0; ix < n; ++ix) {
+            ids.push_back(ns.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(ix)}));
+        }
+    }
+
+    PersistentNodeStorage ns{dir};
+    for (size_t ix = 0; ix < n; ++ix) {
+        auto const iri = "http://example.com/" + std::to_string(ix);
+        CHECK(ns.find_id(view::IRIBackendView{.identifier = iri}) == ids[ix]);
+        CHECK(ns.find_iri_backend(ids[ix]).identifier == iri);
+    }
+}
+
+TEST_CASE("PersistentNodeStorage erase does not reuse ids") {
+    auto const dir = fresh_directory("erase");
+
+    identifier::NodeBackendID erased;
+    {
+        PersistentNodeStorage ns{dir};
+        erased = ns.find_or_make_id(view::BNodeBackendView{.identifier = "gone"});
+        CHECK(ns.erase_bnode(erased));
+        CHECK(!ns.erase_bnode(erased));
+    }
+
+    PersistentNodeStorage ns{dir};
+    CHECK(ns.find_id(view::BNodeBackendView{.identifier = "gone"}).null());
+
+    auto const fresh = ns.find_or_make_id(view::BNodeBackendView{.identifier = "fresh"});
+    CHECK(fresh != erased);
+
+    auto const again = ns.find_or_make_id(view::BNodeBackendView{.identifier = "gone"});
+    CHECK(again != erased);
+    CHECK(ns.find_bnode_backend(again).identifier == "gone");
+}
+
+TEST_CASE("PersistentNodeStorage rejects incompatible files") {
+    auto const dir = fresh_directory("incompatible");
+    { PersistentNodeStorage ns{dir}; }
+
+    SUBCASE("locked") {
+        PersistentNodeStorage ns{dir};
+        CHECK_THROWS_AS(PersistentNodeStorage{dir}, std::system_error);
+    }
+
+    SUBCASE("pobr_version") {
+        {
+            std::fstream f{dir / "iri.entries", std::ios::in | std::ios::out | std::ios::binary};
+            f.seekp(8);
+            uint64_t const other_version = pobr_version + 1;
+            f.write(reinterpret_cast<char const *>(&other_version), sizeof(other_version));
+        }
+
+        CHECK_THROWS_AS(PersistentNodeStorage{dir}, std::runtime_error);
+    }
+}
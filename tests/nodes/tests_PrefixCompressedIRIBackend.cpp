@@ -0,0 +1,114 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/SyncReferenceNodeStorage.hpp>
+#include <rdf4cpp/storage/reference_node_storage/UnsyncReferenceNodeStorage.hpp>
+
+#include <optional>
+#include <string>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using namespace rdf4cpp::storage::reference_node_storage;
+
+TEST_CASE("split_iri") {
+    CHECK(detail::split_iri("http://dbpedia.org/resource/Leipzig") == std::pair<std::string_view, std::string_view>{"http://dbpedia.org/resource/", "Leipzig"});
+    CHECK(detail::split_iri("http://www.w3.org/2001/XMLSchema#string") == std::pair<std::string_view, std::string_view>{"http://www.w3.org/2001/XMLSchema#", "string"});
+    CHECK(detail::split_iri("http://example.com/") == std::pair<std::string_view, std::string_view>{"http://", "example.com/"}); // the whole IRI is never a prefix
+    CHECK(detail::split_iri("http://example.com/#") == std::pair<std::string_view, std::string_view>{"http://example.com/", "#"});
+    CHECK(detail::split_iri("urn:isbn:0451450523") == std::pair<std::string_view, std::string_view>{"", "urn:isbn:0451450523"});
+    CHECK(detail::split_iri("/") == std::pair<std::string_view, std::string_view>{"", "/"});
+    CHECK(detail::split_iri("") == std::pair<std::string_view, std::string_view>{"", ""});
+}
+
+TEST_CASE("PrefixCompressedIRIBackend") {
+    detail::StringArena arena;
+    PrefixCompressedIRIBackend::allocator_type const alloc{arena};
+
+    PrefixCompressedIRIBackend const a{view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Leipzig"}, alloc};
+    PrefixCompressedIRIBackend const b{view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Dresden"}, alloc};
+    PrefixCompressedIRIBackend const c{view::IRIBackendView{.identifier = "urn:isbn:0451450523"}, alloc};
+
+    CHECK(a.prefix == b.prefix); // prefix is shared
+    CHECK(*a.prefix == "http://dbpedia.org/resource/");
+    CHECK(a.local_name == "Leipzig");
+    CHECK(c.prefix == nullptr);
+    CHECK(arena.interned_count() == 1);
+
+    CHECK(static_cast<view::IRIBackendView>(a).identifier == "http://dbpedia.org/resource/Leipzig");
+    CHECK(static_cast<view::IRIBackendView>(b).identifier == "http://dbpedia.org/resource/Dresden");
+    CHECK(static_cast<view::IRIBackendView>(c).identifier == "urn:isbn:0451450523");
+
+    PrefixCompressedIRIBackend::equal const eq;
+    CHECK(eq(view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Leipzig"}, a));
+    CHECK(!eq(view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Leipzi"}, a));
+    CHECK(!eq(view::IRIBackendView{.identifier = "http://dbpedia.org/resourceLeipzig"}, a));
+    CHECK(!eq(view::IRIBackendView{.identifier = "Leipzig"}, a));
+    CHECK(eq(c, view::IRIBackendView{.identifier = "urn:isbn:0451450523"}));
+
+    // too long to be reconstructed into a fixed-size buffer, stored without prefix
+    auto const long_iri = "http://example.com/" + std::string(PrefixCompressedIRIBackend::max_compressed_size, 'x');
+    PrefixCompressedIRIBackend const d{view::IRIBackendView{.identifier = long_iri}, alloc};
+    CHECK(d.prefix == nullptr);
+    CHECK(static_cast<view::IRIBackendView>(d).identifier == long_iri);
+    CHECK(eq(view::IRIBackendView{.identifier = long_iri}, d));
+
+    // without arena there is nowhere to intern the prefix
+    PrefixCompressedIRIBackend const e{view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Leipzig"}};
+    CHECK(e.prefix == nullptr);
+    CHECK(static_cast<view::IRIBackendView>(e).identifier == "http://dbpedia.org/resource/Leipzig");
+}
+
+TEST_CASE("PrefixCompressedIRIBackend releases prefixes") {
+    detail::StringArena arena;
+    PrefixCompressedIRIBackend::allocator_type const alloc{arena};
+
+    {
+        std::optional<PrefixCompressedIRIBackend> a{std::in_place, view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Leipzig"}, alloc};
+        PrefixCompressedIRIBackend b{view::IRIBackendView{.identifier = "http://dbpedia.org/resource/Dresden"}, alloc};
+        PrefixCompressedIRIBackend const c{view::IRIBackendView{.identifier = "http://example.com/a"}, alloc};
+        CHECK(arena.interned_count() == 2);
+
+        a.reset();
+        CHECK(arena.interned_count() == 2);
+
+        PrefixCompressedIRIBackend const moved{std::move(b)};
+        CHECK(moved.prefix != nullptr);
+        CHECK(b.prefix == nullptr);
+        CHECK(static_cast<view::IRIBackendView>(moved).identifier == "http://dbpedia.org/resource/Dresden");
+        CHECK(arena.interned_count() == 2);
+    }
+
+    CHECK(arena.interned_count() == 0);
+    CHECK(arena.live_bytes() == 0);
+}
+
+TEST_CASE_TEMPLATE("prefix compressed reference storages", NS, PrefixCompressedSyncReferenceNodeStorage, PrefixCompressedUnsyncReferenceNodeStorage) {
+    NS ns;
+
+    std::vector<IRI> iris;
+    for (size_t ix = 0; ix < 1000; ++ix) {
+        iris.emplace_back("http://dbpedia.org/resource/" + std::to_string(ix), ns);
+    }
+
+    for (size_t ix = 0; ix < iris.size(); ++ix) {
+        CHECK(iris[ix].identifier() == "http://dbpedia.org/resource/" + std::to_string(ix));
+        CHECK(IRI{"http://dbpedia.org/resource/" + std::to_string(ix), ns} == iris[ix]);
+    }
+
+    CHECK(IRI{datatypes::xsd::String::identifier, ns}.backend_handle().id() == identifier::NodeBackendID::xsd_string_iri.first);
+    CHECK(ns.find_iri_backend(identifier::NodeBackendID::rdf_langstring_iri.first).identifier == datatypes::rdf::LangString::identifier);
+
+    auto const lit = Literal::make_typed("abc", IRI{"http://example.com/dt", ns}, ns);
+    CHECK(lit.datatype().identifier() == "http://example.com/dt");
+
+    CHECK(ns.erase_iri(iris[5].backend_handle().id()));
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://dbpedia.org/resource/5"}).null());
+    CHECK(!ns.find_id(view::IRIBackendView{.identifier = "http://dbpedia.org/resource/6"}).null());
+
+    // prefixes are per storage
+    NS other;
+    IRI const other_iri{"http://dbpedia.org/resource/6", other};
+    CHECK(other_iri.identifier() == "http://dbpedia.org/resource/6");
+    CHECK(ns.find_id(view::IRIBackendView{.identifier = "http://dbpedia.org/resource/6"}) == iris[6].backend_handle().id());
+}
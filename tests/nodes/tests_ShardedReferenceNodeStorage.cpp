@@ -0,0 +1,105 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+#include <rdf4cpp.hpp>
+#include <rdf4cpp/storage/reference_node_storage/ShardedReferenceNodeStorage.hpp>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace rdf4cpp;
+using namespace rdf4cpp::storage;
+using reference_node_storage::ShardedReferenceNodeStorage;
+
+TEST_CASE("ShardedReferenceNodeStorage basics") {
+    for (size_t const shard_count : {1, 3, 16}) {
+        CAPTURE(shard_count);
+        ShardedReferenceNodeStorage ns{shard_count};
+        CHECK(ns.shard_count() == shard_count);
+
+        auto const big_int = static_cast<datatypes::xsd::Integer::cpp_type>(std::numeric_limits<int64_t>::max()) * 1000;
+
+        auto const iri = IRI{"http://example.com/a", ns};
+        auto const bnode = BlankNode{"b1", ns};
+        auto const var = query::Variable{"x", false, ns};
+        auto const lang = Literal::make_lang_tagged("hallo", "de", ns);
+        auto const typed = Literal::make_typed("abc", IRI{"http://example.com/dt", ns}, ns);
+        auto const value = Literal::make_typed_from_value<datatypes::xsd::Integer>(big_int, ns);
+
+        CHECK(IRI{"http://example.com/a", ns} == iri);
+        CHECK(iri.identifier() == "http://example.com/a");
+        CHECK(bnode.identifier() == "b1");
+        CHECK(var.name() == "x");
+        CHECK(lang.lexical_form() == "hallo");
+        CHECK(lang.language_tag() == "de");
+        CHECK(typed.lexical_form() == "abc");
+        CHECK(typed.datatype() == IRI{"http://example.com/dt", ns});
+        CHECK(!value.backend_handle().is_inlined());
+        CHECK(value.value<datatypes::xsd::Integer>() == big_int);
+
+        CHECK(ns.find_id(view::IRIBackendView{.identifier = datatypes::xsd::String::identifier}) == identifier::NodeBackendID::xsd_string_iri.first);
+        CHECK(ns.find_iri_backend(identifier::NodeBackendID::rdf_langstring_iri.first).identifier == datatypes::rdf::LangString::identifier);
+        CHECK(IRI{datatypes::xsd::String::identifier, ns}.backend_handle().id() == identifier::NodeBackendID::xsd_string_iri.first);
+        CHECK(!ns.erase_iri(identifier::NodeBackendID::xsd_string_iri.first));
+
+        CHECK(ns.erase_bnode(bnode.backend_handle().id()));
+        CHECK(!ns.erase_bnode(bnode.backend_handle().id()));
+        CHECK(ns.find_id(view::BNodeBackendView{.identifier = "b1"}).null());
+    }
+}
+
+TEST_CASE("ShardedReferenceNodeStorage concurrent interning") {
+    static constexpr size_t n_threads = 8;
+    static constexpr size_t n_iris = 2000;
+
+    ShardedReferenceNodeStorage ns{4};
+
+    // all threads intern the same iris, but in a different order
+    std::vector<std::vector<identifier::NodeBackendID>> ids(n_threads, std::vector<identifier::NodeBackendID>(n_iris));
+    {
+        std::vector<std::jthread> threads;
+        for (size_t t = 0; t < n_threads; ++t) {
+            threads.emplace_back([&ns, &thread_ids = ids[t], t]() {
+                for (size_t ix = 0; ix < n_iris; ++ix) {
+                    auto const iri_ix = (ix + t * 97) % n_iris;
+                    thread_ids[iri_ix] = ns.find_or_make_id(view::IRIBackendView{.identifier = "http://example.com/" + std::to_string(iri_ix)});
+                }
+            });
+        }
+    }
+
+    std::set<identifier::NodeBackendID> unique_ids;
+    for (size_t ix = 0; ix < n_iris; ++ix) {
+        for (size_t t = 1; t < n_threads; ++t) {
+            CHECK(ids[t][ix] == ids[0][ix]);
+        }
+
+        CHECK(ns.find_iri_backend(ids[0][ix]).identifier == "http://example.com/" + std::to_string(ix));
+        unique_ids.insert(ids[0][ix]);
+    }
+
+    CHECK(unique_ids.size() == n_iris);
+}
+
+TEST_CASE("ShardedNodeTypeStorage id space exhaustion") {
+    using reference_node_storage::BNodeBackend;
+    using reference_node_storage::ShardedNodeTypeStorage;
+
+    static constexpr uint64_t max_id = (uint64_t{1} << identifier::NodeID::width) - 1;
+
+    // only the ids max_id - 1 (shard 0) and max_id (shard 1) are available
+    ShardedNodeTypeStorage<BNodeBackend> storage{4, identifier::NodeID{max_id - 1}};
+
+    auto insert = [&](size_t const shard_ix, std::string_view const name) {
+        view::BNodeBackendView const view{.identifier = name};
+        return storage.insert_assume_not_present(shard_ix, view, ShardedNodeTypeStorage<BNodeBackend>::backend_hasher{}(view));
+    };
+
+    CHECK(insert(0, "a") == identifier::NodeID{max_id - 1});
+    CHECK(insert(1, "b") == identifier::NodeID{max_id});
+
+    CHECK_THROWS_AS(insert(0, "c"), std::length_error);
+    CHECK_THROWS_AS(insert(2, "d"), std::length_error);
+    CHECK(storage.shard(0).mapping.lookup_id(view::BNodeBackendView{.identifier = "c"}) == identifier::NodeID{});
+    CHECK(storage.shard(2).mapping.entry_count() == 0);
+}